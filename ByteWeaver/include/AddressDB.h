@@ -4,6 +4,7 @@
 
 #include <ByteWeaverPCH.h>
 #include <AddressEntry.h>
+#include <AddressTable.h>
 
 namespace ByteWeaver {
 
@@ -26,6 +27,8 @@ namespace ByteWeaver {
      *
      * Entries are indexed using a composite key of (symbolName, moduleName).
      * This allows the same symbol name to exist in different modules without conflicts.
+     * Lookups take string views and never allocate; hot callers can skip hashing entirely
+     * with a PreparedAddressKey (see Prepare()) or an AddressHandle (see GetHandle()).
      *
      * ## Usage Examples
      *
@@ -104,7 +107,7 @@ namespace ByteWeaver {
          * - First element: Symbol name (std::string)
          * - Second element: Module name (std::wstring)
          */
-        using Key = std::pair<std::string, std::wstring>;
+        using Key = AddressTable::Key;
 
         /**
          * @brief RAII wrapper providing thread-safe read-only access to the database.
@@ -320,6 +323,8 @@ namespace ByteWeaver {
          * @param symbolName Descriptive name for the function
          * @param moduleName Module to search within
          * @param pattern Comma-separated hex pattern with optional wildcards
+         * @param skipCount Number of matches to skip before accepting one (default: 0)
+         * @param scope Part of the module to scan (default: whole image)
          *
          * @note Thread-safe operation
          * @note Pattern scanning can be slow - use specific patterns
@@ -329,11 +334,17 @@ namespace ByteWeaver {
          * ```cpp
          * AddressDB::AddWithScanPattern("GameLoop", L"game.exe",
          *                              "48,83,EC,28,?,?,?,?,E8");
+         *
+         * // Second match, searching executable sections only
+         * AddressDB::AddWithScanPattern("DrawHud", L"game.exe", "40,53,48,83,EC,20", 1,
+         *                              ScanScope::ExecutableSections());
          * ```
          */
         static void AddWithScanPattern(std::string symbolName,
                                       std::wstring moduleName,
-                                      std::string pattern);
+                                      std::string pattern,
+                                      size_t skipCount = 0,
+                                      ScanScope scope = {});
 
         // ----- Lookup -----
 
@@ -348,6 +359,7 @@ namespace ByteWeaver {
          * @note Thread-safe operation
          * @note Returns a non-owning pointer - do not delete
          * @note Pointer remains valid until the entry is removed from database
+         * @note Takes views: no Key is built and nothing is allocated
          *
          * ### Example:
          * ```cpp
@@ -360,7 +372,7 @@ namespace ByteWeaver {
          * }
          * ```
          */
-        static AddressEntry* Find(const std::string& symbolName, const std::wstring& moduleName);
+        static AddressEntry* Find(std::string_view symbolName, std::wstring_view moduleName);
 
         /**
          * @brief Finds an entry in the database using a composite key.
@@ -382,6 +394,66 @@ namespace ByteWeaver {
          */
         static AddressEntry* Find(const Key& key);
 
+        /**
+         * @brief Finds an entry by a key prepared with Prepare(), without hashing the strings.
+         *
+         * @return Pointer to the AddressEntry if found, nullptr otherwise
+         */
+        static AddressEntry* Find(const PreparedAddressKey& key);
+
+        /**
+         * @brief Finds an entry by handle in constant time.
+         *
+         * @return Pointer to the AddressEntry, or nullptr if the handle is invalid or the entry was removed
+         */
+        static AddressEntry* Find(AddressHandle handle);
+
+        /**
+         * @brief Returns the resolved address of an entry, read under the lock.
+         *
+         * Unlike Find(), nothing points into the database afterwards, so a concurrent Add(),
+         * Remove() or VerifyAll() cannot change the value once it is returned.
+         *
+         * @return The entry's TargetAddress, or std::nullopt if the entry is missing or unresolved
+         */
+        static std::optional<uintptr_t> TryGetAddress(std::string_view symbolName, std::wstring_view moduleName);
+
+        /**
+         * @brief Finds many entries under one shared lock, from symbol hashes computed ahead of time.
+         *
+         * The module of a query is looked up once per run of queries naming the same module, so a
+         * batch grouped by module costs one module lookup per group and one probe per symbol.
+         *
+         * @param queries Lookups to perform
+         * @param results Receives the entry (or nullptr) of each query; at least as long as queries
+         *
+         * @return Number of entries found
+         */
+        static size_t FindBatch(std::span<const AddressQuery> queries, std::span<AddressEntry*> results);
+
+        /**
+         * @brief Interns the module and hashes the key once, for repeated lookups.
+         *
+         * The prepared key stays valid for the life of the process and also finds entries
+         * that are added after it was prepared.
+         *
+         * ### Example:
+         * ```cpp
+         * static const auto pcallKey = AddressDB::Prepare("lua_pcall", L"lua51.dll");
+         * if (auto* entry = AddressDB::Find(pcallKey)) { ... }
+         * ```
+         */
+        static PreparedAddressKey Prepare(std::string symbolName, std::wstring_view moduleName);
+
+        /**
+         * @brief Returns a handle to an existing entry for constant-time lookups.
+         *
+         * @return Handle, or an invalid handle if no entry with this key exists
+         *
+         * @note Removing the entry invalidates the handle; replacing it through Add() does not
+         */
+        static AddressHandle GetHandle(std::string_view symbolName, std::wstring_view moduleName);
+
         // ----- Management -----
 
         /**
@@ -402,7 +474,7 @@ namespace ByteWeaver {
          * }
          * ```
          */
-        static bool Remove(const std::string& symbolName, const std::wstring& moduleName);
+        static bool Remove(std::string_view symbolName, std::wstring_view moduleName);
 
         /**
          * @brief Removes an entry from the database using a composite key.
@@ -433,22 +505,55 @@ namespace ByteWeaver {
         static void Clear();
 
         /**
-         * @brief Updates all entries in the database by calling Update() on each.
+         * @brief Resolves all entries in the database.
          *
-         * Iterates through all entries and calls their Update() method to resolve
-         * addresses. This is useful for batch resolution after modules are loaded.
+         * Export and offset entries are resolved through their Update() method. Pattern
+         * entries are grouped by module and scan scope, and each group is resolved in a
+         * single pass over its ranges of the module image (see AddressScanner::ModuleSearch
+         * with ScanJobs), so the cost no longer grows with one full image scan per signature.
          *
-         * @note Thread-safe operation
-         * @note May take time if many entries use pattern scanning
-         * @note Logs resolution results for each entry
+         * When SignatureCache is open, pattern entries cached for the same module build are
+         * verified in place instead of scanned, and new results are written back.
+         *
+         * @param unresolved Optional output list receiving the key of every entry that could not be resolved
+         *
+         * @return true if every entry was resolved
+         *
+         * @note Thread-safe operation (holds the write lock for the whole update)
+         * @note Logs an error for each entry that was not found
+         * @note Deferred entries of modules that are not loaded yet are skipped, not reported
          *
          * ### Example:
          * ```cpp
          * // After game initialization
-         * AddressDB::UpdateAll(); // Resolve all addresses at once
+         * std::vector<AddressDB::Key> missing;
+         * if (!AddressDB::UpdateAll(&missing)) {
+         *     for (const auto& [symbol, module] : missing) { ... }
+         * }
          * ```
          */
-        static void UpdateAll();
+        static bool UpdateAll(std::vector<Key>* unresolved = nullptr);
+
+        /**
+         * @brief Resolves only the entries of one module.
+         *
+         * Same strategy as UpdateAll(), restricted to entries whose module name refers to
+         * moduleName (case-insensitive, extension optional). Used by DeferredLoader when
+         * the module loads.
+         *
+         * @param moduleName Module to resolve entries for; must be loaded
+         * @param unresolved Optional output list receiving the key of every entry that could not be resolved
+         *
+         * @return true if every entry of the module was resolved
+         */
+        static bool UpdateModule(const std::wstring& moduleName, std::vector<Key>* unresolved = nullptr);
+
+        /**
+         * @brief Marks an entry as deferred (see AddressEntry::Deferred).
+         *
+         * @return false if no entry with this key exists
+         */
+        static bool Defer(std::string_view symbolName, std::wstring_view moduleName);
 
         // ----- Debug -----
 
@@ -474,56 +579,52 @@ namespace ByteWeaver {
         static void DumpAll();
 
         /**
-         * @brief Verifies that all entries in the database can be successfully resolved.
+         * @brief How VerifyAll() decides that an entry is still valid.
+         */
+        enum class VerifyMode : uint8_t {
+            Incremental,    ///< Check the cached resolution (AddressEntry::VerifyResolved); re-resolve only mismatches
+            Full            ///< Resolve every entry again and compare (AddressEntry::Verify)
+        };
+
+        /**
+         * @brief Verifies that all entries in the database are still correctly resolved.
          *
-         * Calls Verify() on every entry to ensure they can all be resolved.
-         * Returns false if any entry fails verification.
+         * Entries are checked under the shared lock, so lookups continue during the check.
+         * Entries that fail are resolved again on a copy without holding any lock (this is
+         * where scans happen), and the new addresses are published under a short exclusive
+         * lock. Entries removed or replaced meanwhile are left alone.
          *
-         * @return true if all entries can be resolved, false if any fail
+         * In Incremental mode (the default) a health check costs a registry lookup and a
+         * masked compare per pattern entry instead of a module scan.
+         *
+         * @param mode How entries are checked (default: Incremental)
+         *
+         * @return true if all entries were valid, false if any had to be updated or failed
          *
          * @note Thread-safe operation
-         * @note Does not update cached values in entries
-         * @note Performs actual resolution operations (can be expensive)
          * @note Logs errors for any entries that fail verification
          *
          * ### Example:
          * ```cpp
          * if (AddressDB::VerifyAll()) {
          *     std::cout << "All entries are valid" << std::endl;
-         *     AddressDB::UpdateAll(); // Safe to update all
          * } else {
-         *     std::cerr << "Some entries cannot be resolved" << std::endl;
+         *     std::cerr << "Some entries moved or cannot be resolved" << std::endl;
          *     AddressDB::DumpAll(); // Debug the issues
          * }
          * ```
          */
-        static bool VerifyAll();
+        static bool VerifyAll(VerifyMode mode = VerifyMode::Incremental);
 
     private:
-        /**
-         * @brief Custom hash function for the composite Key type.
-         *
-         * Combines hashes of both string components using a well-known algorithm
-         * that provides good distribution and minimal collision probability.
-         *
-         * @note Uses FNV-1a inspired mixing for good hash distribution
-         */
-        struct KeyHash {
-            size_t operator()(const Key& k) const noexcept {
-                // simple combine of two hashes
-                static constexpr auto KGolden = static_cast<size_t>(0x9e3779b97f4a7c15ULL);
-                const size_t h1 = std::hash<std::string>{}(k.first);
-                const size_t h2 = std::hash<std::wstring>{}(k.second);
-                return h1 ^ h2 + KGolden + (h1 << 6) + (h1 >> 2);
-            }
-        };
+        static bool UpdateEntries(const std::wstring* moduleFilter, std::vector<Key>* unresolved);
 
         /**
-         * @brief The internal hash map storing all AddressEntry objects.
+         * @brief The internal table storing all AddressEntry objects.
          *
          * Static member containing the actual database storage.
          */
-        static std::unordered_map<Key, AddressEntry, KeyHash> _Database;
+        static AddressTable _Database;
 
         /**
          * @brief Shared mutex providing thread safety for database operations.
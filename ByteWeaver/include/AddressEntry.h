@@ -3,6 +3,8 @@
 #pragma once
 
 #include <ByteWeaverPCH.h>
+#include <CompiledPattern.h>
+#include <ScanScope.h>
 
 namespace ByteWeaver {
 
@@ -95,6 +97,31 @@ namespace ByteWeaver {
          */
         std::optional<std::string> ScanPattern;
 
+        /**
+         * @brief Number of pattern matches to skip before accepting one.
+         *
+         * Lets a non-unique pattern select its Nth occurrence in the module.
+         * Only used by the pattern scanning strategy.
+         */
+        size_t SkipCount = 0;
+
+        /**
+         * @brief Part of the module searched by the pattern scanning strategy.
+         *
+         * Defaults to the whole image. Code signatures should use
+         * ScanScope::ExecutableSections() or ScanScope::NamedSection(".text").
+         */
+        ScanScope Scope{};
+
+        /**
+         * @brief Resolve this entry when its module loads instead of up front.
+         *
+         * AddressDB::UpdateAll skips deferred entries whose module is not loaded yet
+         * (without reporting them as failures); DeferredLoader resolves them as soon as
+         * the loader maps the module.
+         */
+        bool Deferred = false;
+
         /**
          * @brief Cached base address of the resolved module.
          *
@@ -188,10 +215,12 @@ namespace ByteWeaver {
          * @param symbolName Descriptive name for the function
          * @param moduleName Module to search within
          * @param pattern Comma-separated hex pattern with optional wildcards
+         * @param skipCount Number of matches to skip before accepting one (default: 0)
+         * @param scope Part of the module to scan (default: whole image)
          *
          * @return AddressEntry configured for pattern-based resolution
          *
-         * @note Sets IsSymbolExport = false and pre-parses the pattern
+         * @note Sets IsSymbolExport = false and compiles the pattern once
          * @note Pattern scanning can be slow - use specific patterns when possible
          *
          * ### Example:
@@ -203,7 +232,8 @@ namespace ByteWeaver {
          * }
          * ```
          */
-        static AddressEntry WithScanPattern(std::string symbolName, std::wstring moduleName, const std::string& pattern);
+        static AddressEntry WithScanPattern(std::string symbolName, std::wstring moduleName, const std::string& pattern,
+                                            size_t skipCount = 0, ScanScope scope = {});
 
         // --- Setters ---
 
@@ -244,8 +274,27 @@ namespace ByteWeaver {
          */
         void SetScanPattern(const std::string& pattern);
 
+        /**
+         * @brief Sets the pattern scanning strategy from an already compiled pattern.
+         *
+         * @param pattern Compiled pattern to scan for
+         *
+         * @note ScanPattern is left unchanged (it only holds the source string, if any)
+         * @note Changes the resolution strategy to pattern-based
+         */
+        void SetScanPattern(CompiledPattern pattern);
+
         // --- Accessors ---
 
+        /**
+         * @brief Returns the compiled scan pattern, or nullptr if none is set.
+         *
+         * Used by AddressDB to batch the pattern entries of one module into a single scan.
+         */
+        [[nodiscard]] const CompiledPattern* GetCompiledPattern() const noexcept {
+            return _CompiledPattern.has_value() ? &_CompiledPattern.value() : nullptr;
+        }
+
         /**
          * @brief Updates and resolves the target address using the configured strategy.
          *
@@ -371,14 +420,28 @@ namespace ByteWeaver {
          */
         bool Verify() const;
 
+        /**
+         * @brief Checks the cached resolution without resolving again.
+         *
+         * The module must still be loaded at ModuleAddress and contain TargetAddress. Then,
+         * by strategy: pattern entries must still match at TargetAddress (masked compare),
+         * export entries must still resolve to it in the module's ExportIndex, and offset
+         * entries must equal ModuleAddress + KnownOffset.
+         *
+         * @return true if the cached address is still valid; false means re-resolve
+         *
+         * @note Never scans and never logs; a pattern entry's SkipCount is not re-checked
+         */
+        bool VerifyResolved() const;
+
     private:
         /**
-         * @brief Cached parsed scan bytes for pattern matching.
+         * @brief Cached compiled pattern for signature scanning.
          *
-         * Internal storage for the parsed pattern bytes to avoid
-         * re-parsing the pattern string on every scan operation.
+         * Internal storage for the parsed and analysed pattern (value/mask arrays,
+         * anchor bytes and skip table) so the pattern string is only processed once.
          * Populated automatically when SetScanPattern() is called.
          */
-        std::optional<std::vector<std::optional<uint8_t>>> _ScanBytes;
+        std::optional<CompiledPattern> _CompiledPattern;
     };
 }
\ No newline at end of file
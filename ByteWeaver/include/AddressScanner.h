@@ -3,6 +3,9 @@
 #pragma once
 
 #include <ByteWeaverPCH.h>
+#include <CompiledPattern.h>
+#include <ScanEngine.h>
+#include <ScanScope.h>
 
 namespace ByteWeaver {
 
@@ -53,6 +56,14 @@ namespace ByteWeaver {
      * }
      * ```
      *
+     * ### Parallel Scanning:
+     * ```cpp
+     * // Split large scans into chunks processed on a worker pool (see ParallelScan)
+     * ParallelScanOptions options;
+     * options.Enabled = true;
+     * ParallelScan::SetOptions(options);
+     * ```
+     *
      * @note All methods are static and thread-safe for read operations
      * @warning Pattern scanning can be slow on large modules - use specific patterns when possible
      */
@@ -84,8 +95,10 @@ namespace ByteWeaver {
         /**
          * @brief Searches for a byte pattern within a memory region.
          *
-         * Performs a linear search through the specified memory region looking for
-         * the given pattern, supporting wildcards for flexible matching.
+         * Searches the specified memory region for the given pattern, supporting wildcards
+         * for flexible matching. The scan is performed by ScanEngine, which uses an SSE2 or
+         * AVX2 anchor-byte filter when the CPU supports it and falls back to a scalar loop
+         * otherwise. All backends return identical results.
          *
          * @param base Pointer to the start of the memory region to search
          * @param size Size of the memory region in bytes
@@ -108,6 +121,100 @@ namespace ByteWeaver {
                                                      const std::vector<std::optional<uint8_t>>& pattern,
                                                      size_t skipCount = 0);
 
+        /**
+         * @brief Searches for a compiled pattern within a memory region.
+         *
+         * Preferred overload for repeated scans: the pattern is parsed and analysed once
+         * (anchor bytes, skip table) instead of on every call.
+         *
+         * @param base Pointer to the start of the memory region to search
+         * @param size Size of the memory region in bytes
+         * @param pattern Compiled pattern (see CompiledPattern::Parse)
+         * @param skipCount Number of matches to skip before returning (default: 0)
+         *
+         * @return Optional containing the address of the found pattern, or std::nullopt if not found
+         *
+         * @note Access violations during the scan are caught and reported as not found
+         * @note Large regions are split across workers when ParallelScan is enabled
+         *
+         * ### Example:
+         * ```cpp
+         * static const auto pattern = CompiledPattern::Parse("48,8B,C4,?");
+         * auto address = FindSignature(moduleBase, moduleSize, pattern);
+         * ```
+         */
+        static std::optional<uintptr_t> FindSignature(uint8_t* base, size_t size,
+                                                     const CompiledPattern& pattern,
+                                                     size_t skipCount = 0);
+
+        /**
+         * @brief Searches for a compiled pattern across several ranges of one image.
+         *
+         * Ranges are scanned in the order given (normally address order, see ScanScope::Resolve)
+         * and skipCount applies across all of them. Each range is guarded separately, so a fault
+         * in one range does not abort the others.
+         *
+         * @param moduleBase Base address the range offsets are relative to
+         * @param ranges Ranges to scan
+         * @param pattern Compiled pattern (see CompiledPattern::Parse)
+         * @param skipCount Number of matches to skip before returning (default: 0)
+         *
+         * @return Optional containing the address of the found pattern, or std::nullopt if not found
+         *
+         * @note Matches spanning two non-adjacent ranges are not reported
+         */
+        static std::optional<uintptr_t> FindSignature(uint8_t* moduleBase, std::span<const ScanRange> ranges,
+                                                     const CompiledPattern& pattern,
+                                                     size_t skipCount = 0);
+
+        /**
+         * @brief Resolves a batch of patterns in a single pass over a memory region.
+         *
+         * May be called repeatedly with the same index over consecutive regions; jobs that
+         * were already resolved are skipped and skip counts carry over.
+         *
+         * @param base Pointer to the start of the memory region to search
+         * @param size Size of the memory region in bytes
+         * @param index Index built over the jobs to resolve (see MultiPatternIndex)
+         *
+         * @return Number of jobs resolved by this call
+         *
+         * @note Access violations stop the scan; jobs resolved before the fault keep their address
+         *
+         * ### Example:
+         * ```cpp
+         * std::vector<ScanJob> jobs{ { &patternA }, { &patternB, 1 } };
+         * MultiPatternIndex index(jobs);
+         * FindSignatures(moduleBase, moduleSize, index);
+         * ```
+         */
+        static size_t FindSignatures(uint8_t* base, size_t size, MultiPatternIndex& index);
+
+        /**
+         * @brief Resolves a batch of patterns within a specific loaded module in a single pass.
+         *
+         * Each job's Address is set to the absolute address of its match, or left empty if
+         * the pattern was not found. Used by AddressDB::UpdateAll to resolve every pattern
+         * entry of a module at once. Large ranges are split across workers when ParallelScan
+         * is enabled.
+         *
+         * @param moduleName Wide string name of the target module (e.g., L"game.exe")
+         * @param jobs Patterns to resolve, each with its own skip count
+         * @param scope Part of the image to scan (default: whole image)
+         *
+         * @return Base address of the module, or std::nullopt if it is not loaded
+         *
+         * ### Example:
+         * ```cpp
+         * std::vector<ScanJob> jobs{ { &updatePattern }, { &renderPattern } };
+         * if (auto base = ModuleSearch(L"game.exe", jobs); base && jobs[0].Address) {
+         *     // jobs[0].Address.value() - base.value() is the offset
+         * }
+         * ```
+         */
+        static std::optional<uintptr_t> ModuleSearch(const std::wstring& moduleName, std::span<ScanJob> jobs,
+                                                     const ScanScope& scope = {});
+
         /**
          * @brief Searches for a byte pattern within a specific loaded module.
          *
@@ -151,7 +258,7 @@ namespace ByteWeaver {
          *         - Offset from module base to found address
          *         Returns std::nullopt if module not found or pattern not located
          *
-         * @note More efficient than string version if pattern is reused multiple times
+         * @note Compiles the pattern on every call - prefer the CompiledPattern overload for reuse
          * @note Automatically handles PE header parsing to determine module size
          *
          * ### Example:
@@ -169,12 +276,40 @@ namespace ByteWeaver {
                                         const std::vector<std::optional<uint8_t>>& pattern,
                                         size_t skipCount = 0);
 
+        /**
+         * @brief Searches for a compiled pattern within a specific loaded module.
+         *
+         * All other ModuleSearch overloads forward here after compiling their pattern.
+         * The scan covers the ranges selected by scope, walked from the section table;
+         * code signatures are best scanned with ScanScope::ExecutableSections().
+         *
+         * @param moduleName Wide string name of the target module (e.g., L"user32.dll")
+         * @param symbolName Descriptive name for logging and identification
+         * @param pattern Compiled pattern to search for
+         * @param skipCount Number of pattern matches to skip before returning (default: 0)
+         * @param scope Part of the image to scan (default: whole image)
+         *
+         * @return SearchResults containing module base, found address, and offset, or std::nullopt
+         *
+         * ### Example:
+         * ```cpp
+         * static const auto pattern = CompiledPattern::Parse("FF,25,?,?,?,?");
+         * auto result = ModuleSearch(L"user32.dll", "MessageBoxW_Jump", pattern, 0,
+         *                            ScanScope::NamedSection(".text"));
+         * ```
+         */
+        static SearchResults ModuleSearch(const std::wstring& moduleName,
+                                        const std::string& symbolName,
+                                        const CompiledPattern& pattern,
+                                        size_t skipCount = 0,
+                                        const ScanScope& scope = {});
+
         /**
          * @brief Looks up an exported function address from a module's export table.
          *
-         * Uses the Windows API to resolve the address of an exported function from
-         * the specified module's export table. This is the most reliable method for
-         * finding well-known API functions.
+         * Resolves the address of an exported function through the module's shared
+         * ExportIndex (built once per module, forwarders followed). This is the most
+         * reliable method for finding well-known API functions.
          *
          * @param moduleName Wide string name of the module containing the export
          * @param symbolName Name of the exported function/symbol to find
@@ -0,0 +1,203 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include <ByteWeaverPCH.h>
+#include <AddressEntry.h>
+
+namespace ByteWeaver {
+
+    /**
+     * @brief Stable reference to an AddressDB entry that skips hashing and probing.
+     *
+     * Obtained once with AddressDB::GetHandle() and resolved by slot index. Removing the entry
+     * (or clearing the database) bumps the slot's generation, so a stale handle resolves to
+     * nullptr. Replacing an entry through Add() keeps its slot and its handles.
+     */
+    struct AddressHandle {
+        /// @brief Slot of the entry in the table
+        uint32_t Index = UINT32_MAX;
+
+        /// @brief Generation of the slot when the handle was taken
+        uint32_t Generation = 0;
+
+        /// @brief Returns true if the handle was obtained for an existing entry
+        bool IsValid() const noexcept { return Index != UINT32_MAX; }
+    };
+
+    /**
+     * @brief Lookup key with the module already interned and the hash already computed.
+     *
+     * Built by AddressDB::Prepare(); unlike a handle it also finds entries added after it was
+     * built, so it suits hot lookups of symbols that may not be registered yet.
+     */
+    struct PreparedAddressKey {
+        std::string Symbol;
+        uint32_t ModuleId = UINT32_MAX;
+        uint64_t Hash = 0;
+    };
+
+    /**
+     * @brief One lookup of an AddressDB::FindBatch() call.
+     *
+     * SymbolHash is AddressTable::SymbolHash(Symbol), which is constexpr, so tables of queries
+     * can be hashed at compile time (see HookDescriptor).
+     */
+    struct AddressQuery {
+        std::string_view Symbol;
+        std::wstring_view Module;
+        uint64_t SymbolHash = 0;
+    };
+
+    /**
+     * @brief Flat open-addressing table behind AddressDB.
+     *
+     * Entries live in slots of a deque, so their addresses never change while they are in the
+     * table; removed slots are recycled. The index is a power-of-two array of slot numbers probed
+     * linearly, compared by full hash first. Module names are interned to ids once, so a lookup
+     * hashes the symbol and compares the module as an integer, and callers can look up with
+     * string views without building a Key.
+     *
+     * Not synchronized; AddressDB holds its lock around every call.
+     */
+    class AddressTable {
+    public:
+        using Key = std::pair<std::string, std::wstring>;
+        using Record = std::pair<const Key, AddressEntry>;
+
+        static constexpr uint32_t NotFound = UINT32_MAX;
+
+    private:
+        struct Slot {
+            std::optional<Record> Value;
+            uint64_t Hash = 0;
+            uint32_t ModuleId = 0;
+            uint32_t Generation = 0;
+        };
+
+    public:
+        /**
+         * @brief Forward iterator over occupied slots; dereferences to the (key, entry) pair.
+         */
+        template <bool Const>
+        class Iterator {
+            using Slots = std::conditional_t<Const, const std::deque<Slot>, std::deque<Slot>>;
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Record;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<Const, const Record&, Record&>;
+            using pointer = std::conditional_t<Const, const Record*, Record*>;
+
+            Iterator() = default;
+            Iterator(Slots* slots, const size_t index) : _Slots(slots), _Index(index) { SkipEmpty(); }
+
+            reference operator*() const { return *(*_Slots)[_Index].Value; }
+            pointer operator->() const { return &*(*_Slots)[_Index].Value; }
+
+            Iterator& operator++() {
+                ++_Index;
+                SkipEmpty();
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                Iterator previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            bool operator==(const Iterator& other) const noexcept { return _Index == other._Index; }
+
+        private:
+            void SkipEmpty() {
+                while (_Slots && _Index < _Slots->size() && !(*_Slots)[_Index].Value)
+                    ++_Index;
+            }
+
+            Slots* _Slots = nullptr;
+            size_t _Index = 0;
+        };
+
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        iterator begin() { return { &_Slots, 0 }; }
+        iterator end() { return { &_Slots, _Slots.size() }; }
+        const_iterator begin() const { return { &_Slots, 0 }; }
+        const_iterator end() const { return { &_Slots, _Slots.size() }; }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+        size_t size() const noexcept { return _Count; }
+
+        /// @brief Returns the id of an interned module name, or NotFound
+        uint32_t FindModule(std::wstring_view moduleName) const;
+
+        /// @brief Returns the id of a module name, interning it on first use (ids are never reused)
+        uint32_t InternModule(std::wstring_view moduleName);
+
+        /// @brief FNV-1a of a symbol name, the module-independent half of Hash()
+        static constexpr uint64_t SymbolHash(const std::string_view symbolName) noexcept {
+            uint64_t hash = 0xcbf29ce484222325ULL;
+            for (const char c : symbolName) {
+                hash ^= static_cast<uint8_t>(c);
+                hash *= 0x100000001b3ULL;
+            }
+            return hash;
+        }
+
+        /// @brief Hash of a symbol within an interned module (what PreparedAddressKey::Hash holds)
+        static uint64_t Hash(std::string_view symbolName, uint32_t moduleId) noexcept;
+
+        /// @brief Same as Hash(), from a SymbolHash() computed ahead of time
+        static uint64_t Hash(uint64_t symbolHash, uint32_t moduleId) noexcept;
+
+        /// @brief Returns the slot of the entry, or NotFound
+        uint32_t Find(std::string_view symbolName, uint32_t moduleId, uint64_t hash) const;
+        uint32_t Find(std::string_view symbolName, std::wstring_view moduleName) const;
+
+        /// @brief Inserts or replaces the entry under key; returns its slot
+        uint32_t InsertOrAssign(Key key, AddressEntry entry);
+
+        /// @brief Removes the entry in slot; its address and handles become invalid
+        void Erase(uint32_t slot);
+
+        /// @brief Removes every entry (interned module ids are kept)
+        void Clear();
+
+        /// @brief Entry stored in slot, or nullptr if the slot is free
+        Record* At(const uint32_t slot) {
+            return slot < _Slots.size() && _Slots[slot].Value ? &*_Slots[slot].Value : nullptr;
+        }
+
+        /// @brief Handle of slot (which must be occupied)
+        AddressHandle HandleOf(const uint32_t slot) const { return { slot, _Slots[slot].Generation }; }
+
+        /// @brief Entry a handle refers to, or nullptr if it is stale
+        Record* Resolve(const AddressHandle handle) {
+            return handle.Index < _Slots.size() && _Slots[handle.Index].Generation == handle.Generation
+                ? At(handle.Index) : nullptr;
+        }
+
+    private:
+        static constexpr uint32_t EmptyBucket = 0;
+        static constexpr uint32_t Tombstone = UINT32_MAX;
+
+        struct WideHash {
+            using is_transparent = void;
+            size_t operator()(const std::wstring_view text) const noexcept { return std::hash<std::wstring_view>{}(text); }
+        };
+
+        size_t BucketOf(uint64_t hash) const noexcept { return static_cast<size_t>(hash) & (_Buckets.size() - 1); }
+        void Rehash(size_t bucketCount);
+
+        std::deque<Slot> _Slots;
+        std::vector<uint32_t> _FreeSlots;
+        std::vector<uint32_t> _Buckets;     // slot + 1, EmptyBucket or Tombstone
+        size_t _Count = 0;
+        size_t _Tombstones = 0;
+
+        std::unordered_map<std::wstring, uint32_t, WideHash, std::equal_to<>> _ModuleIds;
+    };
+}
@@ -0,0 +1,67 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include <ByteWeaverPCH.h>
+
+namespace ByteWeaver {
+
+    /**
+     * @brief Deferred-formatting log backend for the ByteWeaver Debug/Info/Warn/Error calls.
+     *
+     * While open, a log call checks the level, copies its raw arguments into a fixed stack
+     * buffer and appends a binary record (format id, timestamp, thread, arguments) to a
+     * buffered stream; no printf work happens in the process. Each format string is written
+     * once per stream as a definition record. ConsoleLogger renders the file later:
+     * `ConsoleLogger --decode trace.bwlog`. The layout is in BinaryLogFormat.hpp.
+     *
+     * Messages whose arguments do not fit a record fall back to the text path.
+     *
+     * ### Example:
+     * ```cpp
+     * SetLogLevel(LogLevel::LOG_DEBUG);
+     * BinaryLog::Open("C:\\traces\\hooks.bwlog");
+     * // ... Debug() tracing in Detour::Apply and the scanner is now cheap to leave on ...
+     * BinaryLog::Close();
+     * ```
+     */
+    class BinaryLog {
+    public:
+        /**
+         * @brief Receives encoded bytes (file header first) instead of a file.
+         */
+        using Sink = std::function<void(const uint8_t* data, size_t size)>;
+
+        /**
+         * @brief Starts writing records to a file (truncated). Replaces an open stream.
+         *
+         * @return false if the file cannot be created
+         */
+        static bool Open(const fs::path& path);
+
+        /**
+         * @brief Starts writing records to a sink, e.g. a pipe. Replaces an open stream.
+         */
+        static void Open(Sink sink);
+
+        /**
+         * @brief Flushes and closes the stream; logging returns to text.
+         */
+        static void Close();
+
+        /**
+         * @brief Writes buffered records to the file or sink.
+         */
+        static void Flush();
+
+        /**
+         * @brief Returns true while records are being written.
+         */
+        static bool IsOpen();
+
+        /**
+         * @brief Number of records written since Open().
+         */
+        static uint64_t RecordCount();
+    };
+}
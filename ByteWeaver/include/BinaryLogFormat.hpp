@@ -0,0 +1,314 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+// Shared by the library (encoder) and ConsoleLogger (decoder), so it only depends on the STD lib.
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cwchar>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * Binary log stream written by ByteWeaver::BinaryLog.
+ *
+ * A file starts with a FileHeader and is followed by records. Every record starts with a
+ * RecordHeader; Size covers the header and the payload.
+ *  - RecordKind::Format  defines FormatId once per stream; the payload is the printf format string.
+ *  - RecordKind::Message payload is the raw arguments, each as an ArgType tag followed by its value
+ *    (8 bytes for numbers and pointers, uint16_t length + code units for strings).
+ *
+ * The text is only rendered when the stream is read (ConsoleLogger --decode <file>).
+ */
+namespace ByteWeaver::BinaryLogFormat {
+
+    inline constexpr char Magic[8] = { 'B', 'W', 'L', 'O', 'G', '\0', '\r', '\n' };
+    inline constexpr uint32_t Version = 2;
+
+    #pragma pack(push, 1)
+    struct FileHeader {
+        char Magic[8];
+        uint32_t Version;
+        uint32_t ProcessId;
+        uint64_t TimestampFrequency;  ///< QueryPerformanceFrequency at open
+        uint64_t TimestampBase;       ///< QueryPerformanceCounter at open
+    };
+
+    enum class RecordKind : uint8_t {
+        Format = 1,
+        Message = 2
+    };
+
+    struct RecordHeader {
+        uint16_t Size;
+        RecordKind Kind;
+        uint8_t Level;
+        uint32_t FormatId;
+        uint64_t Timestamp;
+        uint32_t ThreadId;
+    };
+    #pragma pack(pop)
+
+    enum class ArgType : uint8_t {
+        Int = 1,
+        UInt = 2,
+        Double = 3,
+        Pointer = 4,
+        String = 5,
+        WideString = 6,
+        Int32 = 7,      ///< Integers of 4 bytes or less: printf reads them as 32-bit values
+        UInt32 = 8
+    };
+
+    /// @brief Largest payload of one record; longer messages fall back to text logging
+    inline constexpr size_t MaxPayload = 1024;
+
+    // ---- encoding ----
+
+    /**
+     * @brief Fixed-size argument buffer filled on the logging thread (no allocation).
+     */
+    struct ArgBuffer {
+        uint8_t Data[MaxPayload];
+        size_t Size = 0;
+
+        bool PutRaw(const ArgType type, const void* value, const size_t size) {
+            if (Size + 1 + size > MaxPayload)
+                return false;
+            Data[Size++] = static_cast<uint8_t>(type);
+            memcpy(Data + Size, value, size);
+            Size += size;
+            return true;
+        }
+
+        template <typename Char>
+        bool PutString(const ArgType type, const Char* text) {
+            if (!text)
+                return PutString(type, "(null)");
+            size_t length = 0;
+            while (text[length])
+                ++length;
+            const auto units = static_cast<uint16_t>(length < 0xFFFF ? length : 0xFFFF);
+            if (Size + 1 + sizeof(units) + units * sizeof(uint16_t) > MaxPayload)
+                return false;
+            Data[Size++] = static_cast<uint8_t>(type);
+            memcpy(Data + Size, &units, sizeof(units));
+            Size += sizeof(units);
+            for (uint16_t i = 0; i < units; ++i) {
+                if constexpr (sizeof(Char) == 1) {
+                    Data[Size++] = static_cast<uint8_t>(text[i]);
+                }
+                else {
+                    const auto unit = static_cast<uint16_t>(text[i]);
+                    memcpy(Data + Size, &unit, sizeof(unit));
+                    Size += sizeof(unit);
+                }
+            }
+            return true;
+        }
+
+        template <typename T>
+        bool Put(const T& value) {
+            using U = std::decay_t<T>;
+            if constexpr (std::is_same_v<U, char*> || std::is_same_v<U, const char*>) {
+                return PutString(ArgType::String, static_cast<const char*>(value));
+            }
+            else if constexpr (std::is_same_v<U, wchar_t*> || std::is_same_v<U, const wchar_t*>) {
+                return PutString(ArgType::WideString, static_cast<const wchar_t*>(value));
+            }
+            else if constexpr (std::is_pointer_v<U> || std::is_null_pointer_v<U>) {
+                const auto address = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(static_cast<const volatile void*>(value)));
+                return PutRaw(ArgType::Pointer, &address, sizeof(address));
+            }
+            else if constexpr (std::is_floating_point_v<U>) {
+                const auto number = static_cast<double>(value);
+                return PutRaw(ArgType::Double, &number, sizeof(number));
+            }
+            else if constexpr (std::is_enum_v<U>) {
+                return Put(static_cast<std::underlying_type_t<U>>(value));
+            }
+            else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+                const auto number = static_cast<int64_t>(value);
+                return PutRaw(sizeof(U) <= 4 ? ArgType::Int32 : ArgType::Int, &number, sizeof(number));
+            }
+            else if constexpr (std::is_integral_v<U>) {
+                const auto number = static_cast<uint64_t>(value);
+                return PutRaw(sizeof(U) <= 4 ? ArgType::UInt32 : ArgType::UInt, &number, sizeof(number));
+            }
+            else {
+                static_assert(std::is_arithmetic_v<U>, "Unsupported log argument type (pass .c_str() for strings)");
+                return false;
+            }
+        }
+    };
+
+    // ---- decoding ----
+
+    /**
+     * @brief Reads the arguments of a Message record back in order.
+     */
+    class ArgReader {
+    public:
+        ArgReader(const uint8_t* data, const size_t size) : _Data(data), _Size(size) {}
+
+        bool Next(ArgType& type, uint64_t& bits, std::wstring& wide, std::string& narrow) {
+            if (_Offset >= _Size)
+                return false;
+            type = static_cast<ArgType>(_Data[_Offset++]);
+            if (type == ArgType::String || type == ArgType::WideString) {
+                uint16_t units = 0;
+                if (!Read(&units, sizeof(units)))
+                    return false;
+                narrow.clear();
+                wide.clear();
+                for (uint16_t i = 0; i < units; ++i) {
+                    if (type == ArgType::String) {
+                        if (_Offset >= _Size)
+                            return false;
+                        narrow.push_back(static_cast<char>(_Data[_Offset++]));
+                    }
+                    else {
+                        uint16_t unit = 0;
+                        if (!Read(&unit, sizeof(unit)))
+                            return false;
+                        wide.push_back(static_cast<wchar_t>(unit));
+                    }
+                }
+                return true;
+            }
+            return Read(&bits, sizeof(bits));
+        }
+
+    private:
+        bool Read(void* out, const size_t size) {
+            if (_Offset + size > _Size)
+                return false;
+            memcpy(out, _Data + _Offset, size);
+            _Offset += size;
+            return true;
+        }
+
+        const uint8_t* _Data;
+        size_t _Size;
+        size_t _Offset = 0;
+    };
+
+    /**
+     * @brief Appends one printf conversion to out, growing it to the length the first call reports.
+     */
+    template <typename T>
+    void AppendFormatted(std::string& out, const char* spec, const T value) {
+        char piece[256];
+        const int length = snprintf(piece, sizeof(piece), spec, value);
+        if (length <= 0)
+            return;
+        if (static_cast<size_t>(length) < sizeof(piece)) {
+            out.append(piece, static_cast<size_t>(length));
+            return;
+        }
+        const size_t offset = out.size();
+        out.resize(offset + static_cast<size_t>(length) + 1);
+        snprintf(out.data() + offset, static_cast<size_t>(length) + 1, spec, value);
+        out.resize(offset + static_cast<size_t>(length));
+    }
+
+    /**
+     * @brief Renders a format string against the arguments of a Message record.
+     *
+     * Length modifiers in the format are replaced by the width the argument was stored with,
+     * so a record always renders the same way regardless of the writer's architecture.
+     */
+    inline std::string Render(const std::string_view format, const uint8_t* args, const size_t size) {
+        ArgReader reader(args, size);
+        std::string out;
+        out.reserve(format.size() + 32);
+
+        ArgType type{};
+        uint64_t bits = 0;
+        std::wstring wide;
+        std::string narrow;
+
+        for (size_t i = 0; i < format.size(); ++i) {
+            if (format[i] != '%') {
+                out.push_back(format[i]);
+                continue;
+            }
+            if (i + 1 < format.size() && format[i + 1] == '%') {
+                out.push_back('%');
+                ++i;
+                continue;
+            }
+
+            // %[flags][width][.precision][length]conversion
+            std::string spec = "%";
+            size_t j = i + 1;
+            while (j < format.size() && strchr("-+ #0123456789.*", format[j])) {
+                if (format[j] == '*') {
+                    if (!reader.Next(type, bits, wide, narrow))
+                        return out + "<missing argument>";
+                    spec += std::to_string(static_cast<int64_t>(bits));
+                }
+                else {
+                    spec.push_back(format[j]);
+                }
+                ++j;
+            }
+            while (j < format.size() && strchr("hlLzjtwI0123456789", format[j]))
+                ++j;
+            if (j >= format.size())
+                break;
+
+            const char conversion = format[j];
+            i = j;
+            if (!reader.Next(type, bits, wide, narrow))
+                return out + "<missing argument>";
+
+            double number = 0;
+            switch (type) {
+            case ArgType::String:
+                AppendFormatted(out, (spec + "s").c_str(), narrow.c_str());
+                break;
+            case ArgType::WideString: {
+                // Narrow the text ourselves: %ls depends on the locale of the decoder
+                std::string converted;
+                for (const wchar_t c : wide)
+                    converted.push_back(c < 0x80 ? static_cast<char>(c) : '?');
+                AppendFormatted(out, (spec + "s").c_str(), converted.c_str());
+                break;
+            }
+            case ArgType::Double:
+                memcpy(&number, &bits, sizeof(number));
+                AppendFormatted(out, (spec + (strchr("fFeEgGaA", conversion) ? conversion : 'g')).c_str(), number);
+                break;
+            case ArgType::Pointer:
+                if (conversion == 'p')
+                    AppendFormatted(out, "0x%016llx", static_cast<unsigned long long>(bits));
+                else
+                    AppendFormatted(out, (spec + "ll" + (strchr("xXou", conversion) ? conversion : 'x')).c_str(), static_cast<unsigned long long>(bits));
+                break;
+            case ArgType::Int32:
+            case ArgType::UInt32:
+                // Unsigned conversions of a 32-bit argument see its 32 bits, not the sign-extended 64
+                if (strchr("uxXo", conversion)) {
+                    AppendFormatted(out, (spec + "ll" + conversion).c_str(), static_cast<unsigned long long>(static_cast<uint32_t>(bits)));
+                    break;
+                }
+                [[fallthrough]];
+            case ArgType::Int:
+            case ArgType::UInt:
+                if (conversion == 'c')
+                    AppendFormatted(out, (spec + "c").c_str(), static_cast<int>(bits));
+                else if (strchr("diuxXo", conversion))
+                    AppendFormatted(out, (spec + "ll" + conversion).c_str(), static_cast<long long>(bits));
+                else
+                    AppendFormatted(out, "%lld", static_cast<long long>(bits));
+                break;
+            default:
+                return out + "<corrupt record>";
+            }
+        }
+        return out;
+    }
+}
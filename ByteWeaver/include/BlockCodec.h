@@ -0,0 +1,49 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include <ByteWeaverPCH.h>
+
+namespace ByteWeaver {
+
+    /**
+     * @brief LZ4 block compression, for module dumps.
+     *
+     * Blocks use the LZ4 block format (token, literals, 16-bit offset, match length), so they can be
+     * read by any LZ4 block decoder. The encoder is a single-pass greedy matcher over a 64K-entry hash
+     * table that skips ahead faster through incompressible data; it favours speed over ratio, which
+     * suits code and data sections that are read once and written straight out.
+     *
+     * ### Example:
+     * ```cpp
+     * std::vector<uint8_t> packed(BlockCodec::CompressBound(raw.size()));
+     * packed.resize(BlockCodec::Compress(raw.data(), raw.size(), packed.data(), packed.size()));
+     * BlockCodec::Decompress(packed.data(), packed.size(), raw.data(), raw.size());
+     * ```
+     */
+    class BlockCodec {
+    public:
+        /// @brief Largest compressed size of size input bytes
+        static constexpr size_t CompressBound(const size_t size) noexcept { return size + size / 255 + 16; }
+
+        /**
+         * @brief Compresses one block.
+         * @param source Input bytes
+         * @param size Number of input bytes
+         * @param destination Output buffer
+         * @param capacity Size of the output buffer, at least CompressBound(size)
+         * @return Compressed size, or 0 if capacity is too small
+         */
+        static size_t Compress(const uint8_t* source, size_t size, uint8_t* destination, size_t capacity);
+
+        /**
+         * @brief Decompresses one block into exactly size bytes.
+         * @param source Compressed block
+         * @param sourceSize Size of the block
+         * @param destination Output buffer
+         * @param size Expected decompressed size
+         * @return false if the block is malformed or does not decompress to exactly size bytes
+         */
+        static bool Decompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t size);
+    };
+}
@@ -42,6 +42,27 @@ Copyright(C) 2025 0xKate
 #include <AddressDB.h>
 #include <AddressEntry.h>
 #include <AddressScanner.h>
+#include <AddressTable.h>
+#include <BinaryLog.h>
+#include <BlockCodec.h>
+#include <CompiledPattern.h>
+#include <DeferredLoader.h>
+#include <ExportIndex.h>
+#include <HookDescriptor.h>
+#include <HookStats.h>
+#include <InlineHook.h>
 #include <MemoryManager.h>
+#include <MidHook.h>
+#include <ModArena.h>
+#include <ModBytes.h>
+#include <ModuleDumper.h>
+#include <ModuleRegistry.h>
+#include <NearHook.h>
+#include <ParallelScan.h>
+#include <RegionMap.h>
+#include <ScanEngine.h>
+#include <ScanScope.h>
+#include <SignatureCache.h>
+#include <TrampolinePool.h>
 #include <WinDetour.h>
 #include <WinPatch.h>
\ No newline at end of file
@@ -9,12 +9,19 @@
 // ReSharper disable file CppUnusedIncludeDirective
 
 // STD Lib
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <condition_variable>
 #include <cstdarg>
 #include <cstdint>
 #include <cstdio>
+#include <deque>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -22,13 +29,19 @@
 #include <optional>
 #include <ranges>
 #include <shared_mutex>
+#include <span>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+// Binary log record layout (STD lib only)
+#include <BinaryLogFormat.hpp>
+
 #if defined(_WIN64)
     #ifndef ADDR_FMT
         #define ADDR_FMT "0x%016llx"
@@ -58,16 +71,27 @@ namespace ByteWeaver {
 
     inline LogFunction LogCallback = nullptr;
     inline std::mutex LogMutex;
+    inline std::atomic<int> MinLogLevel{ static_cast<int>(LogLevel::LOG_DEBUG) };
+    inline std::atomic<bool> BinaryLogEnabled{ false };
 
     // Install a custom logger from the outside
     inline void SetLogCallback(const LogFunction fn) {
         LogCallback = fn;
     }
 
-    inline void LogInternal(const int level, const char* fmt, va_list args) {
-        char buffer[1024];
-        vsnprintf(buffer, sizeof(buffer), fmt, args);
+    // Messages below this level are dropped before any formatting
+    inline void SetLogLevel(const LogLevel level) {
+        MinLogLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+    }
+
+    inline bool IsLogLevelEnabled(const int level) {
+        return level >= MinLogLevel.load(std::memory_order_relaxed);
+    }
+
+    // Defined in BinaryLog.cpp; only called while BinaryLog is open
+    void WriteBinaryLog(int level, const char* fmt, const uint8_t* args, size_t size);
 
+    inline void LogText(const int level, const char* buffer) {
         std::lock_guard lock(LogMutex);
         if (LogCallback) {
             LogCallback(static_cast<LogLevel>(level), buffer);
@@ -88,25 +112,40 @@ namespace ByteWeaver {
         }
     }
 
-    inline void Debug(const char* fmt, ...) {
-        va_list args; va_start(args, fmt);
-        LogInternal(0, fmt, args);
-        va_end(args);
+    // Binary mode stores the format pointer and raw arguments; only text mode formats here
+    template <typename... Args>
+    void LogFormatted(const int level, const char* fmt, const Args&... args) {
+        if (!IsLogLevelEnabled(level))
+            return;
+
+        if (BinaryLogEnabled.load(std::memory_order_relaxed)) {
+            BinaryLogFormat::ArgBuffer record;
+            if ((record.Put(args) && ...)) {
+                WriteBinaryLog(level, fmt, record.Data, record.Size);
+                return;
+            }
+        }
+
+        char buffer[1024];
+        snprintf(buffer, sizeof(buffer), fmt, args...);
+        LogText(level, buffer);
+    }
+
+    template <typename... Args>
+    void Debug(const char* fmt, const Args&... args) {
+        LogFormatted(0, fmt, args...);
     }
-    inline void Info(const char* fmt, ...) {
-        va_list args; va_start(args, fmt);
-        LogInternal(1, fmt, args);
-        va_end(args);
+    template <typename... Args>
+    void Info(const char* fmt, const Args&... args) {
+        LogFormatted(1, fmt, args...);
     }
-    inline void Warn(const char* fmt, ...) {
-        va_list args; va_start(args, fmt);
-        LogInternal(2, fmt, args);
-        va_end(args);
+    template <typename... Args>
+    void Warn(const char* fmt, const Args&... args) {
+        LogFormatted(2, fmt, args...);
     }
-    inline void Error(const char* fmt, ...) {
-        va_list args; va_start(args, fmt);
-        LogInternal(3, fmt, args);
-        va_end(args);
+    template <typename... Args>
+    void Error(const char* fmt, const Args&... args) {
+        LogFormatted(3, fmt, args...);
     }
 
 }
\ No newline at end of file
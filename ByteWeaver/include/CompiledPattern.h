@@ -0,0 +1,99 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include <ByteWeaverPCH.h>
+
+namespace ByteWeaver {
+
+    /**
+     * @brief Pre-analysed byte signature ready to be fed to ScanEngine.
+     *
+     * A CompiledPattern is built once when a signature is registered and reused for every
+     * scan. It stores the pattern as packed value/mask byte arrays (no per-byte optional
+     * checks), the anchor bytes used by the SSE2/AVX2 filter, and a Boyer-Moore-Horspool
+     * skip table for the scalar backend.
+     *
+     * ## Layout
+     *
+     * - Values: expected byte at each position, 0x00 for wildcards
+     * - Masks:  0xFF for a fixed byte, 0x00 for a wildcard
+     *
+     * A position matches when `(memory[i] & Masks[i]) == Values[i]`.
+     *
+     * ### Example:
+     * ```cpp
+     * const auto pattern = CompiledPattern::Parse("48,8B,C4,?,89,58,08");
+     * auto address = AddressScanner::FindSignature(moduleBase, moduleSize, pattern);
+     * ```
+     *
+     * @see AddressScanner, ScanEngine
+     */
+    class CompiledPattern {
+    public:
+        /// @brief Expected byte values (wildcards stored as 0x00)
+        std::vector<uint8_t> Values{};
+
+        /// @brief Per-byte masks (0xFF fixed, 0x00 wildcard)
+        std::vector<uint8_t> Masks{};
+
+        /// @brief Pattern length in bytes
+        size_t Length = 0;
+
+        /// @brief Offset of the rarest fixed byte, or SIZE_MAX for wildcard-only patterns
+        size_t Anchor = SIZE_MAX;
+
+        /// @brief Offset of the second rarest fixed byte (equals Anchor if only one fixed byte exists)
+        size_t Confirm = SIZE_MAX;
+
+        /**
+         * @brief Boyer-Moore-Horspool shift for each byte value seen at the pattern's last position.
+         *
+         * Wildcards match every byte, so no shift ever jumps past the last wildcard
+         * in the pattern (excluding the final position).
+         */
+        std::array<uint32_t, 256> SkipTable{};
+
+        /**
+         * @brief Constructs an empty pattern.
+         */
+        CompiledPattern() = default;
+
+        /**
+         * @brief Compiles a pattern from optional bytes (std::nullopt = wildcard).
+         *
+         * @param pattern Pattern as returned by AddressScanner::ParsePattern
+         * @return Fully analysed pattern
+         */
+        static CompiledPattern FromBytes(const std::vector<std::optional<uint8_t>>& pattern);
+
+        /**
+         * @brief Parses and compiles a comma-separated hex pattern string.
+         *
+         * @param patternStr Pattern such as "48,8B,?,89,58" (see AddressScanner::ParsePattern)
+         * @return Fully analysed pattern
+         */
+        static CompiledPattern Parse(const std::string& patternStr);
+
+        /**
+         * @brief Checks whether the pattern matches the bytes at the given location.
+         *
+         * @param location Pointer to at least Length readable bytes
+         * @return true if every fixed byte matches
+         */
+        [[nodiscard]] bool MatchesAt(const uint8_t* location) const;
+
+        /**
+         * @brief Returns true when the pattern has no bytes.
+         */
+        [[nodiscard]] bool Empty() const noexcept { return Length == 0; }
+
+        /**
+         * @brief Returns true when the pattern has at least one fixed (non-wildcard) byte.
+         */
+        [[nodiscard]] bool HasAnchor() const noexcept { return Anchor != SIZE_MAX; }
+
+    private:
+        void Analyse();
+    };
+}
@@ -0,0 +1,90 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include <ByteWeaverPCH.h>
+#include <AddressDB.h>
+#include <ModuleRegistry.h>
+
+namespace ByteWeaver {
+
+    /**
+     * @brief Resolves deferred AddressDB entries and installs deferred hooks when their module loads.
+     *
+     * Replaces polling UpdateAll()/ApplyAllMods() from a timer: ModuleRegistry's loader
+     * notification wakes a dedicated thread, which resolves only the loaded module's entries
+     * (AddressDB::UpdateModule, batched scanner included) and then creates only the hooks that
+     * target that module and applies them as one batch (MemoryManager::ApplyMods). When a module
+     * unloads, its hooks are dropped from MemoryManager without restoring (the code is gone) and
+     * wait for the next load.
+     *
+     * Work runs on the DeferredLoader thread rather than inside the notification: resolving
+     * takes AddressDB's lock, which other threads may hold while calling into the loader.
+     *
+     * ### Example:
+     * ```cpp
+     * AddressDB::AddWithScanPattern("lua_pcall", L"lua51.dll", "55,8B,EC,?,?,?,?,8B,45,08");
+     * INSTALL_HOOK_DEFERRED(LuaPcall, "lua_pcall", L"lua51.dll"); // installs as soon as lua51.dll maps
+     * ```
+     *
+     * @note Call Stop() before unloading a DLL that started the loader
+     */
+    class DeferredLoader {
+    public:
+        /**
+         * @brief Creates the modification for a resolved target; returns false if it could not be created.
+         */
+        using HookInstaller = std::function<bool(uintptr_t address)>;
+
+        /**
+         * @brief Subscribes to module notifications and starts the loader thread (idempotent).
+         */
+        static void Start();
+
+        /**
+         * @brief Unsubscribes and joins the loader thread. Pending hooks are kept.
+         */
+        static void Stop();
+
+        /**
+         * @brief Registers a hook whose target lives in a module that may not be loaded yet.
+         *
+         * The AddressDB entry (symbolName, moduleName) is marked deferred. If the module is
+         * already loaded the hook is installed before this returns, otherwise on load.
+         *
+         * @param modKey MemoryManager key the installer creates the modification under
+         * @param symbolName Symbol of the AddressDB entry that resolves the target
+         * @param moduleName Module of the AddressDB entry
+         * @param install Creates the modification (e.g. MemoryManager::CreateDetour) for the address
+         *
+         * @return false if no AddressDB entry with this key exists
+         */
+        static bool DeferHook(std::string modKey, std::string symbolName, std::wstring moduleName, HookInstaller install);
+
+        /**
+         * @brief Resolves the module's entries and installs its pending hooks on the calling thread.
+         *
+         * @return Number of hooks installed
+         */
+        static size_t ProcessModule(const std::wstring& moduleName);
+
+        /**
+         * @brief Number of deferred hooks that are not installed.
+         */
+        static size_t PendingHooks();
+
+    private:
+        struct DeferredHook {
+            std::string ModKey;
+            AddressDB::Key Symbol;
+            HookInstaller Install;
+            bool Installed = false;
+        };
+
+        static void OnModuleUnloaded(const LoadedModule& module);
+        static void WorkerLoop();
+
+        static std::vector<DeferredHook> _Hooks;
+        static std::mutex _HooksMutex;
+    };
+}
@@ -5,6 +5,34 @@
 #include <ByteWeaverPCH.h>
 #include <WinDetour.h>
 #include <MemoryManager.h>
+#include <DeferredLoader.h>
+#include <HookDescriptor.h>
+#include <HookStats.h>
+
+/**
+ * Hook call counters (opt-in). With BYTEWEAVER_ENABLE_HOOK_STATS set, every DECLARE_HOOK_* also
+ * declares Name##Stats and a thunk that times the hook body (original call included) before
+ * forwarding to Name##Hook; the INSTALL_HOOK_* macros detour to that thunk instead of the hook.
+ * Read the counters with MemoryManager::GetHookStats(#Name). Without it nothing extra is generated.
+ */
+#if BYTEWEAVER_ENABLE_HOOK_STATS
+    // The thunk takes its parameter types from the hook's own function type, so named parameters work
+    #define BYTEWEAVER_HOOK_STATS(Name, HookCallType)               \
+    static inline ByteWeaver::HookStats Name##Stats{ #Name };       \
+    template <typename HookType> struct Name##Thunk;                \
+    template <typename HookRet, typename... HookArgs>               \
+    struct Name##Thunk<HookRet(HookCallType*)(HookArgs...)> {       \
+        static HookRet HookCallType Call(HookArgs... _args) {       \
+            ByteWeaver::HookTimer _timer(Name##Stats);              \
+            return Name##Hook(_args...);                            \
+        }                                                           \
+    };                                                              \
+    static constexpr decltype(&Name##Hook) Name##Entry = &Name##Thunk<decltype(&Name##Hook)>::Call;
+    #define BYTEWEAVER_HOOK_ENTRY(Name) Name##Entry
+#else
+    #define BYTEWEAVER_HOOK_STATS(Name, HookCallType)
+    #define BYTEWEAVER_HOOK_ENTRY(Name) Name##Hook
+#endif
 
 /**
  *  Declare a hook.
@@ -17,7 +45,8 @@
 using Name##_t = Ret(CallType*)(__VA_ARGS__);                       \
 static inline uintptr_t Name##Address{};                            \
 static inline Name##_t  Name##Original{};                           \
-static Ret HookCallType Name##Hook(__VA_ARGS__);
+static Ret HookCallType Name##Hook(__VA_ARGS__);                    \
+BYTEWEAVER_HOOK_STATS(Name, HookCallType)
 
 /**
  *  Declare a hook with matching call types.
@@ -29,7 +58,8 @@ static Ret HookCallType Name##Hook(__VA_ARGS__);
 using Name##_t = Ret(CallType*)(__VA_ARGS__);                       \
 static inline uintptr_t Name##Address{};                            \
 static inline Name##_t  Name##Original{};                           \
-static Ret CallType Name##Hook(__VA_ARGS__);
+static Ret CallType Name##Hook(__VA_ARGS__);                        \
+BYTEWEAVER_HOOK_STATS(Name, CallType)
 
 /**
  * For hooking methods using __thiscall. Adds THIS, and EDX params for you.
@@ -41,7 +71,8 @@ static Ret CallType Name##Hook(__VA_ARGS__);
 using Name##_t = Ret(__thiscall*)(const void* p_this, __VA_ARGS__); \
 static inline uintptr_t Name##Address{};                            \
 static inline Name##_t  Name##Original{};                           \
-static Ret HookCallType Name##Hook(const void* p_this, int edx, __VA_ARGS__);
+static Ret HookCallType Name##Hook(const void* p_this, int edx, __VA_ARGS__); \
+BYTEWEAVER_HOOK_STATS(Name, HookCallType)
 
 
 /**
@@ -58,7 +89,8 @@ static Ret HookCallType Name##Hook(const void* p_this, int edx, __VA_ARGS__);
         Name##Original = reinterpret_cast<Name##_t>(Name##Address); \
         MemoryManager::CreateDetour(#Name, Name##Address,           \
             &reinterpret_cast<PVOID&>(Name##Original),              \
-            reinterpret_cast<void*>(Name##Hook));                   \
+            reinterpret_cast<void*>(                                \
+                BYTEWEAVER_HOOK_ENTRY(Name)));                      \
                                                                     \
         Logger::Debug("[" #Name "] Resolved %s at " ADDR_FMT,       \
             #Symbol, static_cast<uintptr_t>(Name##Address));        \
@@ -82,6 +114,62 @@ static Ret HookCallType Name##Hook(const void* p_this, int edx, __VA_ARGS__);
     Name##Original = reinterpret_cast<Name##_t>(Name##Address);     \
     ByteWeaver::MemoryManager::CreateDetour(#Name, Name##Address,   \
         &reinterpret_cast<PVOID&>(Name##Original),                  \
-        reinterpret_cast<void*>(Name##Hook));                       \
+        reinterpret_cast<void*>(BYTEWEAVER_HOOK_ENTRY(Name)));      \
+}
+
+
+
+/**
+ * Install a hook once the module containing its AddressDB entry loads.
+ * Installs immediately if the module is already loaded. (See DeferredLoader)
+ * @param Name The Prefix for the macro, and string name of hook/patch.
+ * @param Symbol The exact function name as it was entered in addressDB. (ex. lua_gettop)
+ * @param Module The exact module name in AddressDB. (ex. lua514.dll)
+ */
+#define INSTALL_HOOK_DEFERRED(Name, Symbol, Module)                 \
+{                                                                   \
+    ByteWeaver::DeferredLoader::DeferHook(#Name, Symbol, Module,    \
+        [](const uintptr_t _address) -> bool {                      \
+            Name##Address = _address;                               \
+            Name##Original =                                        \
+                reinterpret_cast<Name##_t>(Name##Address);          \
+            return ByteWeaver::MemoryManager::CreateDetour(#Name,   \
+                Name##Address,                                      \
+                &reinterpret_cast<PVOID&>(Name##Original),          \
+                reinterpret_cast<void*>(                            \
+                    BYTEWEAVER_HOOK_ENTRY(Name))) != nullptr;       \
+        });                                                         \
 }
 
+
+/**
+ * Hook descriptors: the INSTALL_HOOK_* setup as constexpr data. Each one describes a hook declared
+ * with DECLARE_HOOK_*; a static table of them is installed in one MemoryManager::InstallHooks()
+ * call, which resolves the symbols under one AddressDB lock and registers every hook with one
+ * MemoryManager update. Append .As(ByteWeaver::HookKind::NearHook) for a NearHook. (See HookDescriptor)
+ * @param Name The Prefix given to DECLARE_HOOK_*, and string name of the hook.
+ * @param GroupID MemoryManager group of the hook. (ex. 0x0100)
+ */
+#define HOOK_ADDRESS(Name, AddressValue, GroupID)                   \
+    ByteWeaver::HookDescriptor::AtAddress<                          \
+        BYTEWEAVER_HOOK_ENTRY(Name)>(#Name, &Name##Address,         \
+        &Name##Original, AddressValue, GroupID)
+
+/**
+ * Describe a hook on an AddressDB entry, resolved when the table is installed.
+ * @param Symbol The exact function name as it was entered in addressDB. (ex. "lua_gettop")
+ * @param Module The exact module name in AddressDB. (ex. L"lua514.dll")
+ */
+#define HOOK_SYMBOL(Name, Symbol, Module, GroupID)                  \
+    ByteWeaver::HookDescriptor::FromSymbol<                         \
+        BYTEWEAVER_HOOK_ENTRY(Name)>(#Name, &Name##Address,         \
+        &Name##Original, Symbol, Module, GroupID)
+
+/**
+ * Describe a hook on an AddressDB entry, installed and applied once its module loads.
+ * (Same as INSTALL_HOOK_DEFERRED, see DeferredLoader)
+ */
+#define HOOK_DEFERRED(Name, Symbol, Module, GroupID)                \
+    ByteWeaver::HookDescriptor::Deferred<                           \
+        BYTEWEAVER_HOOK_ENTRY(Name)>(#Name, &Name##Address,         \
+        &Name##Original, Symbol, Module, GroupID)
@@ -0,0 +1,113 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include <ByteWeaverPCH.h>
+#include <SignatureCache.h>
+
+namespace ByteWeaver {
+
+    /**
+     * @brief Lookup table over the export directory of one loaded module.
+     *
+     * Built once per module from IMAGE_EXPORT_DIRECTORY: the name table is copied into a sorted
+     * array of (name, ordinal index) pairs and searched with a binary search, optionally backed by
+     * a hash map. Ordinals are resolved directly through the function table, and forwarded exports
+     * ("KERNELBASE.SleepEx", "NTDLL.#12") are followed into the target module's own index. A
+     * forwarder whose target module is not loaded does not resolve; lookups never load modules.
+     *
+     * Indexes are shared through Get(). A cached index is dropped when its module unloads and
+     * rebuilt when a different image (by base address or ModuleIdentity) is found at that address.
+     *
+     * ### Example:
+     * ```cpp
+     * auto exports = ExportIndex::Get(reinterpret_cast<const uint8_t*>(GetModuleHandleW(L"lua51.dll")));
+     * if (exports) {
+     *     auto pcall = exports->FindByName("lua_pcall");
+     *     auto byOrdinal = exports->FindByOrdinal(42);
+     * }
+     * ```
+     *
+     * @note Name views point into the module image and stay valid while the module is loaded
+     */
+    class ExportIndex {
+    public:
+        /**
+         * @brief Returns the shared index of a loaded module, building it on first use.
+         *
+         * @param moduleBase Base address of a module loaded in this process
+         * @return Index, or nullptr if the image has no export directory or invalid headers
+         */
+        static std::shared_ptr<const ExportIndex> Get(const uint8_t* moduleBase);
+
+        /**
+         * @brief Drops the cached index of a module (called automatically on unload).
+         */
+        static void Invalidate(const uint8_t* moduleBase);
+
+        /**
+         * @brief Drops every cached index.
+         */
+        static void Clear();
+
+        /**
+         * @brief Also index names in a hash map (off by default; applies to indexes built afterwards).
+         *
+         * Binary search needs about log2(names) string compares, which is fine for most modules;
+         * the hash map trades memory for constant-time lookups in very large export tables.
+         */
+        static void SetHashLookup(bool enabled);
+
+        /**
+         * @brief Resolves an export by name, following forwarders.
+         *
+         * @return Absolute address, or std::nullopt if not exported
+         *
+         * @note Names are case-sensitive
+         */
+        std::optional<uintptr_t> FindByName(std::string_view name) const;
+
+        /**
+         * @brief Resolves an export by ordinal (including the ordinal base), following forwarders.
+         *
+         * @return Absolute address, or std::nullopt if the ordinal is unused
+         */
+        std::optional<uintptr_t> FindByOrdinal(uint32_t ordinal) const;
+
+        /**
+         * @brief Returns the forwarder string of a named export, or an empty view if it is not forwarded.
+         */
+        std::string_view ForwarderOf(std::string_view name) const;
+
+        /// @brief Base address of the indexed module
+        const uint8_t* Base() const noexcept { return _Base; }
+
+        /// @brief Identity of the image the index was built from
+        const ModuleIdentity& Identity() const noexcept { return _Identity; }
+
+        /// @brief Number of named exports
+        size_t NameCount() const noexcept { return _Names.size(); }
+
+    private:
+        ExportIndex() = default;
+
+        static std::shared_ptr<const ExportIndex> Build(const uint8_t* moduleBase, const ModuleIdentity& identity, bool hashLookup);
+
+        std::optional<uint32_t> FindFunctionIndex(std::string_view name) const;
+        std::optional<uintptr_t> ResolveFunction(uint32_t functionIndex, int depth) const;
+        static std::optional<uintptr_t> ResolveForwarder(std::string_view forwarder, int depth);
+
+        const uint8_t* _Base = nullptr;
+        ModuleIdentity _Identity{};
+        const uint32_t* _Functions = nullptr;
+        uint32_t _FunctionCount = 0;
+        uint32_t _OrdinalBase = 0;
+        uint32_t _DirectoryBegin = 0;
+        uint32_t _DirectoryEnd = 0;
+
+        // Sorted by name; second is the index into the function table
+        std::vector<std::pair<std::string_view, uint32_t>> _Names;
+        std::unordered_map<std::string_view, uint32_t> _Hashed;
+        bool _HashLookup = false;
+    };
+}
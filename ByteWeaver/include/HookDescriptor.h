@@ -0,0 +1,210 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include <ByteWeaverPCH.h>
+#include <AddressTable.h>
+
+namespace ByteWeaver {
+
+    /// @brief Hash of a MemoryManager key, as used by its lookup table; constexpr so descriptors carry it.
+    /// The same FNV-1a as AddressTable::SymbolHash, kept in one place.
+    constexpr uint64_t HashModKey(const std::string_view key) noexcept {
+        return AddressTable::SymbolHash(key);
+    }
+
+    /// @brief Return and parameter types of a function pointer, whatever its calling convention
+    template <typename Function>
+    struct HookSignature {
+        static constexpr bool IsFunction = false;
+    };
+
+    #define BYTEWEAVER_HOOK_SIGNATURE(CallType)                         \
+    template <typename Ret, typename... Args>                           \
+    struct HookSignature<Ret(CallType*)(Args...)> {                     \
+        static constexpr bool IsFunction = true;                        \
+        using Return = Ret;                                             \
+        using Params = std::tuple<Args...>;                             \
+    };
+    BYTEWEAVER_HOOK_SIGNATURE(__cdecl)
+    #if !defined(_WIN64)
+        // Distinct types on x86 only; x64 has one calling convention
+        BYTEWEAVER_HOOK_SIGNATURE(__stdcall)
+        BYTEWEAVER_HOOK_SIGNATURE(__fastcall)
+        BYTEWEAVER_HOOK_SIGNATURE(__thiscall)
+    #endif
+    #undef BYTEWEAVER_HOOK_SIGNATURE
+
+    /// @brief Parameters of a DECLARE_HOOK_THISCALL hook for an original taking OriginalParams (edx after this)
+    template <typename OriginalParams>
+    struct ThiscallHookParams {
+        using Type = void;
+    };
+
+    template <typename This, typename... Args>
+    struct ThiscallHookParams<std::tuple<This, Args...>> {
+        using Type = std::tuple<This, int, Args...>;
+    };
+
+    /**
+     * @brief True if Hook can stand in for Original: same return and parameter types, or the
+     *        DECLARE_HOOK_THISCALL form with the edx parameter after this. Calling conventions
+     *        may differ (DECLARE_HOOK).
+     */
+    template <typename Hook, typename Original>
+    constexpr bool HookMatchesOriginal() {
+        using HookSig = HookSignature<Hook>;
+        using OriginalSig = HookSignature<Original>;
+        if constexpr (!HookSig::IsFunction || !OriginalSig::IsFunction) {
+            return false;
+        }
+        else {
+            using OriginalParams = typename OriginalSig::Params;
+            return std::is_same_v<typename HookSig::Return, typename OriginalSig::Return> &&
+                   (std::is_same_v<typename HookSig::Params, OriginalParams> ||
+                    std::is_same_v<typename HookSig::Params, typename ThiscallHookParams<OriginalParams>::Type>);
+        }
+    }
+
+    /// @brief How a HookDescriptor finds its target
+    enum class HookResolve : uint8_t {
+        Address,    ///< Fixed address given in the descriptor
+        Symbol,     ///< AddressDB entry (Symbol, Module), which must exist when the table is installed
+        Deferred    ///< AddressDB entry, hooked when its module loads (see DeferredLoader)
+    };
+
+    /// @brief Modification a HookDescriptor creates
+    enum class HookKind : uint8_t {
+        Detour,     ///< Detour, applied in the shared transaction of the bulk apply calls
+        NearHook    ///< NearHook (5-byte jump), for targets too short for a Detour
+    };
+
+    /**
+     * @brief Compile-time description of one hook, installed in bulk by MemoryManager::InstallHooks().
+     *
+     * Built with the HOOK_ADDRESS / HOOK_SYMBOL / HOOK_DEFERRED macros of DetourMacros.hpp from a
+     * DECLARE_HOOK_* declaration, which supplies the signature and calling conventions: the
+     * descriptor points at Name##Address, Name##Original and the hook (or its stats thunk) and
+     * adds how to resolve the target and which group it joins. The mod key and symbol are hashed
+     * at compile time, so installing a table hashes no strings, and the table itself is constexpr
+     * data with no constructor to run.
+     *
+     * ### Example:
+     * ```cpp
+     * DECLARE_HOOK_SIMPLE(LuaPcall, int, __cdecl, lua_State* L, int nargs, int nresults, int errfunc);
+     * DECLARE_HOOK_SIMPLE(LuaError, int, __cdecl, lua_State* L);
+     *
+     * static constexpr HookDescriptor LuaHooks[] = {
+     *     HOOK_SYMBOL(LuaPcall, "lua_pcall", L"lua51.dll", 0x0100),
+     *     HOOK_SYMBOL(LuaError, "lua_error", L"lua51.dll", 0x0100).As(HookKind::NearHook),
+     * };
+     * static_assert(HookDescriptor::HasUniqueNames(LuaHooks));
+     *
+     * MemoryManager::InstallHooks(LuaHooks);
+     * MemoryManager::ApplyByGroupID(0x0100);
+     * ```
+     *
+     * @note Descriptors are referred to after InstallHooks() returns (deferred hooks install
+     *       later), so tables must have static storage duration
+     */
+    struct HookDescriptor {
+        /// @brief Mod key, also the hook's HookStats key
+        std::string_view Name;
+        uint64_t KeyHash = 0;
+
+        HookResolve Resolve = HookResolve::Address;
+        HookKind Kind = HookKind::Detour;
+        uint16_t GroupID = 0x0000;
+
+        /// @brief Target address (HookResolve::Address)
+        uintptr_t Address = 0;
+
+        /// @brief AddressDB entry (HookResolve::Symbol and HookResolve::Deferred)
+        std::string_view Symbol;
+        std::wstring_view Module;
+        uint64_t SymbolHash = 0;
+
+        /// @brief Receives the resolved target (Name##Address)
+        uintptr_t* TargetOut = nullptr;
+
+        /// @brief Function pointer that receives the original (Name##Original)
+        void* OriginalOut = nullptr;
+
+        /// @brief Returns the function the target is redirected to
+        PVOID (*Detour)() = nullptr;
+
+        /// @brief Copy of the descriptor creating another kind of modification
+        constexpr HookDescriptor As(const HookKind kind) const noexcept {
+            HookDescriptor copy = *this;
+            copy.Kind = kind;
+            return copy;
+        }
+
+        /// @brief Type-erases a hook function; the cast cannot happen in a constant expression
+        template <auto Hook>
+        static PVOID DetourOf() {
+            return reinterpret_cast<PVOID>(Hook);
+        }
+
+        /// @brief Descriptor of a hook at a fixed address
+        template <auto Hook, typename Original>
+        static constexpr HookDescriptor AtAddress(const std::string_view name, uintptr_t* target, Original* original,
+                                                  const uintptr_t address, const uint16_t groupID = 0x0000) {
+            CheckSignature<Hook, Original>();
+            HookDescriptor hook{ name, HashModKey(name), HookResolve::Address };
+            hook.GroupID = groupID;
+            hook.Address = address;
+            hook.TargetOut = target;
+            hook.OriginalOut = original;
+            hook.Detour = &DetourOf<Hook>;
+            return hook;
+        }
+
+        /// @brief Descriptor of a hook on an AddressDB entry, resolved when the table is installed
+        template <auto Hook, typename Original>
+        static constexpr HookDescriptor FromSymbol(const std::string_view name, uintptr_t* target, Original* original,
+                                                   const std::string_view symbol, const std::wstring_view module,
+                                                   const uint16_t groupID = 0x0000) {
+            HookDescriptor hook = AtAddress<Hook>(name, target, original, 0, groupID);
+            hook.Resolve = HookResolve::Symbol;
+            hook.Symbol = symbol;
+            hook.Module = module;
+            hook.SymbolHash = AddressTable::SymbolHash(symbol);
+            return hook;
+        }
+
+        /// @brief Descriptor of a hook on an AddressDB entry, installed and applied when its module loads
+        template <auto Hook, typename Original>
+        static constexpr HookDescriptor Deferred(const std::string_view name, uintptr_t* target, Original* original,
+                                                 const std::string_view symbol, const std::wstring_view module,
+                                                 const uint16_t groupID = 0x0000) {
+            HookDescriptor hook = FromSymbol<Hook>(name, target, original, symbol, module, groupID);
+            hook.Resolve = HookResolve::Deferred;
+            return hook;
+        }
+
+        /// @brief Returns true if no two descriptors of a table share a name (use in a static_assert)
+        static constexpr bool HasUniqueNames(const std::span<const HookDescriptor> hooks) {
+            for (size_t i = 0; i < hooks.size(); ++i) {
+                for (size_t j = i + 1; j < hooks.size(); ++j) {
+                    if (hooks[i].KeyHash == hooks[j].KeyHash && hooks[i].Name == hooks[j].Name)
+                        return false;
+                }
+            }
+            return true;
+        }
+
+    private:
+        template <auto Hook, typename Original>
+        static constexpr void CheckSignature() {
+            using HookType = decltype(Hook);
+            static_assert(std::is_pointer_v<Original> && std::is_function_v<std::remove_pointer_t<Original>>,
+                          "HookDescriptor: the original must be a function pointer (Name##Original)");
+            static_assert(std::is_pointer_v<HookType> && std::is_function_v<std::remove_pointer_t<HookType>>,
+                          "HookDescriptor: the hook must be a function (Name##Hook)");
+            static_assert(sizeof(Original) == sizeof(PVOID), "HookDescriptor: the original is written as a PVOID");
+            static_assert(HookMatchesOriginal<HookType, Original>(),
+                          "HookDescriptor: the hook's signature does not match the original's (Name##Hook vs Name##_t)");
+        }
+    };
+}
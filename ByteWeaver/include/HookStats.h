@@ -0,0 +1,127 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#ifndef BYTEWEAVER_ENABLE_HOOK_STATS
+    #define BYTEWEAVER_ENABLE_HOOK_STATS 0
+#endif
+
+#include <ByteWeaverPCH.h>
+
+#include <intrin.h>
+
+namespace ByteWeaver {
+
+    /**
+     * @brief Point-in-time copy of a hook's counters.
+     */
+    struct HookStatsSnapshot {
+        /// @brief Number of log2 latency buckets; bucket i counts calls that took [2^i, 2^(i+1)) cycles
+        static constexpr size_t BucketCount = 40;
+
+        /// @brief Completed calls of the hook body
+        uint64_t Calls = 0;
+
+        /// @brief Sum of TSC cycles spent in the hook body, original call included
+        uint64_t TotalCycles = 0;
+
+        /// @brief Log2 latency histogram (last bucket also holds everything slower)
+        std::array<uint64_t, BucketCount> Buckets{};
+
+        /// @brief Average cycles per call, or 0 without calls
+        double MeanCycles() const noexcept {
+            return Calls ? static_cast<double>(TotalCycles) / static_cast<double>(Calls) : 0.0;
+        }
+
+        /// @brief Upper bound in cycles of the bucket holding the given percentile (0-100)
+        uint64_t PercentileCycles(double percentile) const noexcept;
+    };
+
+    /**
+     * @brief Call counter and latency histogram of one hook body.
+     *
+     * Declared next to a hook by the DECLARE_HOOK_* macros when BYTEWEAVER_ENABLE_HOOK_STATS is
+     * set, and fed by the thunk they install in front of the hook. Counters are spread over
+     * cache-line sized shards picked per thread, so concurrent callers only ever touch their own
+     * line with relaxed atomics. Snapshots sum the shards; they are consistent per counter but
+     * not across counters while the hook is running.
+     *
+     * With BYTEWEAVER_ENABLE_HOOK_STATS at 0 (the default) the macros install the hook directly
+     * and no HookStats exists. Read the numbers through MemoryManager::GetHookStats().
+     *
+     * @note Define BYTEWEAVER_ENABLE_HOOK_STATS before including DetourMacros.hpp in the
+     *       translation units that declare hooks; the library itself needs no rebuild
+     */
+    class HookStats {
+    public:
+        explicit HookStats(const char* key);
+        ~HookStats();
+
+        HookStats(const HookStats&) = delete;
+        HookStats& operator=(const HookStats&) = delete;
+
+        /// @brief Records one call that took the given number of cycles
+        void Record(const uint64_t cycles) noexcept {
+            Shard& shard = _Shards[ShardIndex()];
+            shard.Calls.fetch_add(1, std::memory_order_relaxed);
+            shard.Cycles.fetch_add(cycles, std::memory_order_relaxed);
+            shard.Buckets[BucketOf(cycles)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /// @brief Mod key the counters belong to
+        const std::string& Key() const noexcept { return _Key; }
+
+        /// @brief Sums the shards
+        HookStatsSnapshot Snapshot() const noexcept;
+
+        /// @brief Zeroes the counters (calls in flight may land on either side)
+        void Reset() noexcept;
+
+        /// @brief Sums every registered HookStats declared under key (one per translation unit)
+        static std::optional<HookStatsSnapshot> Find(const std::string& key);
+
+        /// @brief Snapshots every registered key, sorted by key
+        static std::vector<std::pair<std::string, HookStatsSnapshot>> All();
+
+        /// @brief Resets every HookStats registered under key; returns false if none is
+        static bool Reset(const std::string& key);
+
+        /// @brief Resets every registered HookStats
+        static void ResetAll();
+
+    private:
+        static constexpr size_t ShardCount = 32;
+
+        struct alignas(64) Shard {
+            std::atomic<uint64_t> Calls{ 0 };
+            std::atomic<uint64_t> Cycles{ 0 };
+            std::array<std::atomic<uint64_t>, HookStatsSnapshot::BucketCount> Buckets{};
+        };
+
+        static size_t BucketOf(const uint64_t cycles) noexcept {
+            const size_t log2 = cycles ? 63 - static_cast<size_t>(std::countl_zero(cycles)) : 0;
+            return (std::min)(log2, HookStatsSnapshot::BucketCount - 1);
+        }
+
+        static size_t ShardIndex() noexcept;
+
+        std::string _Key;
+        std::array<Shard, ShardCount> _Shards{};
+    };
+
+    /**
+     * @brief Times a scope into a HookStats (used by the instrumented hook thunks).
+     */
+    class HookTimer {
+    public:
+        explicit HookTimer(HookStats& stats) noexcept : _Stats(stats), _Start(__rdtsc()) {}
+        ~HookTimer() { _Stats.Record(__rdtsc() - _Start); }
+
+        HookTimer(const HookTimer&) = delete;
+        HookTimer& operator=(const HookTimer&) = delete;
+
+    private:
+        HookStats& _Stats;
+        uint64_t _Start;
+    };
+}
@@ -0,0 +1,107 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include <ByteWeaverPCH.h>
+#include <MemoryModification.h>
+
+namespace ByteWeaver {
+
+    /**
+     * @brief Base of the hooks that overwrite five bytes of code with a jmp rel32 into a TrampolinePool slot.
+     *
+     * The slot starts with code supplied by the derived class (WriteEntry()), followed by the
+     * overwritten instructions, relocated with the Detours disassembler (rip-relative operands and
+     * branches are re-targeted), and a jump back past them. Code whose first five bytes branch back
+     * into themselves, or end the function, is refused.
+     *
+     * Other threads are suspended while the jump is written or removed, and a thread stopped
+     * inside the overwritten bytes (or the relocated copy, on restore) is moved to the matching
+     * instruction.
+     *
+     * A Restore() leaves the slot's code in place, and the next Apply() builds a new slot, so a
+     * thread still running the old trampoline never sees it rewritten. Toggling a hook therefore
+     * retires one slot per cycle (see TrampolinePool::SlotsRetired()).
+     *
+     * @see NearHook, MidHook
+     */
+    class InlineHook : public MemoryModification {
+    public:
+        /// @brief Bytes of the jump written over the target
+        static constexpr size_t JumpSize = 5;
+
+        /// @brief Bytes the relocated instructions and the jump back may take, at most
+        static constexpr size_t RelocatedCapacity = 48;
+
+        /// @brief Retires the slots (see TrampolinePool::Free), unless the hook is still applied
+        ~InlineHook() override;
+
+        InlineHook(const InlineHook&) = delete;
+        InlineHook& operator=(const InlineHook&) = delete;
+
+        /**
+         * @brief Builds the slot and writes the jump over the target.
+         * @return true if the hook is live
+         */
+        bool Apply() override;
+
+        /**
+         * @brief Writes the original bytes back; the next Apply() retires the slot and builds a new one.
+         * @return true if the target is back to its original code
+         */
+        bool Restore() override;
+
+        /// @brief Start of the relocated instructions, or 0 before the first Apply()
+        uintptr_t Trampoline() const { return reinterpret_cast<uintptr_t>(_Trampoline); }
+
+        /**
+         * @brief Whether a rel32 displacement taken at from (the end of the instruction) reaches to.
+         * @note Always true on x86, where the displacement wraps around the 32-bit address space.
+         */
+        static bool IsRel32Reachable(const uintptr_t from, const uintptr_t to) {
+            if constexpr (!WIN64)
+                return true;
+            const auto distance = static_cast<int64_t>(to - from);
+            return distance >= INT32_MIN && distance <= INT32_MAX;
+        }
+
+    protected:
+        /**
+         * @brief Decodes the instructions under the jump to size the modification.
+         * @param targetAddress Address the jump is written to
+         * @param type ModType of the derived class
+         * @param slotCount Contiguous TrampolinePool slots for the entry code and the relocated instructions
+         */
+        InlineHook(uintptr_t targetAddress, ModType type, size_t slotCount);
+
+        /**
+         * @brief Writes the derived class's code at the start of the slot (writable during the call).
+         * @param slot First byte of the slot
+         * @param entry Receives the address the jump over the target goes to
+         * @return Bytes written, or std::nullopt to cancel the Apply(). The relocated instructions
+         *         follow immediately, so entry code may fall through into them.
+         */
+        virtual std::optional<size_t> WriteEntry(uint8_t* slot, uintptr_t& entry) = 0;
+
+        /**
+         * @brief Called just before the jump is written (live) and after it is removed or failed
+         * to be written (not live).
+         */
+        virtual void OnLiveChanged(bool live) { (void)live; }
+
+        uint8_t* _Slot = nullptr;
+        uint8_t* _Trampoline = nullptr;
+
+    private:
+        // Offsets of the instruction starts in the target and in the trampoline; entry
+        // _Instructions is the end of the last instruction (Size, and the jump back)
+        std::array<uint8_t, JumpSize + 1> _SourceOffsets{};
+        std::array<uint8_t, JumpSize + 1> _TrampolineOffsets{};
+        uint8_t _Instructions = 0;
+        size_t _SlotCount = 1;
+        bool _SlotWentLive = false;     // entry code may have run, so the slot is never rebuilt
+
+        const char* Name() const;
+        bool WriteTarget(const uint8_t* bytes, bool apply);
+    };
+}
@@ -3,18 +3,107 @@
 #pragma once
 
 #include <ByteWeaverPCH.h>
+#include <HookDescriptor.h>
+#include <HookStats.h>
 #include <MemoryModification.h>
 
+#include "MidHook.h"
+#include "NearHook.h"
 #include "WinDetour.h"
 #include "WinPatch.h"
 
 namespace ByteWeaver {
+	/**
+	 * @brief Stable reference to a registered modification that skips the key lookup
+	 *
+	 * Obtained once with MemoryManager::GetHandle() and passed to the handle overloads of GetMod(),
+	 * ApplyMod() and RestoreMod(), which resolve it by index in the published mod table. Erasing or
+	 * replacing the modification bumps its generation, so a stale handle resolves to nothing.
+	 *
+	 * ### Example:
+	 * ```cpp
+	 * static const ModHandle pcallHook = MemoryManager::GetHandle("LuaPcall");
+	 *
+	 * int __cdecl HookedPcall(lua_State* L, int nargs, int nresults, int errfunc) {
+	 *     if (ShouldUnhook())
+	 *         MemoryManager::RestoreMod(pcallHook); // no string hashing, no lock
+	 *     ...
+	 * }
+	 * ```
+	 */
+	struct ModHandle {
+		/// @brief Slot of the modification in the mod table
+		uint32_t Index = UINT32_MAX;
+
+		/// @brief Generation of the slot when the handle was taken
+		uint32_t Generation = 0;
+
+		/// @brief Returns true if the handle was obtained for an existing modification
+		bool IsValid() const noexcept { return Index != UINT32_MAX; }
+	};
+
+	/**
+	 * @brief One read of a MemoryManager::ReadBatch() call
+	 *
+	 * Destination must hold Length bytes; with the arena overload it may be left null and is then
+	 * pointed into the arena. Succeeded is written by the batch.
+	 */
+	struct ReadRequest {
+		uintptr_t Address = 0;
+		size_t Length = 0;
+		void* Destination = nullptr;
+		bool Succeeded = false;
+
+		/// @brief Request that reads sizeof(T) bytes at address into out
+		template<typename T>
+		static ReadRequest Into(const uintptr_t address, T& out) {
+			static_assert(std::is_trivially_copyable_v<T>, "ReadRequest::Into needs a trivially copyable type");
+			return { address, sizeof(T), &out };
+		}
+	};
+
+	/**
+	 * @brief Bump allocator that receives the bytes of batched reads
+	 *
+	 * Memory comes from fixed blocks that are never moved, so pointers handed out stay valid until
+	 * Reset() or destruction. Reset() keeps the blocks for the next batch.
+	 */
+	class ReadArena {
+	public:
+		explicit ReadArena(size_t blockSize = 64 * 1024) : _BlockSize(blockSize) {}
+
+		/// @brief Returns size bytes aligned for any scalar type (a dedicated block if size exceeds the block size)
+		uint8_t* Allocate(size_t size);
+
+		/// @brief Releases every allocation at once; blocks are kept for reuse
+		void Reset() noexcept;
+
+		/// @brief Bytes handed out since the last Reset()
+		size_t BytesUsed() const noexcept { return _Used; }
+
+	private:
+		struct Block {
+			std::unique_ptr<uint8_t[]> Data;
+			size_t Size = 0;
+		};
+
+		std::vector<Block> _Blocks;
+		size_t _BlockSize;
+		size_t _Current = 0;    // block being filled
+		size_t _Offset = 0;     // fill level of the current block
+		size_t _Used = 0;
+	};
+
 	/**
 	 * @brief Comprehensive memory management system for runtime memory modification and inspection
 	 *
 	 * The MemoryManager class provides static utilities for creating, applying, and managing
 	 * memory patches and function detours. It supports organized modification management through
 	 * groups and types, along with various memory validation and inspection capabilities.
+	 *
+	 * Lookups by key or handle (ModExists, GetMod, ApplyMod, RestoreMod) read an immutable, hashed
+	 * snapshot of the mod table that every writer republishes through an atomic pointer. Old
+	 * snapshots are freed by epoch, so lookups never wait on ModsMutex and share no reference count.
 	 */
 	class MemoryManager
 	{
@@ -112,6 +201,58 @@ namespace ByteWeaver {
 		 */
 		static bool RestoreMod(const std::string& key);
 
+		/**
+		 * @brief Returns a handle for a registered modification
+		 * @param key Unique identifier of the modification
+		 * @return Handle, or an invalid handle if no modification has this key
+		 */
+		static ModHandle GetHandle(const std::string& key);
+
+		/**
+		 * @brief Retrieves a modification by handle
+		 * @param handle Handle from GetHandle()
+		 * @return Shared pointer to the modification, or nullptr if it was erased or replaced
+		 */
+		static auto GetMod(ModHandle handle) -> std::shared_ptr<MemoryModification>;
+
+		/**
+		 * @brief Applies a modification by handle
+		 * @param handle Handle from GetHandle()
+		 * @return true on success, false on failure or if the handle is stale
+		 */
+		static bool ApplyMod(ModHandle handle);
+
+		/**
+		 * @brief Restores a modification by handle
+		 * @param handle Handle from GetHandle()
+		 * @return true on success, false on failure or if the handle is stale
+		 */
+		static bool RestoreMod(ModHandle handle);
+
+		/**
+		 * @brief Snapshots the call counters of an instrumented hook
+		 * @param key Mod key of the hook (the Name given to DECLARE_HOOK_* / INSTALL_HOOK_*)
+		 * @return Counters, or std::nullopt if no hook under this key was built with BYTEWEAVER_ENABLE_HOOK_STATS
+		 */
+		static std::optional<HookStatsSnapshot> GetHookStats(const std::string& key);
+
+		/**
+		 * @brief Snapshots the call counters of every instrumented hook, sorted by key
+		 */
+		static std::vector<std::pair<std::string, HookStatsSnapshot>> GetAllHookStats();
+
+		/**
+		 * @brief Zeroes the call counters of an instrumented hook
+		 * @param key Mod key of the hook
+		 * @return false if no hook under this key is instrumented
+		 */
+		static bool ResetHookStats(const std::string& key);
+
+		/**
+		 * @brief Zeroes the call counters of every instrumented hook
+		 */
+		static void ResetAllHookStats();
+
 		/**
 		 * @brief Restores the original memory state and removes the modification from the manager
 		 * @param key Unique identifier of the modification
@@ -140,6 +281,66 @@ namespace ByteWeaver {
 		 */
 		static std::shared_ptr<Detour> CreateDetour(const std::string& key, uintptr_t targetAddress, PVOID* originalFunction, PVOID detourFunction, uint16_t groupID = 0x0000);
 
+		/**
+		 * @brief Creates and registers a near hook (5-byte rel32 jump, trampoline from TrampolinePool)
+		 * @param key Unique identifier for the hook
+		 * @param targetAddress Address of the function to hook
+		 * @param originalFunction Pointer to store the trampoline address
+		 * @param detourFunction Address of the replacement function
+		 * @param groupID Optional group identifier (default: 0x0000)
+		 * @return The hook, or the existing one if the key is already a near hook (nullptr otherwise)
+		 * @note Near hooks are applied one by one, after patches and before the detour transaction
+		 */
+		static std::shared_ptr<NearHook> CreateNearHook(const std::string& key, uintptr_t targetAddress, PVOID* originalFunction, PVOID detourFunction, uint16_t groupID = 0x0000);
+
+		/**
+		 * @brief Creates and registers a mid-function hook
+		 * @param key Unique identifier for the hook
+		 * @param targetAddress Address of the instruction to hook
+		 * @param callback Function called with the registers at the target; must not throw (see MidHook)
+		 * @param liveRegisters Registers to save, expose and restore around the call
+		 * @param groupID Optional group identifier (default: 0x0000)
+		 * @return The hook, or the existing one if the key is already a mid hook (nullptr otherwise)
+		 */
+		static std::shared_ptr<MidHook> CreateMidHook(const std::string& key, uintptr_t targetAddress, MidHookCallback callback,
+		                                              RegisterMask liveRegisters = Registers::Volatile, uint16_t groupID = 0x0000);
+
+		/**
+		 * @brief Registers a patch and returns a handle to it instead of a shared_ptr
+		 * @param key Unique identifier for the patch
+		 * @param patchAddress Memory address to patch
+		 * @param patchBytes Byte sequence to write at the address
+		 * @param groupID Optional group identifier (default: 0x0000)
+		 * @return Handle to the patch, to the existing one if the key is already a patch, invalid otherwise
+		 * @note The patch and its bytes are allocated in one ModArena cell (bytes inline up to
+		 *       ModBytes::InlineCapacity), and no shared_ptr is handed out; use the handle overloads
+		 *       of ApplyMod() / RestoreMod() / GetMod().
+		 */
+		static ModHandle RegisterPatch(const std::string& key, uintptr_t patchAddress, std::span<const uint8_t> patchBytes, uint16_t groupID = 0x0000);
+
+		/**
+		 * @brief Registers a detour and returns a handle to it instead of a shared_ptr
+		 * @param key Unique identifier for the detour
+		 * @param targetAddress Address of the function to detour
+		 * @param originalFunction Pointer to store the original function address
+		 * @param detourFunction Address of the replacement function
+		 * @param groupID Optional group identifier (default: 0x0000)
+		 * @return Handle to the detour, to the existing one if the key is already a detour, invalid otherwise
+		 */
+		static ModHandle RegisterDetour(const std::string& key, uintptr_t targetAddress, PVOID* originalFunction, PVOID detourFunction, uint16_t groupID = 0x0000);
+
+		/**
+		 * @brief Creates every hook of a descriptor table in one batch
+		 * @param hooks Table of HOOK_ADDRESS / HOOK_SYMBOL / HOOK_DEFERRED descriptors (see HookDescriptor)
+		 * @param failedNames Receives the names of hooks that were not created or deferred; may be nullptr
+		 * @return Number of hooks created, deferred ones included
+		 * @note Symbols are resolved with one AddressDB::FindBatch() and all hooks are registered under
+		 *       one lock with one snapshot rebuild, instead of one of each per hook. Nothing is applied:
+		 *       follow with ApplyAllMods() or ApplyByGroupID() to apply the table in one transaction.
+		 *       Deferred hooks are handed to DeferredLoader and apply when their module loads.
+		 */
+		static size_t InstallHooks(std::span<const HookDescriptor> hooks, std::vector<std::string_view>* failedNames = nullptr);
+
 		/**
 		 * @brief Retrieves all registered memory modifications
 		 * @return Vector of all modification objects
@@ -149,9 +350,18 @@ namespace ByteWeaver {
 		/**
 		 * @brief Applies all registered memory modifications
 		 * @return true if all modifications applied successfully, false otherwise
+		 * @note All detours are committed in one transaction (see Detour::ApplyBatch); if one fails, none is applied
 		 */
 		static bool ApplyAllMods();
 
+		/**
+		 * @brief Applies the modifications registered under keys, batched like ApplyAllMods()
+		 * @param keys Keys of the modifications to apply
+		 * @param failedKeys Receives the keys that did not apply, or are not registered; may be nullptr
+		 * @return true if every modification applied successfully
+		 */
+		static bool ApplyMods(std::span<const std::string> keys, std::vector<std::string>* failedKeys = nullptr);
+
 		/**
 		 * @brief Restores all memory modifications to their original state
 		 * @return true if all modifications restored successfully, false otherwise
@@ -178,16 +388,20 @@ namespace ByteWeaver {
 		/**
 		 * @brief Applies all modifications in a specific group
 		 * @param groupID Group identifier
+		 * @param failedKeys Receives the keys of modifications that did not apply; may be nullptr
 		 * @return true if all group modifications applied successfully
+		 * @note The group's detours are committed in one transaction (see Detour::ApplyBatch) and
+		 *       its patches are written in page runs (see Patch::ApplyBatch)
 		 */
-		static bool ApplyByGroupID(uint16_t groupID);
+		static bool ApplyByGroupID(uint16_t groupID, std::vector<std::string>* failedKeys = nullptr);
 
 		/**
 		 * @brief Restores all modifications in a specific group
 		 * @param groupID Group identifier
+		 * @param failedKeys Receives the keys of modifications that did not restore; may be nullptr
 		 * @return true if all group modifications restored successfully
 		 */
-		static bool RestoreByGroupID(uint16_t groupID);
+		static bool RestoreByGroupID(uint16_t groupID, std::vector<std::string>* failedKeys = nullptr);
 
 		/**
 		 * @brief Removes all modifications in a specific group from the manager
@@ -211,16 +425,20 @@ namespace ByteWeaver {
 		/**
 		 * @brief Applies all modifications of a specific type
 		 * @param modType Type of modifications to apply
+		 * @param failedKeys Receives the keys of modifications that did not apply; may be nullptr
 		 * @return true if all type modifications applied successfully
+		 * @note Detours are committed in one transaction (see Detour::ApplyBatch) and patches
+		 *       are written in page runs (see Patch::ApplyBatch)
 		 */
-		static bool ApplyByType(ModType modType);
+		static bool ApplyByType(ModType modType, std::vector<std::string>* failedKeys = nullptr);
 
 		/**
 		 * @brief Restores all modifications of a specific type
 		 * @param modType Type of modifications to restore
+		 * @param failedKeys Receives the keys of modifications that did not restore; may be nullptr
 		 * @return true if all type modifications restored successfully
 		 */
-		static bool RestoreByType(ModType modType);
+		static bool RestoreByType(ModType modType, std::vector<std::string>* failedKeys = nullptr);
 
 		/**
 		 * @brief Removes all modifications of a specific type from the manager
@@ -246,6 +464,16 @@ namespace ByteWeaver {
 		 */
 		static bool IsLocationModified(uintptr_t address, size_t length, std::vector<std::string>* detectedKeys);
 
+		/**
+		 * @brief Finds the applied modification that covers an address
+		 * @param address Address to look up
+		 * @param outKey Optional output parameter to receive the key of the modification
+		 * @return The modification, or nullptr if no applied modification covers the address
+		 * @note Like IsLocationModified(), this is a binary search over an address-ordered index
+		 *       of registered modifications rather than a walk over every mod
+		 */
+		static auto FindModAt(uintptr_t address, std::string* outKey = nullptr) -> std::shared_ptr<MemoryModification>;
+
 		/**
 		 * @brief Validates if a memory address is accessible
 		 * @param address Memory address to validate
@@ -258,6 +486,7 @@ namespace ByteWeaver {
 		 * @param address Starting address of the range
 		 * @param length Size of the range in bytes
 		 * @return true if range is valid, false otherwise
+		 * @note With RegionMap enabled this and the other validators are answered from its snapshot
 		 */
 		static bool IsMemoryRangeValid(uintptr_t address, size_t length);
 
@@ -356,6 +585,7 @@ namespace ByteWeaver {
 		 * @param address Memory address of the buffer
 		 * @param length Size of the buffer in bytes
 		 * @param outPath Output file path
+		 * @note Writes in one blocking call; use ModuleDumper to stream a whole module
 		 */
 		static void WriteBufferToFile(uintptr_t address, size_t length, const fs::path& outPath);
 
@@ -367,6 +597,15 @@ namespace ByteWeaver {
 		 */
 		static void WriteBufferToFile(const char* buffer, size_t length, const fs::path& outPath);
 
+		/**
+		 * @brief Validates a range and returns a view of it without copying
+		 * @param address Memory address to read from
+		 * @param size Number of bytes to view
+		 * @return View of the live bytes, or an empty span if the range is not readable
+		 * @note The view is only checked once; it stays valid while the memory stays committed
+		 */
+		static std::span<const uint8_t> ReadSpanSafe(uintptr_t address, size_t size);
+
 		/**
 		 * @brief Safely reads a sequence of bytes from memory
 		 * @param address Memory address to read from
@@ -375,6 +614,57 @@ namespace ByteWeaver {
 		 */
 		static std::vector<uint8_t> ReadBytesSafe(uintptr_t address, size_t size);
 
+		/**
+		 * @brief Performs many reads under a single exception frame
+		 * @param requests Reads to perform; each one's Succeeded flag is set
+		 * @return Number of reads that succeeded
+		 * @note Addresses are not queried first: a faulting read is caught, marked failed, and the
+		 *       batch resumes with the next one. Null, empty and destination-less requests fail.
+		 */
+		static size_t ReadBatch(std::span<ReadRequest> requests);
+
+		/**
+		 * @brief Performs many reads under a single exception frame, into an arena where asked
+		 * @param requests Reads to perform; requests without a Destination are given arena memory
+		 * @param arena Arena that receives those reads
+		 * @return Number of reads that succeeded
+		 */
+		static size_t ReadBatch(std::span<ReadRequest> requests, ReadArena& arena);
+
+		/**
+		 * @brief Follows a pointer chain: [[base + o0] + o1] ... + oN
+		 * @param base Address of the first pointer (before its offset)
+		 * @param offsets Offsets added at each level; every one but the last is dereferenced
+		 * @return Final address, or 0 if a pointer was null or a read faulted
+		 * @note The whole walk runs under one exception frame
+		 *
+		 * ### Example:
+		 * ```cpp
+		 * constexpr std::array<ptrdiff_t, 3> healthChain{ 0x1C8, 0x30, 0x94 };
+		 * const auto health = MemoryManager::ReadPointerChain<float>(playerBase, healthChain);
+		 * ```
+		 */
+		static uintptr_t ResolvePointerChain(uintptr_t base, std::span<const ptrdiff_t> offsets);
+
+		/**
+		 * @brief Follows a pointer chain and reads length bytes at its end, under one exception frame
+		 * @return true if every pointer was readable and non-null and the final read succeeded
+		 */
+		static bool ReadPointerChain(uintptr_t base, std::span<const ptrdiff_t> offsets, void* destination, size_t length);
+
+		/**
+		 * @brief Typed form of ReadPointerChain()
+		 * @return Value at the end of the chain, or std::nullopt if the walk failed
+		 */
+		template<typename T>
+		static std::optional<T> ReadPointerChain(const uintptr_t base, const std::span<const ptrdiff_t> offsets) {
+			static_assert(std::is_trivially_copyable_v<T>, "ReadPointerChain needs a trivially copyable type");
+			T value{};
+			if (!ReadPointerChain(base, offsets, &value, sizeof(T)))
+				return std::nullopt;
+			return value;
+		}
+
 		/**
 		 * @brief Converts byte data to hexadecimal string representation
 		 * @param data Vector of bytes to convert
@@ -7,6 +7,7 @@
 #endif
 
 #include <ByteWeaverPCH.h>
+#include <ModBytes.h>
 
 namespace ByteWeaver
 {
@@ -20,6 +21,8 @@ namespace ByteWeaver
         Detour,      ///< Function detouring/hooking modification
         Patch,       ///< Binary patching modification
         Module,
+        NearHook,    ///< rel32 hook with a pooled trampoline (see NearHook)
+        MidHook,     ///< Callback at an instruction inside a function (see MidHook)
         Unspecified = 0xFF  ///< Default/unknown modification type
     };
 
@@ -119,11 +122,12 @@ namespace ByteWeaver
         /**
          * @brief Storage for the original bytes at the target address.
          *
-         * This vector preserves the original memory contents before modification,
+         * This buffer preserves the original memory contents before modification,
          * enabling restoration to the original state. Derived classes should
          * populate this during construction or before applying modifications.
+         * Up to ModBytes::InlineCapacity bytes are stored inside the object.
          */
-        std::vector<uint8_t> OriginalBytes{};
+        ModBytes OriginalBytes{};
 
         /**
          * @brief The size in bytes of the memory region being modified.
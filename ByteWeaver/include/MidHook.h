@@ -0,0 +1,140 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include <ByteWeaverPCH.h>
+#include <InlineHook.h>
+
+namespace ByteWeaver {
+
+    /// @brief Set of registers a MidHook saves, exposes to its callback and restores
+    using RegisterMask = uint64_t;
+
+    namespace Registers {
+        /// @brief General register by encoding number (0 = rax/eax ... 15 = r15)
+        constexpr RegisterMask Gp(const unsigned index) { return 1ull << index; }
+
+        /// @brief SSE register xmm<index>
+        constexpr RegisterMask Xmm(const unsigned index) { return 1ull << (32 + index); }
+
+        constexpr RegisterMask Flags = 1ull << 16;
+
+        #if defined(_WIN64)
+            constexpr size_t GpCount = 16;
+            constexpr size_t XmmCount = 16;
+
+            constexpr RegisterMask Rax = Gp(0), Rcx = Gp(1), Rdx = Gp(2), Rbx = Gp(3), Rbp = Gp(5), Rsi = Gp(6), Rdi = Gp(7);
+            constexpr RegisterMask R8 = Gp(8), R9 = Gp(9), R10 = Gp(10), R11 = Gp(11), R12 = Gp(12), R13 = Gp(13), R14 = Gp(14), R15 = Gp(15);
+
+            /// @brief What the callback may clobber under the x64 calling convention
+            constexpr RegisterMask Volatile = Rax | Rcx | Rdx | R8 | R9 | R10 | R11 | Flags |
+                Xmm(0) | Xmm(1) | Xmm(2) | Xmm(3) | Xmm(4) | Xmm(5);
+        #else
+            constexpr size_t GpCount = 8;
+            constexpr size_t XmmCount = 8;
+
+            constexpr RegisterMask Eax = Gp(0), Ecx = Gp(1), Edx = Gp(2), Ebx = Gp(3), Ebp = Gp(5), Esi = Gp(6), Edi = Gp(7);
+
+            /// @brief What the callback may clobber under __cdecl
+            constexpr RegisterMask Volatile = Eax | Ecx | Edx | Flags |
+                Xmm(0) | Xmm(1) | Xmm(2) | Xmm(3) | Xmm(4) | Xmm(5) | Xmm(6) | Xmm(7);
+        #endif
+
+        /// @brief Every register a MidHook can save
+        constexpr RegisterMask All = ((1ull << GpCount) - 1) | Flags | (((1ull << XmmCount) - 1) << 32);
+    }
+
+    /**
+     * @brief Registers at the hooked instruction, as seen (and written) by a MidHook callback.
+     *
+     * Only the registers declared live hold their value; the others are left uninitialized and
+     * whatever the callback stores in them is dropped. The stack pointer is always filled in and
+     * is read-only.
+     */
+    struct MidHookContext {
+        union XmmRegister {
+            float F32[4];
+            double F64[2];
+            uint32_t U32[4];
+            uint64_t U64[2];
+        };
+
+        // In encoding order, so Registers::Gp(i) is field i
+        #if defined(_WIN64)
+            uintptr_t Rax, Rcx, Rdx, Rbx, Rsp, Rbp, Rsi, Rdi;
+            uintptr_t R8, R9, R10, R11, R12, R13, R14, R15;
+            uintptr_t Flags;
+            uintptr_t Reserved;
+        #else
+            uintptr_t Eax, Ecx, Edx, Ebx, Esp, Ebp, Esi, Edi;
+            uintptr_t Flags;
+            uintptr_t Reserved[3];
+        #endif
+        XmmRegister Xmm[Registers::XmmCount];
+    };
+
+    using MidHookCallback = void (__cdecl*)(MidHookContext& context);
+
+    /**
+     * @brief Calls a function at one instruction inside a function, then resumes there.
+     *
+     * A 5-byte jump at the target leads to a stub in a TrampolinePool slot that saves only the
+     * declared live registers into a MidHookContext on the stack, calls the callback with it,
+     * loads the (possibly changed) registers back and runs the overwritten instructions,
+     * relocated as described in InlineHook, before jumping back. That is a few dozen instructions,
+     * against a full detour through DECLARE_HOOK_* thunks, and needs no hand-written Patch bytes.
+     *
+     * Live registers are the ones whose value must survive the hook: everything the callback
+     * may clobber that the code after the target still needs (Registers::Volatile when in doubt),
+     * plus any register the callback reads or writes.
+     *
+     * @warning The overwritten instructions (all that start within five bytes of the target) must
+     *          not be branched to from elsewhere, except the first: a loop jumping back into the
+     *          middle of them would run the jump's bytes.
+     * @warning The callback must not throw, nor let an SEH exception escape: the stub has no unwind
+     *          info, so an exception cannot be unwound through it and takes the process down.
+     *
+     * ### Example:
+     * ```cpp
+     * // Clamp the value in ecx at a known instruction of a hot loop
+     * static void ClampCount(MidHookContext& context) {
+     *     context.Rcx = std::min<uintptr_t>(context.Rcx & 0xFFFFFFFF, 100);
+     * }
+     *
+     * MemoryManager::CreateMidHook("ClampCount", base + 0x1A2B, &ClampCount, Registers::Volatile);
+     * MemoryManager::ApplyMod("ClampCount");
+     * ```
+     *
+     * @note This class is final and cannot be inherited from.
+     * @see InlineHook, NearHook
+     */
+    class MidHook final : public InlineHook {
+    public:
+        /// @brief Function called with the registers at the target
+        MidHookCallback Callback;
+
+        /// @brief Registers saved, exposed and restored around the call; fixed at construction (it sizes the stub)
+        const RegisterMask LiveRegisters;
+
+        /**
+         * @brief Constructs a mid-function hook; decodes the instructions under the jump.
+         *
+         * @param targetAddress Address of the instruction to hook
+         * @param callback Function to call with the registers at the target
+         * @param liveRegisters Registers to save, expose and restore (the stack pointer is always exposed)
+         */
+        MidHook(uintptr_t targetAddress, MidHookCallback callback, RegisterMask liveRegisters = Registers::Volatile);
+
+        /**
+         * @brief Builds the stub and writes the jump over the target.
+         * @return true if the hook is live
+         */
+        bool Apply() override;
+
+        /// @brief Bytes of stub code generated for a set of live registers
+        static size_t StubSize(RegisterMask liveRegisters);
+
+    protected:
+        std::optional<size_t> WriteEntry(uint8_t* slot, uintptr_t& entry) override;
+    };
+}
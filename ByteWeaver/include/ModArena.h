@@ -0,0 +1,77 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include <ByteWeaverPCH.h>
+
+namespace ByteWeaver {
+
+    /**
+     * @brief Pooled storage for MemoryManager's modification objects.
+     *
+     * Blocks are carved into fixed size classes (multiples of CellSize), so modifications created
+     * together sit next to each other instead of wherever the general heap puts them. MakeShared()
+     * allocates the shared_ptr control block and the object as one cell, and with the object's
+     * byte buffers stored inline (see ModBytes) a typical Patch or Detour is a single cell. Bulk
+     * walks over the mods then touch a few dense blocks rather than scattered heap lines.
+     *
+     * Freed cells go back to their size class's free list. Blocks are never released: the store
+     * lives for the whole process, so mods destroyed during static teardown can still free their
+     * cells. Requests larger than MaxCellSize fall back to operator new.
+     *
+     * ### Example:
+     * ```cpp
+     * std::shared_ptr<Patch> patch = ModArena::MakeShared<Patch>(address, bytes);
+     * ```
+     */
+    class ModArena {
+    public:
+        /// @brief Granularity of the size classes, one cache line
+        static constexpr size_t CellSize = 64;
+
+        /// @brief Largest pooled allocation
+        static constexpr size_t MaxCellSize = 1024;
+
+        /// @brief Bytes reserved per block
+        static constexpr size_t BlockSize = 64 * 1024;
+
+        /// @brief Returns size bytes aligned to CellSize (or to alignment if larger, then unpooled)
+        static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        /// @brief Returns memory from Allocate(); size and alignment must match the request
+        static void Free(void* pointer, size_t size, size_t alignment = alignof(std::max_align_t)) noexcept;
+
+        /// @brief Bytes of blocks reserved so far
+        static size_t BytesReserved();
+
+        /// @brief Bytes of cells currently handed out
+        static size_t BytesInUse();
+
+        /// @brief Standard allocator over the arena, for std::allocate_shared
+        template <typename T>
+        struct Allocator {
+            using value_type = T;
+
+            Allocator() noexcept = default;
+            template <typename U>
+            Allocator(const Allocator<U>&) noexcept {}
+
+            T* allocate(const size_t count) {
+                return static_cast<T*>(ModArena::Allocate(count * sizeof(T), alignof(T)));
+            }
+
+            void deallocate(T* pointer, const size_t count) noexcept {
+                ModArena::Free(pointer, count * sizeof(T), alignof(T));
+            }
+
+            template <typename U>
+            bool operator==(const Allocator<U>&) const noexcept { return true; }
+        };
+
+        /// @brief std::make_shared with the object and its control block in one arena cell
+        template <typename T, typename... Args>
+        static std::shared_ptr<T> MakeShared(Args&&... args) {
+            return std::allocate_shared<T>(Allocator<T>{}, std::forward<Args>(args)...);
+        }
+    };
+}
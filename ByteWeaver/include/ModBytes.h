@@ -0,0 +1,153 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include <ByteWeaverPCH.h>
+
+namespace ByteWeaver {
+
+    /**
+     * @brief Byte buffer of a MemoryModification, stored inline up to InlineCapacity bytes.
+     *
+     * Most patches and detour prologues are a handful of bytes, so OriginalBytes and PatchBytes keep
+     * them inside the modification object instead of in a separate heap block; only longer buffers
+     * are allocated. The interface is the part of std::vector<uint8_t> the modifications use, and it
+     * converts to and from std::vector<uint8_t> so existing callers keep compiling.
+     *
+     * ### Example:
+     * ```cpp
+     * ModBytes bytes = { 0x90, 0x90, 0x90 };     // inline, no allocation
+     * bytes.resize(64);                          // moves to the heap, new bytes zeroed
+     * std::vector<uint8_t> copy = bytes;         // compatibility conversion
+     * ```
+     */
+    class ModBytes {
+    public:
+        /// @brief Largest buffer stored without an allocation
+        static constexpr size_t InlineCapacity = 16;
+
+        ModBytes() noexcept = default;
+
+        ModBytes(const uint8_t* bytes, const size_t size) {
+            uint8_t* data = Allocate(size);
+            if (size)
+                memcpy(data, bytes, size);
+        }
+
+        ModBytes(const std::vector<uint8_t>& bytes) : ModBytes(bytes.data(), bytes.size()) {}
+        ModBytes(const std::span<const uint8_t> bytes) : ModBytes(bytes.data(), bytes.size()) {}
+        ModBytes(const std::initializer_list<uint8_t> bytes) : ModBytes(bytes.begin(), bytes.size()) {}
+
+        ModBytes(const ModBytes& other) : ModBytes(other.data(), other.size()) {}
+
+        ModBytes(ModBytes&& other) noexcept : _Size(other._Size) {
+            if (IsInline())
+                memcpy(_Inline, other._Inline, _Size);
+            else
+                _Heap = std::exchange(other._Heap, nullptr);
+            other._Size = 0;
+        }
+
+        ModBytes& operator=(const ModBytes& other) {
+            if (this != &other)
+                assign(other.data(), other.size());
+            return *this;
+        }
+
+        ModBytes& operator=(ModBytes&& other) noexcept {
+            if (this != &other) {
+                Release();
+                _Size = other._Size;
+                if (IsInline())
+                    memcpy(_Inline, other._Inline, _Size);
+                else
+                    _Heap = std::exchange(other._Heap, nullptr);
+                other._Size = 0;
+            }
+            return *this;
+        }
+
+        ~ModBytes() { Release(); }
+
+        /// @brief Compatibility with the former std::vector<uint8_t> members
+        operator std::vector<uint8_t>() const { return { begin(), end() }; }
+
+        std::span<const uint8_t> Span() const noexcept { return { data(), _Size }; }
+
+        uint8_t* data() noexcept { return IsInline() ? _Inline : _Heap; }
+        const uint8_t* data() const noexcept { return IsInline() ? _Inline : _Heap; }
+        size_t size() const noexcept { return _Size; }
+        bool empty() const noexcept { return _Size == 0; }
+
+        uint8_t* begin() noexcept { return data(); }
+        uint8_t* end() noexcept { return data() + _Size; }
+        const uint8_t* begin() const noexcept { return data(); }
+        const uint8_t* end() const noexcept { return data() + _Size; }
+
+        uint8_t& operator[](const size_t index) noexcept { return data()[index]; }
+        const uint8_t& operator[](const size_t index) const noexcept { return data()[index]; }
+
+        /// @brief Returns true if the bytes live inside the object
+        bool IsInline() const noexcept { return _Size <= InlineCapacity; }
+
+        /// @brief Resizes to size bytes, keeping the common prefix and zeroing the rest
+        void resize(const size_t size) {
+            if (size == _Size)
+                return;
+            ModBytes resized;
+            uint8_t* data = resized.Allocate(size);
+            const size_t kept = (std::min)(size, _Size);
+            if (kept)
+                memcpy(data, this->data(), kept);
+            memset(data + kept, 0, size - kept);
+            *this = std::move(resized);
+        }
+
+        /// @brief Replaces the contents with count copies of value
+        void assign(const size_t count, const uint8_t value) {
+            if (count != _Size) {
+                Release();
+                Allocate(count);
+            }
+            memset(data(), value, count);
+        }
+
+        /// @brief Replaces the contents with a copy of size bytes, which may point into this buffer
+        void assign(const uint8_t* bytes, const size_t size) {
+            if (size == _Size) {
+                if (size)
+                    memmove(data(), bytes, size);
+                return;
+            }
+            // Copied before the old storage is released: bytes may live in it
+            *this = ModBytes(bytes, size);
+        }
+
+        void clear() noexcept { Release(); }
+
+        friend bool operator==(const ModBytes& a, const ModBytes& b) noexcept {
+            return a._Size == b._Size && (a._Size == 0 || memcmp(a.data(), b.data(), a._Size) == 0);
+        }
+
+    private:
+        size_t _Size = 0;
+        union {
+            uint8_t _Inline[InlineCapacity];
+            uint8_t* _Heap;
+        };
+
+        // Sets the size of an empty buffer and returns its storage (uninitialized)
+        uint8_t* Allocate(const size_t size) {
+            if (size > InlineCapacity)
+                _Heap = new uint8_t[size];
+            _Size = size;
+            return data();
+        }
+
+        void Release() noexcept {
+            if (!IsInline())
+                delete[] _Heap;
+            _Size = 0;
+        }
+    };
+}
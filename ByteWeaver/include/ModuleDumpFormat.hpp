@@ -0,0 +1,61 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+// Shared by the dumper and the offline readers, so it only depends on the STD lib.
+#include <cstdint>
+
+/**
+ * Module dump written by ByteWeaver::ModuleDumper.
+ *
+ * A file starts with a FileHeader, followed by the module name (NameLength UTF-16 code units) and
+ * SectionCount SectionRecords. Chunks follow, each a ChunkHeader and StoredSize bytes of payload:
+ *  - ChunkFlags::Compressed  the payload is one LZ4 block (see BlockCodec) of RawSize bytes;
+ *  - ChunkFlags::Unreadable  RawSize bytes at Rva were not committed or faulted; no payload;
+ *  - otherwise the payload is the RawSize bytes at Rva as they are.
+ * The PE headers are the first chunk (Rva 0), so the identity can be read back from the image
+ * itself. A ChunkHeader with ChunkFlags::End closes the file; a dump without one is truncated.
+ *
+ * Chunks are not ordered: the image is rebuilt by placing each one at its Rva in a zeroed
+ * buffer of SizeOfImage bytes (see ModuleDump::Load).
+ */
+namespace ByteWeaver::ModuleDumpFormat {
+
+    inline constexpr char Magic[8] = { 'B', 'W', 'D', 'U', 'M', 'P', '\r', '\n' };
+    inline constexpr uint32_t Version = 1;
+
+    #pragma pack(push, 1)
+    struct FileHeader {
+        char Magic[8];
+        uint32_t Version;
+        uint32_t TimeDateStamp;     ///< ModuleIdentity of the dumped image
+        uint32_t CheckSum;
+        uint32_t SizeOfImage;
+        uint64_t ImageBase;         ///< Where the module was loaded when dumped
+        uint32_t NameLength;        ///< UTF-16 code units following the header
+        uint32_t SectionCount;      ///< SectionRecords following the name
+        uint32_t ChunkSize;         ///< Largest RawSize of a chunk
+        uint32_t Reserved;
+    };
+
+    struct SectionRecord {
+        char Name[8];
+        uint32_t Rva;
+        uint32_t Size;
+        uint32_t Characteristics;
+    };
+
+    struct ChunkHeader {
+        uint32_t Rva;
+        uint32_t RawSize;
+        uint32_t StoredSize;
+        uint32_t Flags;
+    };
+    #pragma pack(pop)
+
+    namespace ChunkFlags {
+        inline constexpr uint32_t Compressed = 0x1;
+        inline constexpr uint32_t Unreadable = 0x2;
+        inline constexpr uint32_t End = 0x80000000;
+    }
+}
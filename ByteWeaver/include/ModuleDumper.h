@@ -0,0 +1,109 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include <ByteWeaverPCH.h>
+#include <ModuleRegistry.h>
+#include <SignatureCache.h>
+
+namespace ByteWeaver {
+
+    /**
+     * @brief Settings of a ModuleDumper::Dump() call.
+     */
+    struct DumpOptions {
+        /// @brief Bytes read, compressed and written at a time
+        size_t ChunkSize = 1024 * 1024;
+
+        /// @brief Chunks read ahead of the compressor; bounds the memory of a dump to about twice this many chunks
+        size_t ChunksInFlight = 4;
+
+        /// @brief LZ4-compress chunks (chunks that do not shrink are stored as they are)
+        bool Compress = true;
+    };
+
+    /**
+     * @brief Outcome of a ModuleDumper::Dump() call.
+     */
+    struct DumpResult {
+        bool Succeeded = false;
+
+        /// @brief Bytes of the image copied into the dump
+        uint64_t RawBytes = 0;
+
+        /// @brief Bytes of chunk payload written
+        uint64_t StoredBytes = 0;
+
+        /// @brief Chunks written, and how many of them could not be read
+        size_t Chunks = 0;
+        size_t UnreadableChunks = 0;
+
+        /// @brief Bytes of applied mods that were written with their original contents
+        size_t RestoredBytes = 0;
+    };
+
+    /**
+     * @brief Streams the image of a loaded module to a dump file.
+     *
+     * The whole image (headers, sections and the padding between them) is walked region by region:
+     * ranges that are not committed are recorded as unreadable without touching them, and the rest
+     * is copied in guarded chunks, so a page that faults only costs its own chunk (it is retried
+     * page by page). The calling thread reads; a worker compresses each chunk (BlockCodec) and
+     * writes it with overlapped I/O while the next ones are read. At most
+     * DumpOptions::ChunksInFlight chunks wait for the worker, so dumping a large module needs a
+     * few megabytes rather than a copy of the image.
+     *
+     * Mods applied through MemoryManager when the dump starts are written with their OriginalBytes,
+     * so hooks and patches do not end up in the dump (the live module is not touched).
+     *
+     * The file starts with the module's identity, name and section table (see ModuleDumpFormat.hpp)
+     * and is read back with ModuleDump::Load(), which rebuilds the image for offline scanning.
+     *
+     * ### Example:
+     * ```cpp
+     * const DumpResult result = ModuleDumper::Dump(L"Game.exe", "Game.bwdump");
+     * if (result.Succeeded)
+     *     Info("Dumped %llu bytes into %llu", result.RawBytes, result.StoredBytes);
+     * ```
+     */
+    class ModuleDumper {
+    public:
+        /**
+         * @brief Dumps a loaded module.
+         * @param moduleName Module name as accepted by ModuleRegistry::Find()
+         * @param outPath File to create (replaced if it exists)
+         * @param options Chunking and compression settings
+         * @return Statistics; Succeeded is false if the module is not loaded or the file could not be written
+         */
+        static DumpResult Dump(const std::wstring& moduleName, const fs::path& outPath, const DumpOptions& options = {});
+
+        /// @brief Dumps a module already looked up in ModuleRegistry
+        static DumpResult Dump(const LoadedModule& module, const fs::path& outPath, const DumpOptions& options = {});
+    };
+
+    /**
+     * @brief A module dump read back into memory.
+     *
+     * Image holds SizeOfImage bytes with every chunk at its Rva; unreadable ranges are zero and listed
+     * in Unreadable. Scanners see the same layout as the live module, so offsets found in Image are
+     * module offsets.
+     */
+    struct ModuleDump {
+        std::wstring Name;
+        ModuleIdentity Identity{};
+        uint64_t ImageBase = 0;
+        std::vector<ModuleSection> Sections;
+        std::vector<uint8_t> Image;
+
+        /// @brief Ranges of the image (Rva, size) the dumper could not read
+        std::vector<std::pair<uint32_t, uint32_t>> Unreadable;
+
+        /**
+         * @brief Reads a dump written by ModuleDumper.
+         * @param path Dump file
+         * @param error Receives why the file was rejected; may be nullptr
+         * @return The dump, or std::nullopt if the file is missing, truncated or corrupt
+         */
+        static std::optional<ModuleDump> Load(const fs::path& path, std::string* error = nullptr);
+    };
+}
@@ -0,0 +1,164 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include <ByteWeaverPCH.h>
+#include <ExportIndex.h>
+#include <SignatureCache.h>
+
+namespace ByteWeaver {
+
+    /**
+     * @brief One section header of a loaded module.
+     */
+    struct ModuleSection {
+        /// @brief Section name (up to 8 characters, e.g. ".text")
+        std::string Name;
+
+        /// @brief Offset of the section from the module base
+        uint32_t Rva = 0;
+
+        /// @brief Mapped size (VirtualSize, or SizeOfRawData when the linker left it zero)
+        uint32_t Size = 0;
+
+        /// @brief IMAGE_SCN_* flags
+        uint32_t Characteristics = 0;
+    };
+
+    /**
+     * @brief Header data of a loaded module, parsed once when it is registered.
+     */
+    struct LoadedModule {
+        /// @brief File name as the loader reports it (e.g. L"lua51.dll")
+        std::wstring Name;
+
+        /// @brief Full path of the image
+        std::wstring Path;
+
+        /// @brief Module base (HMODULE)
+        uint8_t* Base = nullptr;
+
+        /// @brief SizeOfImage
+        size_t Size = 0;
+
+        /// @brief Build identity from the PE headers
+        ModuleIdentity Identity{};
+
+        /// @brief Section table
+        std::vector<ModuleSection> Sections;
+
+        /// @brief Export directory RVA and size (zero if the module exports nothing)
+        uint32_t ExportRva = 0;
+        uint32_t ExportSize = 0;
+
+        /// @brief Returns true if address lies inside [Base, Base + Size)
+        bool Contains(const uintptr_t address) const noexcept {
+            return address >= reinterpret_cast<uintptr_t>(Base) && address - reinterpret_cast<uintptr_t>(Base) < Size;
+        }
+
+        /// @brief Returns the section containing rva, or nullptr
+        const ModuleSection* SectionAt(uint32_t rva) const noexcept;
+
+        /// @brief Returns the shared export index of the module (built on first use)
+        std::shared_ptr<const ExportIndex> Exports() const { return ExportIndex::Get(Base); }
+    };
+
+    /**
+     * @brief Process-wide cache of loaded modules.
+     *
+     * Seeded from the PEB loader list on first use and kept current through loader
+     * notifications (LdrRegisterDllNotification), so module lookups by name or address
+     * no longer call into the loader or re-parse PE headers. Unloading a module also
+     * drops its ExportIndex.
+     *
+     * Lookups by name are case-insensitive and accept names without extension
+     * ("kernel32"). A name that is not registered falls back to GetModuleHandleW once,
+     * which also covers full paths.
+     *
+     * ### Example:
+     * ```cpp
+     * if (auto lua = ModuleRegistry::Find(L"lua51.dll")) {
+     *     Debug("lua51 at " ADDR_FMT " (%zu bytes)", reinterpret_cast<uintptr_t>(lua->Base), lua->Size);
+     *     auto pcall = lua->Exports()->FindByName("lua_pcall");
+     * }
+     * ```
+     *
+     * @note Returned modules are immutable snapshots; they stay valid after an unload but
+     *       their Base no longer points to mapped memory
+     */
+    class ModuleRegistry {
+    public:
+        using ModulePtr = std::shared_ptr<const LoadedModule>;
+
+        /**
+         * @brief Called when a module is registered (loaded = true) or unloaded (loaded = false).
+         *
+         * Listeners run inside the loader notification, i.e. under the loader lock: they must
+         * not load libraries, wait on other threads or take locks held across loader calls.
+         */
+        using ModuleListener = std::function<void(const ModulePtr& module, bool loaded)>;
+
+        /**
+         * @brief Finds a loaded module by name.
+         *
+         * @param moduleName Module file name; nullptr or empty returns the main executable
+         * @return Module, or nullptr if it is not loaded
+         */
+        static ModulePtr Find(const wchar_t* moduleName);
+        static ModulePtr Find(const std::wstring& moduleName) { return Find(moduleName.c_str()); }
+
+        /**
+         * @brief Finds the loaded module containing an address.
+         *
+         * @return Module, or nullptr if the address is not inside a loaded image
+         */
+        static ModulePtr FindByAddress(uintptr_t address);
+
+        /**
+         * @brief Returns every registered module, ordered by base address.
+         */
+        static std::vector<ModulePtr> Snapshot();
+
+        /**
+         * @brief Rebuilds the registry from the PEB loader list.
+         */
+        static void Refresh();
+
+        /**
+         * @brief Registers for loader notifications (idempotent; done implicitly by every lookup).
+         */
+        static void StartWatching();
+
+        /**
+         * @brief Counter bumped whenever a module is added or removed.
+         */
+        static uint64_t Generation();
+
+        /**
+         * @brief Returns true if moduleName refers to module (same rules as Find()).
+         */
+        static bool NameMatches(std::wstring_view moduleName, const LoadedModule& module);
+
+        /**
+         * @brief Subscribes to module load and unload notifications.
+         *
+         * @return Id for RemoveListener()
+         */
+        static size_t AddListener(ModuleListener listener);
+
+        /**
+         * @brief Unsubscribes a listener registered with AddListener().
+         */
+        static void RemoveListener(size_t id);
+
+    private:
+        static ModulePtr Describe(uint8_t* base, std::wstring path);
+        static ModulePtr Register(uint8_t* base, const wchar_t* fallbackName);
+        static void Add(ModulePtr module);
+        static ModulePtr Remove(const uint8_t* base);
+        static void Notify(const ModulePtr& module, bool loaded);
+        static void EnsureSeeded();
+
+        friend struct ModuleRegistryNotifications;
+    };
+}
@@ -0,0 +1,71 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include <ByteWeaverPCH.h>
+#include <InlineHook.h>
+
+namespace ByteWeaver {
+
+    /**
+     * @brief A function hook that overwrites only five bytes of the target, on x86 and x64 alike.
+     *
+     * Detour overwrites at least 14 bytes on x64 for an absolute jump. NearHook instead writes a
+     * 5-byte rel32 jump and keeps its trampoline in a TrampolinePool slot within reach of the
+     * target, so very short functions can be hooked and the hooked path stays a near jump. When
+     * the detour function itself is out of rel32 reach, the jump goes through an absolute relay
+     * stored in the same slot.
+     *
+     * The overwritten instructions are relocated and the jump is written as described in
+     * InlineHook.
+     *
+     * ### Example:
+     * ```cpp
+     * static decltype(&GetTickCount) RealGetTickCount = &GetTickCount;
+     * static DWORD WINAPI HookedGetTickCount() { return RealGetTickCount() * 2; }
+     *
+     * MemoryManager::CreateNearHook("GetTickCount", reinterpret_cast<uintptr_t>(&GetTickCount),
+     *     reinterpret_cast<PVOID*>(&RealGetTickCount), reinterpret_cast<PVOID>(&HookedGetTickCount));
+     * MemoryManager::ApplyMod("GetTickCount");
+     * ```
+     *
+     * @note This class is final and cannot be inherited from.
+     * @see Detour, InlineHook, TrampolinePool
+     */
+    class NearHook final : public InlineHook {
+    public:
+        /**
+         * @brief Receives the trampoline when the hook is applied, and the target again when it
+         * is restored; call through it to reach the original function.
+         */
+        PVOID* OriginalFunction;
+
+        /// @brief Function that runs in place of the target while the hook is applied
+        PVOID DetourFunction;
+
+        /**
+         * @brief Constructs a near hook; decodes the target's prologue to size the overwrite.
+         *
+         * @param targetAddress Address of the function to hook
+         * @param originalFunction Pointer that will receive the trampoline address
+         * @param detourFunction Function that will replace the original
+         */
+        NearHook(uintptr_t targetAddress, PVOID* originalFunction, PVOID detourFunction);
+
+        /**
+         * @brief Builds the trampoline and writes the jump over the target.
+         * @return true if the hook is live
+         */
+        bool Apply() override;
+
+        /// @brief Returns true if the jump goes through an absolute relay (detour out of rel32 reach)
+        bool UsesRelay() const { return _Relay; }
+
+    protected:
+        std::optional<size_t> WriteEntry(uint8_t* slot, uintptr_t& entry) override;
+        void OnLiveChanged(bool live) override;
+
+    private:
+        bool _Relay = false;
+    };
+}
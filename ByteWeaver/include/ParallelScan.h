@@ -0,0 +1,102 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include <ByteWeaverPCH.h>
+
+namespace ByteWeaver {
+
+    /**
+     * @brief Runs a task, typically on another thread.
+     *
+     * Lets the host hand scan chunks to its own job system instead of ByteWeaver's pool.
+     * The executor may run the task later or never; the scanning thread always works
+     * through the chunks itself too and never blocks on a task that has not started.
+     */
+    using ScanExecutor = std::function<void(std::function<void()>)>;
+
+    /**
+     * @brief Settings for parallel signature scanning.
+     */
+    struct ParallelScanOptions {
+        /// @brief Split large scans across worker threads (off by default)
+        bool Enabled = false;
+
+        /// @brief Bytes of start positions per chunk; roughly an L2 cache worth of data
+        size_t ChunkSize = 256 * 1024;
+
+        /// @brief Regions smaller than this are always scanned on the calling thread
+        size_t MinimumSize = 2 * 1024 * 1024;
+
+        /// @brief Upper bound on threads working on one scan, including the caller (0 = pool size + 1)
+        size_t MaxWorkers = 0;
+
+        /// @brief Optional executor for chunk tasks; the internal pool is used when empty
+        ScanExecutor Executor{};
+    };
+
+    /**
+     * @brief Chunk scheduler and worker pool behind AddressScanner's parallel mode.
+     *
+     * A scan is cut into chunks of start positions. Neighbouring chunks overlap by the pattern
+     * length minus one, so every match start belongs to exactly one chunk. Workers claim chunks in
+     * address order. A chunk that settles the search by itself (e.g. it holds the first match)
+     * cancels every chunk after it, and results are merged in address order so skip counts keep
+     * their meaning.
+     *
+     * The internal pool starts lazily on the first parallel scan. Scans fall back to the calling
+     * thread when parallel mode is off, the region is small, or the caller holds the loader lock
+     * (new threads cannot start while DllMain is running).
+     *
+     * ### Example:
+     * ```cpp
+     * ParallelScanOptions options;
+     * options.Enabled = true;
+     * ParallelScan::SetOptions(options);
+     * AddressDB::UpdateAll(); // large modules are now scanned on all cores
+     * ```
+     *
+     * @note Call Shutdown() before unloading a DLL that used the internal pool
+     */
+    class ParallelScan {
+    public:
+        /**
+         * @brief Replaces the parallel scan settings.
+         */
+        static void SetOptions(ParallelScanOptions options);
+
+        /**
+         * @brief Returns a copy of the current settings.
+         */
+        static ParallelScanOptions GetOptions();
+
+        /**
+         * @brief Returns true if a region of this size should be scanned in parallel right now.
+         */
+        static bool ShouldRun(size_t regionSize);
+
+        /**
+         * @brief Processes chunks [0, chunkCount) on the calling thread plus any available workers.
+         *
+         * @param chunkCount Number of chunks
+         * @param process Called once per claimed chunk; returns true when the chunk settles the
+         *                search, which cancels every later chunk that has not started yet
+         *
+         * @return Index of the first chunk that settled the search, or SIZE_MAX. Every chunk up to
+         *         it (or every chunk, if none did) has been processed when this returns
+         */
+        static size_t RunChunks(size_t chunkCount, const std::function<bool(size_t)>& process);
+
+        /**
+         * @brief Stops and joins the internal worker threads.
+         *
+         * The pool restarts on the next parallel scan.
+         */
+        static void Shutdown();
+
+        /**
+         * @brief Returns true if the calling thread owns the loader lock.
+         */
+        static bool IsLoaderLockHeld();
+    };
+}
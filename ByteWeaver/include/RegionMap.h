@@ -0,0 +1,94 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include <ByteWeaverPCH.h>
+
+namespace ByteWeaver {
+
+    /**
+     * @brief One committed region of the address space, as reported by VirtualQuery.
+     */
+    struct MemoryRegion {
+        uintptr_t Base = 0;
+        size_t Size = 0;
+        DWORD Protect = 0;
+        DWORD Type = 0;
+
+        uintptr_t End() const noexcept { return Base + Size; }
+        bool Contains(const uintptr_t address) const noexcept { return address >= Base && address - Base < Size; }
+    };
+
+    /**
+     * @brief Optional cache of the committed regions of this process and their protections.
+     *
+     * Disabled, every query is a plain VirtualQuery. Enabled, queries binary-search a sorted,
+     * atomically published snapshot instead, so validating addresses on hot paths stops costing a
+     * kernel transition each time. Regions missing from the snapshot are still asked of the OS and
+     * learned, so memory committed after the snapshot was taken is found on first use.
+     *
+     * ByteWeaver keeps the snapshot in step with its own changes: patches and detours drop the
+     * range they reprotect, and unloaded modules drop their image. Memory the process frees or
+     * reprotects by other means is not seen until Refresh() or Invalidate() is called, which is
+     * why the cache is opt-in.
+     *
+     * ### Example:
+     * ```cpp
+     * RegionMap::SetEnabled(true);
+     * if (MemoryManager::IsMemoryRangeValid(address, 64))  // answered from the snapshot
+     *     ...
+     * RegionMap::Refresh();                                // after the game remaps memory
+     * ```
+     */
+    class RegionMap {
+    public:
+        /// @brief Protections MemoryManager treats as readable
+        static constexpr DWORD ReadableProtections = PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY |
+            PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE;
+
+        /// @brief Protections a detour target must have
+        static constexpr DWORD ExecutableProtections = PAGE_EXECUTE | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE;
+
+        /**
+         * @brief Turns the cache on or off (off by default).
+         *
+         * Enabling builds the snapshot on the next query; disabling drops it.
+         */
+        static void SetEnabled(bool enabled);
+
+        /// @brief Returns true if queries are answered from the snapshot
+        static bool IsEnabled();
+
+        /**
+         * @brief Rebuilds the snapshot from a full walk of the address space.
+         * @note Does nothing while the cache is disabled
+         */
+        static void Refresh();
+
+        /**
+         * @brief Drops every cached region overlapping a range; they are queried again on next use.
+         * @param address Start of the range
+         * @param length Size of the range in bytes
+         */
+        static void Invalidate(uintptr_t address, size_t length);
+
+        /**
+         * @brief Returns the committed region containing an address.
+         * @param address Address to look up
+         * @return The region, or std::nullopt if the address is free or reserved
+         */
+        static std::optional<MemoryRegion> Query(uintptr_t address);
+
+        /**
+         * @brief Checks that every byte of a range is committed with one of the given protections.
+         * @param address Start of the range
+         * @param length Size of the range in bytes (an empty range is accessible)
+         * @param protections Accepted protection flags
+         * @return true if the whole range is accessible
+         */
+        static bool IsRangeAccessible(uintptr_t address, size_t length, DWORD protections = ReadableProtections);
+
+        /// @brief Number of regions in the current snapshot (0 while disabled)
+        static size_t RegionCount();
+    };
+}
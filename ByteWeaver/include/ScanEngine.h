@@ -0,0 +1,214 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#ifndef BYTEWEAVER_ENABLE_SIMD_SCAN
+    #define BYTEWEAVER_ENABLE_SIMD_SCAN 1
+#endif
+
+#include <ByteWeaverPCH.h>
+#include <CompiledPattern.h>
+
+namespace ByteWeaver {
+
+    /**
+     * @brief Instruction set used by the signature scanning engine.
+     *
+     * The best backend supported by the CPU and OS is selected at runtime via CPUID.
+     * Every backend produces identical results; they only differ in how many candidate
+     * positions are filtered per step.
+     */
+    enum class ScanBackend : uint8_t {
+        Scalar,     ///< Horspool skip loop with masked compare (always available)
+        SSE2,       ///< 16 candidate positions per step
+        AVX2        ///< 32 candidate positions per step
+    };
+
+    /**
+     * @brief One pattern of a multi-pattern scan (see ScanEngine::FindMany).
+     */
+    struct ScanJob {
+        /// @brief Pattern to look for; must outlive the scan
+        const CompiledPattern* Pattern = nullptr;
+
+        /// @brief Number of matches to skip before recording a result
+        size_t SkipCount = 0;
+
+        /// @brief Absolute address of the match, set once the job is resolved
+        std::optional<uintptr_t> Address{};
+    };
+
+    /**
+     * @brief Shared-anchor bucket index over a batch of ScanJobs.
+     *
+     * Jobs are bucketed by the value of their pattern's anchor byte. A scan then only stops
+     * at positions holding one of the anchor values and only tests the jobs in that bucket,
+     * so N patterns cost one pass over the region instead of N. Resolved jobs are removed
+     * from their bucket as the scan progresses.
+     *
+     * The index also carries each job's remaining skip count, so FindMany can be called on
+     * several regions in address order and skip counts apply across all of them.
+     *
+     * @note Building the index allocates; scanning with it does not
+     */
+    class MultiPatternIndex {
+    public:
+        /**
+         * @brief Builds the index and clears every job's Address.
+         *
+         * @param jobs Jobs to resolve; the span must outlive the index
+         * @param recordMatches Also keep every match consumed by each job (see Matches())
+         */
+        explicit MultiPatternIndex(std::span<ScanJob> jobs, bool recordMatches = false);
+
+        /**
+         * @brief Returns the number of jobs that have not been resolved yet.
+         */
+        [[nodiscard]] size_t Pending() const noexcept { return _Pending; }
+
+        /**
+         * @brief Returns the jobs this index was built over.
+         */
+        [[nodiscard]] std::span<ScanJob> Jobs() const noexcept { return _Jobs; }
+
+        /**
+         * @brief Returns true once a job has its Address.
+         */
+        [[nodiscard]] bool IsResolved(size_t jobIndex) const noexcept { return _Jobs[jobIndex].Address.has_value(); }
+
+        /**
+         * @brief Returns how many more matches a job skips before it resolves.
+         */
+        [[nodiscard]] size_t SkipsLeft(size_t jobIndex) const noexcept { return _Remaining[jobIndex]; }
+
+        /**
+         * @brief Returns the matches consumed by a job so far, in the order they were found.
+         *
+         * Only populated when the index was built with recordMatches; holds at most SkipCount + 1 entries.
+         */
+        [[nodiscard]] std::span<const uintptr_t> Matches(size_t jobIndex) const noexcept;
+
+        /**
+         * @brief Feeds one match to a job, as if the scan had found it.
+         *
+         * Used to merge matches found by a separate scan (e.g. a parallel chunk). Matches must
+         * be fed in address order. Matches fed to a resolved job are ignored.
+         *
+         * @param jobIndex Index of the job in Jobs()
+         * @param address Absolute address of the match
+         *
+         * @return true if the job is resolved (now or already)
+         */
+        bool Record(size_t jobIndex, uintptr_t address);
+
+    private:
+        friend class ScanEngine;
+
+        std::span<ScanJob> _Jobs;
+        std::vector<size_t> _Remaining;
+        std::vector<uint32_t> _Unanchored;
+        std::vector<uint32_t> _BucketJobs;
+        std::array<uint32_t, 257> _BucketStart{};
+        std::array<uint32_t, 256> _BucketEnd{};
+        std::vector<uint8_t> _AnchorBytes;
+        std::array<uint8_t, 256> _IsAnchor{};
+        alignas(16) std::array<uint8_t, 16> _LowNibbles{};
+        std::vector<uintptr_t> _Matches;
+        std::vector<size_t> _MatchBase;
+        std::vector<size_t> _MatchCount;
+        size_t _Pending = 0;
+        size_t _PendingAnchored = 0;
+    };
+
+    /**
+     * @brief Low-level masked byte pattern matcher used by AddressScanner.
+     *
+     * Patterns are supplied as CompiledPattern objects (packed value/mask arrays).
+     * The vector backends broadcast the pattern's rarest fixed byte (the anchor) and a
+     * second confirmation byte, compare 16/32 candidate positions at a time, and only run
+     * the full masked compare on positions where both bytes match. The scalar backend walks
+     * the pattern's Boyer-Moore-Horspool skip table.
+     *
+     * @note Callers are responsible for guarding against access violations (see AddressScanner::FindSignature)
+     * @note Compile with BYTEWEAVER_ENABLE_SIMD_SCAN=0 to force the scalar backend
+     */
+    class ScanEngine {
+    public:
+        /**
+         * @brief Returns the backend currently used by Find().
+         *
+         * On first use this is the best backend reported by DetectBackend().
+         */
+        static ScanBackend GetBackend();
+
+        /**
+         * @brief Overrides the backend used by Find().
+         *
+         * Requests for a backend the CPU does not support are clamped to the best supported one.
+         *
+         * @param backend Backend to use for subsequent scans
+         */
+        static void SetBackend(ScanBackend backend);
+
+        /**
+         * @brief Determines the best backend supported by the CPU and OS via CPUID/XGETBV.
+         */
+        static ScanBackend DetectBackend();
+
+        /**
+         * @brief Returns a printable name for a backend (e.g. "AVX2").
+         */
+        static const char* BackendName(ScanBackend backend);
+
+        /**
+         * @brief Picks the fixed byte least likely to occur in x86/x64 code.
+         *
+         * @param values Expected byte values
+         * @param masks  Byte masks (0xFF fixed, 0x00 wildcard)
+         * @param length Pattern length in bytes
+         * @param exclude Offset to skip (used to pick a second, distinct anchor), or SIZE_MAX
+         *
+         * @return Offset of the rarest fixed byte, or SIZE_MAX if the pattern has no fixed bytes
+         */
+        static size_t SelectAnchor(const uint8_t* values, const uint8_t* masks, size_t length,
+                                   size_t exclude = SIZE_MAX);
+
+        /**
+         * @brief Searches a memory region for the Nth occurrence of a compiled pattern.
+         *
+         * @param base Start of the region to search
+         * @param size Size of the region in bytes
+         * @param pattern Compiled pattern to look for
+         * @param skipCount Number of matches to skip before returning
+         * @param skipped Optional; receives the number of matches that were skipped, which lets
+         *                a caller carry the remaining skip count into the next region
+         *
+         * @return Offset of the match from base, or std::nullopt if not found
+         *
+         * @note The scalar backend uses the pattern's Boyer-Moore-Horspool skip table
+         * @warning The whole region must be readable
+         */
+        static std::optional<size_t> Find(const uint8_t* base, size_t size,
+                                          const CompiledPattern& pattern,
+                                          size_t skipCount = 0,
+                                          size_t* skipped = nullptr);
+
+        /**
+         * @brief Resolves every pending job of a MultiPatternIndex in a single pass over a region.
+         *
+         * AVX2 classifies 32 bytes per step against the whole anchor set with a nibble lookup.
+         * SSE2 compares against up to 8 distinct anchor values per step and falls back to the
+         * scalar lookup table for larger sets.
+         *
+         * @param base Start of the region to search
+         * @param size Size of the region in bytes
+         * @param index Index built over the jobs to resolve (updated in place)
+         *
+         * @return Number of jobs resolved by this call
+         *
+         * @note Matches are reported in address order per job, so skip counts behave as in Find()
+         * @warning The whole region must be readable
+         */
+        static size_t FindMany(const uint8_t* base, size_t size, MultiPatternIndex& index);
+    };
+}
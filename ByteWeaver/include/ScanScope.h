@@ -0,0 +1,105 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include <ByteWeaverPCH.h>
+
+namespace ByteWeaver {
+
+    /**
+     * @brief Contiguous part of a loaded image, relative to the module base.
+     */
+    struct ScanRange {
+        /// @brief Offset (RVA) of the first byte
+        size_t Offset = 0;
+
+        /// @brief Size of the range in bytes
+        size_t Size = 0;
+    };
+
+    /**
+     * @brief Which part of a module a signature scan should cover.
+     */
+    enum class ScanScopeKind : uint8_t {
+        Image,          ///< The whole image (SizeOfImage bytes from the base)
+        Executable,     ///< Every section marked IMAGE_SCN_MEM_EXECUTE
+        Section,        ///< A single section selected by name (e.g. ".text")
+        RvaRange        ///< A caller supplied RVA range
+    };
+
+    /**
+     * @brief Restricts a module scan to part of the image.
+     *
+     * Scanning the whole image also walks headers, .rdata, .data, .rsrc and any uncommitted
+     * gaps between sections. Code signatures only ever match inside executable sections, so
+     * limiting the scope cuts the bytes scanned and keeps the scan off pages that may fault.
+     *
+     * Ranges are computed from the module's IMAGE_SECTION_HEADER table and returned in
+     * address order, so skip counts apply across ranges just as they would in one scan.
+     *
+     * ### Example:
+     * ```cpp
+     * auto result = AddressScanner::ModuleSearch(L"game.exe", "GameLoop", pattern, 0,
+     *                                            ScanScope::NamedSection(".text"));
+     * ```
+     *
+     * @see AddressScanner::ModuleSearch, AddressEntry::Scope
+     */
+    class ScanScope {
+    public:
+        /// @brief Kind of scope
+        ScanScopeKind Kind = ScanScopeKind::Image;
+
+        /// @brief Section name for ScanScopeKind::Section (at most 8 characters)
+        std::string SectionName{};
+
+        /// @brief First RVA for ScanScopeKind::RvaRange
+        size_t RvaBegin = 0;
+
+        /// @brief Size in bytes for ScanScopeKind::RvaRange
+        size_t RvaSize = 0;
+
+        /**
+         * @brief Scope covering the whole image (default).
+         */
+        static ScanScope WholeImage();
+
+        /**
+         * @brief Scope covering every executable section.
+         */
+        static ScanScope ExecutableSections();
+
+        /**
+         * @brief Scope covering a single section.
+         *
+         * @param name Section name as stored in the section header (e.g. ".text")
+         */
+        static ScanScope NamedSection(std::string name);
+
+        /**
+         * @brief Scope covering a caller supplied RVA range.
+         *
+         * @param rva  First RVA to scan
+         * @param size Number of bytes to scan (clamped to SizeOfImage)
+         */
+        static ScanScope Range(size_t rva, size_t size);
+
+        /**
+         * @brief Computes the ranges covered by this scope in a mapped image.
+         *
+         * Adjacent sections are merged so patterns straddling a section boundary are still found.
+         *
+         * @param moduleBase Base address of a loaded (mapped) PE image
+         *
+         * @return Ranges in address order; empty if the scope matches nothing (e.g. unknown section)
+         */
+        [[nodiscard]] std::vector<ScanRange> Resolve(const uint8_t* moduleBase) const;
+
+        /**
+         * @brief Returns a short description for logging (e.g. "section .text").
+         */
+        [[nodiscard]] std::string Describe() const;
+
+        bool operator==(const ScanScope&) const = default;
+    };
+}
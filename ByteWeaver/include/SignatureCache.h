@@ -0,0 +1,162 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include <ByteWeaverPCH.h>
+#include <CompiledPattern.h>
+#include <ScanScope.h>
+
+namespace ByteWeaver {
+
+    /**
+     * @brief Identifies one build of a PE image.
+     *
+     * Two images with the same identity are treated as byte-identical, so offsets
+     * resolved in one are valid in the other.
+     */
+    struct ModuleIdentity {
+        /// @brief IMAGE_FILE_HEADER::TimeDateStamp
+        uint32_t TimeDateStamp = 0;
+
+        /// @brief IMAGE_OPTIONAL_HEADER::CheckSum
+        uint32_t CheckSum = 0;
+
+        /// @brief IMAGE_OPTIONAL_HEADER::SizeOfImage
+        uint32_t SizeOfImage = 0;
+
+        /**
+         * @brief Reads the identity from the headers of a mapped image (or a raw file image).
+         *
+         * @param imageBase Start of the image (DOS header)
+         * @return Identity, or std::nullopt if the headers are not a valid PE
+         */
+        static std::optional<ModuleIdentity> FromImage(const uint8_t* imageBase);
+
+        bool operator==(const ModuleIdentity&) const = default;
+    };
+
+    /**
+     * @brief Persistent cache of resolved signature offsets.
+     *
+     * Maps (symbol, module, pattern hash) to the offset the pattern resolved to, together with the
+     * identity of the module it was resolved in. AddressDB::UpdateAll consults the cache before
+     * scanning: an entry whose module identity still matches is verified with one masked compare at
+     * the cached offset, and only stale or missing entries are scanned for. Newly resolved entries
+     * are written back when the update finishes.
+     *
+     * ## File Format
+     *
+     * UTF-8 text, one entry per line, tab separated:
+     * ```
+     * # ByteWeaver signature cache v1
+     * <pattern hash> <TimeDateStamp> <CheckSum> <SizeOfImage> <offset> <module> <symbol>
+     * ```
+     * Numbers are hexadecimal. Unknown or malformed lines are skipped.
+     *
+     * ### Example:
+     * ```cpp
+     * // ByteWeaver does not depend on LogUtils, so the caller picks the location
+     * SignatureCache::Open(LogUtils::FileManager::ProjectPath / "signatures.cache");
+     * AddressDB::UpdateAll(); // cache hits skip the scan entirely
+     * ```
+     *
+     * @note Thread-safe; the cache is disabled until Open() is called
+     */
+    class SignatureCache {
+    public:
+        /**
+         * @brief Enables the cache and loads the entries stored at path, if the file exists.
+         *
+         * @param path Cache file location
+         * @return true if the file was loaded or does not exist yet
+         */
+        static bool Open(const fs::path& path);
+
+        /**
+         * @brief Writes pending changes (if any) and disables the cache.
+         */
+        static void Close();
+
+        /**
+         * @brief Returns true between Open() and Close().
+         */
+        static bool IsEnabled();
+
+        /**
+         * @brief Writes the cache file if entries changed since it was loaded or last saved.
+         *
+         * @return true if the file is up to date
+         */
+        static bool Save();
+
+        /**
+         * @brief Drops every entry (the file is rewritten on the next Save()).
+         */
+        static void Clear();
+
+        /**
+         * @brief Hashes everything that determines where a pattern resolves (FNV-1a).
+         *
+         * @param pattern Compiled pattern (values and masks)
+         * @param skipCount Number of matches skipped
+         * @param scope Part of the module that is scanned
+         */
+        static uint64_t HashPattern(const CompiledPattern& pattern, size_t skipCount, const ScanScope& scope);
+
+        /**
+         * @brief Looks up the cached offset of a signature.
+         *
+         * @return Offset from the module base, or std::nullopt if missing or resolved in another build
+         */
+        static std::optional<uintptr_t> Lookup(const std::string& symbolName, const std::wstring& moduleName,
+                                               uint64_t patternHash, const ModuleIdentity& identity);
+
+        /**
+         * @brief Records (or replaces) the resolved offset of a signature.
+         */
+        static void Store(const std::string& symbolName, const std::wstring& moduleName,
+                          uint64_t patternHash, const ModuleIdentity& identity, uintptr_t offset);
+
+        /**
+         * @brief Checks a cached offset with a masked compare against the loaded image.
+         *
+         * @param moduleBase Base of the loaded module
+         * @param offset Cached offset
+         * @param pattern Pattern the offset was resolved for
+         *
+         * @return true if the offset lies inside the image and the pattern matches there
+         */
+        static bool Verify(const uint8_t* moduleBase, uintptr_t offset, const CompiledPattern& pattern);
+
+    private:
+        struct Key {
+            std::string Symbol;
+            std::wstring Module;
+            uint64_t PatternHash = 0;
+
+            bool operator==(const Key&) const = default;
+        };
+
+        struct KeyHash {
+            size_t operator()(const Key& k) const noexcept {
+                static constexpr auto KGolden = static_cast<size_t>(0x9e3779b97f4a7c15ULL);
+                const size_t h1 = std::hash<std::string>{}(k.Symbol);
+                const size_t h2 = std::hash<std::wstring>{}(k.Module);
+                return (h1 ^ (h2 + KGolden + (h1 << 6) + (h1 >> 2))) ^ static_cast<size_t>(k.PatternHash);
+            }
+        };
+
+        struct Record {
+            ModuleIdentity Identity{};
+            uintptr_t Offset = 0;
+        };
+
+        static bool LoadFile();
+
+        static std::unordered_map<Key, Record, KeyHash> _Entries;
+        static fs::path _Path;
+        static bool _Enabled;
+        static bool _Dirty;
+        static std::mutex _Mutex;
+    };
+}
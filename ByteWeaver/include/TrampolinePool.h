@@ -0,0 +1,95 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include <ByteWeaverPCH.h>
+
+namespace ByteWeaver {
+
+    /**
+     * @brief Executable slots for hook trampolines, allocated close to the code they serve.
+     *
+     * Slots are carved from shared arenas of one allocation granule (64 KB, 1024 slots), kept
+     * execute-read outside of writes. Every arena lies within MaxDistance of the target it was
+     * created for and is reused by any later target it is still close to, so the hooks of one
+     * module pack into the same few pages and can reach their trampolines with a rel32 jump. Longer
+     * code takes several contiguous slots.
+     *
+     * Arenas are never released, and freed slots are never handed out again: a thread may still be
+     * returning through a trampoline long after its hook is gone (a MidHook callback that was
+     * running, a relocated call), so a freed slot keeps its code. A target hooked and unhooked in
+     * a loop therefore takes new slots each time.
+     *
+     * ### Example:
+     * ```cpp
+     * uint8_t* slot = TrampolinePool::Allocate(target);
+     * if (TrampolinePool::Writer writer(slot); writer)
+     *     memcpy(slot, code, codeSize);
+     * ```
+     */
+    class TrampolinePool {
+    public:
+        /// @brief Bytes per slot; slots are aligned to their size and never straddle a page
+        static constexpr size_t SlotSize = 64;
+
+        /**
+         * @brief Farthest an arena may lie from its target, on x64.
+         *
+         * Half the reach of a rel32, so relocated rip-relative operands of the target's module still
+         * reach their data from the trampoline. x86 arenas may be anywhere.
+         */
+        static constexpr uintptr_t MaxDistance = 0x40000000;
+
+        /**
+         * @brief Returns free slots within MaxDistance of a target, filled with int3.
+         * @param target Address the slots' code will jump to and from
+         * @param count Number of contiguous slots, for code longer than SlotSize
+         * @return The first slot, or nullptr if no memory could be reserved within reach
+         */
+        static uint8_t* Allocate(uintptr_t target, size_t count = 1);
+
+        /**
+         * @brief Retires slots: their code stays in place for threads still running through it,
+         *        and they are never handed out again.
+         * @param slot First slot, as returned by Allocate()
+         * @param count Number of slots passed to Allocate()
+         * @note The caller must make sure no hook still jumps into the slots
+         */
+        static void Free(uint8_t* slot, size_t count = 1);
+
+        /// @brief Returns true if an address lies in one of the arenas
+        static bool Contains(uintptr_t address);
+
+        /// @brief Number of arenas reserved so far
+        static size_t ArenaCount();
+
+        /// @brief Number of slots currently handed out
+        static size_t SlotsInUse();
+
+        /// @brief Number of slots freed, which are never handed out again
+        static size_t SlotsRetired();
+
+        /**
+         * @brief Makes slots writable for the lifetime of the object.
+         *
+         * Writers are serialized, so two slots sharing a page are never reprotected concurrently.
+         * The pages are made execute-read again, and the instruction cache flushed, on destruction.
+         */
+        class Writer {
+        public:
+            explicit Writer(uint8_t* slot, size_t count = 1);
+            ~Writer();
+
+            Writer(const Writer&) = delete;
+            Writer& operator=(const Writer&) = delete;
+
+            /// @brief false if the slot could not be made writable
+            explicit operator bool() const noexcept { return _Open; }
+
+        private:
+            uint8_t* _Slot;
+            size_t _Size;
+            bool _Open = false;
+        };
+    };
+}
@@ -76,5 +76,35 @@ namespace ByteWeaver {
          * @note The detour must have been previously applied for restoration to succeed.
          */
         bool Restore() override;
+
+        /**
+         * @brief Applies several detours in a single Detours transaction.
+         *
+         * Every other thread of the process is enlisted with DetourUpdateThread, so no thread
+         * runs through a half-written prologue, and all attaches are committed together: either
+         * every detour goes live or, on any failure, none does. Detours that are already applied
+         * are skipped.
+         *
+         * @param detours Detours to apply
+         * @return true if all detours are applied when this returns
+         *
+         * ### Example:
+         * ```cpp
+         * std::vector<Detour*> hooks = { &createFileHook, &readFileHook };
+         * Detour::ApplyBatch(hooks);
+         * ```
+         */
+        static bool ApplyBatch(std::span<Detour* const> detours);
+
+        /**
+         * @brief Restores several detours in a single Detours transaction.
+         *
+         * Counterpart of ApplyBatch(): all detaches commit together or not at all. Detours
+         * that are not applied are skipped.
+         *
+         * @param detours Detours to restore
+         * @return true if all detours are restored when this returns
+         */
+        static bool RestoreBatch(std::span<Detour* const> detours);
     };
 }
\ No newline at end of file
@@ -23,11 +23,11 @@ namespace ByteWeaver
         /**
          * @brief The byte sequence that will be written to the target address.
          *
-         * This vector contains the raw bytes that will replace the original code
-         * at the patch address when the patch is applied. The size of this vector
-         * determines how many bytes will be modified.
+         * This buffer contains the raw bytes that will replace the original code
+         * at the patch address when the patch is applied. Its size determines how
+         * many bytes will be modified. Short patches are stored inline (see ModBytes).
          */
-        std::vector<uint8_t> PatchBytes;
+        ModBytes PatchBytes;
 
         /**
          * @brief Constructs a new Patch object.
@@ -39,7 +39,15 @@ namespace ByteWeaver
          *       at the target address. Ensure the patch bytes are valid for the
          *       target architecture and instruction alignment.
          */
-        Patch(uintptr_t patchAddress, std::vector<uint8_t> patchBytes);
+        Patch(uintptr_t patchAddress, const std::vector<uint8_t>& patchBytes);
+
+        /**
+         * @brief Constructs a new Patch object without an intermediate std::vector.
+         *
+         * @param patchAddress The memory address where the patch will be applied
+         * @param patchBytes The bytes to write at the target address
+         */
+        Patch(uintptr_t patchAddress, std::span<const uint8_t> patchBytes);
 
         /**
          * @brief Applies the patch by writing the patch bytes to the target address.
@@ -69,5 +77,37 @@ namespace ByteWeaver
          *       The original bytes must have been preserved during the Apply() operation.
          */
         bool Restore() override;
+
+        /**
+         * @brief Applies several patches with one protection change and cache flush per page run.
+         *
+         * Patches are sorted by address and merged into runs of pages that share one memory
+         * region (and therefore one protection). Each run is made writable once, all its
+         * patches are written, its protection is restored and the instruction cache is flushed
+         * once. A patch that cannot be written is logged with its key and does not stop the
+         * rest of the run. Patches that are already applied are skipped.
+         *
+         * @param patches Patches to apply
+         * @param failedKeys Receives the key (or address) of every patch that failed; may be nullptr
+         * @return true if all patches are applied when this returns
+         *
+         * ### Example:
+         * ```cpp
+         * std::vector<Patch*> nops = { &nopA, &nopB, &nopC };
+         * std::vector<std::string> failed;
+         * if (!Patch::ApplyBatch(nops, &failed))
+         *     Warn("%zu patches failed", failed.size());
+         * ```
+         */
+        static bool ApplyBatch(std::span<Patch* const> patches, std::vector<std::string>* failedKeys = nullptr);
+
+        /**
+         * @brief Restores several patches, coalesced into page runs like ApplyBatch().
+         *
+         * @param patches Patches to restore
+         * @param failedKeys Receives the key (or address) of every patch that failed; may be nullptr
+         * @return true if all patches are restored when this returns
+         */
+        static bool RestoreBatch(std::span<Patch* const> patches, std::vector<std::string>* failedKeys = nullptr);
     };
 }
\ No newline at end of file
@@ -1,24 +1,22 @@
 // Copyright(C) 2025 0xKate - MIT License
 
+#include <cassert>
 #include <AddressDB.h>
+#include <AddressScanner.h>
+#include <ModuleRegistry.h>
+#include <SignatureCache.h>
 
 namespace ByteWeaver {
 
     // ---- static storage ----
-    std::unordered_map<AddressDB::Key, AddressEntry, AddressDB::KeyHash> AddressDB::_Database{};
+    AddressTable AddressDB::_Database{};
     std::shared_mutex AddressDB::_Mutex{};
 
     // ---- add ----
     void AddressDB::Add(AddressEntry entry) {
         Key key{ entry.SymbolName, entry.ModuleName };
         std::unique_lock lock(_Mutex);
-        if (const auto it = _Database.find(key); it == _Database.end()) {
-            _Database.emplace(std::move(key), std::move(entry));
-        }
-        else {
-            _Database.erase(it);  // remove old (non-assignable) value
-            _Database.emplace(std::move(key), std::move(entry)); // insert new one
-        }
+        _Database.InsertOrAssign(std::move(key), std::move(entry));
     }
 
     void AddressDB::Add(std::string symbolName, std::wstring moduleName) {
@@ -35,49 +33,228 @@ namespace ByteWeaver {
             offset));
     }
 
-    void AddressDB::AddWithScanPattern(std::string symbolName, std::wstring moduleName, std::string pattern) {
+    void AddressDB::AddWithScanPattern(std::string symbolName, std::wstring moduleName, std::string pattern, const size_t skipCount, ScanScope scope) {
         Add(AddressEntry::WithScanPattern(std::move(symbolName),
             std::move(moduleName),
-            std::move(pattern)));
+            std::move(pattern),
+            skipCount,
+            std::move(scope)));
     }
 
     // ---- find ----
-    AddressEntry* AddressDB::Find(const std::string& symbolName, const std::wstring& moduleName) {
-        return Find(Key{ symbolName, moduleName });
+    AddressEntry* AddressDB::Find(const std::string_view symbolName, const std::wstring_view moduleName) {
+        std::shared_lock lock(_Mutex);
+        const auto record = _Database.At(_Database.Find(symbolName, moduleName));
+        return record ? &record->second : nullptr;
     }
 
     AddressEntry* AddressDB::Find(const Key& key) {
+        return Find(key.first, key.second);
+    }
+
+    AddressEntry* AddressDB::Find(const PreparedAddressKey& key) {
+        std::shared_lock lock(_Mutex);
+        const auto record = _Database.At(_Database.Find(key.Symbol, key.ModuleId, key.Hash));
+        return record ? &record->second : nullptr;
+    }
+
+    AddressEntry* AddressDB::Find(const AddressHandle handle) {
+        std::shared_lock lock(_Mutex);
+        const auto record = _Database.Resolve(handle);
+        return record ? &record->second : nullptr;
+    }
+
+    std::optional<uintptr_t> AddressDB::TryGetAddress(const std::string_view symbolName, const std::wstring_view moduleName) {
+        std::shared_lock lock(_Mutex);
+        const auto record = _Database.At(_Database.Find(symbolName, moduleName));
+        if (!record || !record->second.TargetAddress)
+            return std::nullopt;
+        return record->second.TargetAddress;
+    }
+
+    size_t AddressDB::FindBatch(const std::span<const AddressQuery> queries, const std::span<AddressEntry*> results) {
+        assert(results.size() >= queries.size());
+        size_t found = 0;
+        std::shared_lock lock(_Mutex);
+
+        std::wstring_view module;
+        uint32_t moduleId = AddressTable::NotFound;
+        for (size_t i = 0; i < queries.size(); ++i) {
+            const AddressQuery& query = queries[i];
+            if (i == 0 || query.Module != module) {
+                module = query.Module;
+                moduleId = _Database.FindModule(module);
+            }
+
+            const uint32_t slot = moduleId == AddressTable::NotFound ? AddressTable::NotFound
+                : _Database.Find(query.Symbol, moduleId, AddressTable::Hash(query.SymbolHash, moduleId));
+            const auto record = _Database.At(slot);
+            results[i] = record ? &record->second : nullptr;
+            found += record != nullptr;
+        }
+        return found;
+    }
+
+    PreparedAddressKey AddressDB::Prepare(std::string symbolName, const std::wstring_view moduleName) {
+        std::unique_lock lock(_Mutex);
+        const uint32_t moduleId = _Database.InternModule(moduleName);
+        const uint64_t hash = AddressTable::Hash(symbolName, moduleId);
+        return { std::move(symbolName), moduleId, hash };
+    }
+
+    AddressHandle AddressDB::GetHandle(const std::string_view symbolName, const std::wstring_view moduleName) {
         std::shared_lock lock(_Mutex);
-        const auto it = _Database.find(key);
-        return it == _Database.end() ? nullptr : &it->second;
+        const uint32_t slot = _Database.Find(symbolName, moduleName);
+        return slot == AddressTable::NotFound ? AddressHandle{} : _Database.HandleOf(slot);
     }
 
     // ---- management ----
-    bool AddressDB::Remove(const std::string& symbolName, const std::wstring& moduleName) {
-        return Remove(Key{ symbolName, moduleName });
+    bool AddressDB::Remove(const std::string_view symbolName, const std::wstring_view moduleName) {
+        std::unique_lock lock(_Mutex);
+        const uint32_t slot = _Database.Find(symbolName, moduleName);
+        if (slot == AddressTable::NotFound)
+            return false;
+        _Database.Erase(slot);
+        return true;
     }
 
     bool AddressDB::Remove(const Key& key) {
-        std::unique_lock lock(_Mutex);
-        return _Database.erase(key) > 0;
+        return Remove(key.first, key.second);
     }
 
     void AddressDB::Clear() {
         std::unique_lock lock(_Mutex);
-        _Database.clear();
+        _Database.Clear();
+    }
+
+    bool AddressDB::Defer(const std::string_view symbolName, const std::wstring_view moduleName) {
+        std::unique_lock lock(_Mutex);
+        const auto record = _Database.At(_Database.Find(symbolName, moduleName));
+        if (!record)
+            return false;
+        record->second.Deferred = true;
+        return true;
     }
 
-    void AddressDB::UpdateAll()
+    bool AddressDB::UpdateAll(std::vector<Key>* unresolved) {
+        return UpdateEntries(nullptr, unresolved);
+    }
+
+    bool AddressDB::UpdateModule(const std::wstring& moduleName, std::vector<Key>* unresolved) {
+        return UpdateEntries(&moduleName, unresolved);
+    }
+
+    bool AddressDB::UpdateEntries(const std::wstring* moduleFilter, std::vector<Key>* unresolved)
     {
-        for (auto& [key, value] : Mutate()) {
-            HMODULE hMod = GetModuleHandleW(key.second.c_str());
-            if (!hMod) {
+        bool allResolved = true;
+        auto markUnresolved = [&](const AddressEntry& entry) {
+            allResolved = false;
+            if (unresolved)
+                unresolved->emplace_back(entry.SymbolName, entry.ModuleName);
+        };
+
+        // Pattern entries are collected per module and resolved in one pass per scope
+        std::unordered_map<std::wstring, std::vector<AddressEntry*>> patternEntries;
+
+        // The filter is matched by loader name rules (case, default extension), not spelling
+        const auto filterModule = moduleFilter ? ModuleRegistry::Find(*moduleFilter) : nullptr;
+        if (moduleFilter && !filterModule) {
+            Error("[AddressScanner] Module %ls not loaded yet.", moduleFilter->c_str());
+            return false;
+        }
+
+        const auto view = Mutate();
+        for (auto& [key, value] : view) {
+            if (filterModule && !ModuleRegistry::NameMatches(key.second, *filterModule))
+                continue;
+
+            const auto module = filterModule ? filterModule : ModuleRegistry::Find(key.second);
+            if (!module) {
+                if (value.Deferred) {
+                    Debug("[AddressDB] %-17s : deferred until %ls loads", key.first.c_str(), key.second.c_str());
+                    continue;
+                }
                 Error("[AddressScanner] Module %ls not loaded yet.", key.second.c_str());
+                markUnresolved(value);
                 continue;
             }
-            value.SetModuleBase(reinterpret_cast<uintptr_t>(hMod));
-            value.Update();
+            value.SetModuleBase(reinterpret_cast<uintptr_t>(module->Base));
+
+            if (!value.IsSymbolExport && value.GetCompiledPattern()) {
+                patternEntries[key.second].push_back(&value);
+                continue;
+            }
+            if (!value.Update().has_value())
+                markUnresolved(value);
+        }
+
+        const bool useCache = SignatureCache::IsEnabled();
+
+        for (auto& [moduleName, entries] : patternEntries) {
+            const auto moduleBase = reinterpret_cast<const uint8_t*>(entries.front()->ModuleAddress);
+            const auto module = useCache ? ModuleRegistry::FindByAddress(entries.front()->ModuleAddress) : nullptr;
+            const auto identity = module ? std::optional(module->Identity) : std::nullopt;
+
+            // Cache hits that still match at their offset skip the scan
+            if (identity.has_value()) {
+                std::erase_if(entries, [&](AddressEntry* entry) {
+                    const CompiledPattern& pattern = *entry->GetCompiledPattern();
+                    const uint64_t hash = SignatureCache::HashPattern(pattern, entry->SkipCount, entry->Scope);
+                    const auto offset = SignatureCache::Lookup(entry->SymbolName, moduleName, hash, identity.value());
+                    if (!offset.has_value() || !SignatureCache::Verify(moduleBase, offset.value(), pattern))
+                        return false;
+
+                    entry->SetKnownAddress(entry->ModuleAddress + offset.value());
+                    entry->SetKnownOffset(offset.value());
+                    return true;
+                });
+            }
+
+            // Entries of one module almost always share a scope; scan once per distinct scope
+            std::vector<const ScanScope*> scopes;
+            for (const AddressEntry* entry : entries) {
+                if (std::ranges::none_of(scopes, [&](const ScanScope* scope) { return *scope == entry->Scope; }))
+                    scopes.push_back(&entry->Scope);
+            }
+
+            for (const ScanScope* scope : scopes) {
+                std::vector<AddressEntry*> group;
+                std::vector<ScanJob> jobs;
+                for (AddressEntry* entry : entries) {
+                    if (entry->Scope != *scope)
+                        continue;
+                    group.push_back(entry);
+                    jobs.push_back({ entry->GetCompiledPattern(), entry->SkipCount });
+                }
+
+                const auto scannedBase = AddressScanner::ModuleSearch(moduleName, jobs, *scope);
+
+                for (size_t i = 0; i < group.size(); ++i) {
+                    AddressEntry& entry = *group[i];
+                    if (!scannedBase.has_value() || !jobs[i].Address.has_value()) {
+                        Error("[AddressDB] %-17s : signature not found in %ls", entry.SymbolName.c_str(), moduleName.c_str());
+                        markUnresolved(entry);
+                        continue;
+                    }
+
+                    const uintptr_t address = jobs[i].Address.value();
+                    const uintptr_t offset = address - scannedBase.value();
+                    entry.SetModuleBase(scannedBase.value());
+                    entry.SetKnownAddress(address);
+                    entry.SetKnownOffset(offset);
+
+                    if (identity.has_value())
+                        SignatureCache::Store(entry.SymbolName, moduleName,
+                            SignatureCache::HashPattern(*jobs[i].Pattern, entry.SkipCount, entry.Scope),
+                            identity.value(), offset);
+                }
+            }
         }
+
+        if (useCache)
+            SignatureCache::Save();
+
+        return allResolved;
     }
 
     // ---- debug ----
@@ -90,45 +267,94 @@ namespace ByteWeaver {
         Debug("[AddressDB] Database dump complete.\n");
     }
 
-    bool AddressDB::VerifyAll()
+    bool AddressDB::VerifyAll(const VerifyMode mode)
     {
-        bool allGood = true;
+        struct Stale {
+            AddressHandle Handle;
+            AddressEntry Resolved;
+            uintptr_t OldAddress;
+            uintptr_t OldModuleBase;
+            uintptr_t OldOffset;
+            bool Updated = false;
+        };
 
         Debug("[AddressDB] Verifying all entries...");
 
-        for (auto& [key, entry] : Mutate())
+        // Check under the shared lock; entries that fail are copied out to be resolved again
+        std::vector<Stale> stale;
         {
-            if (entry.Verify()) {
-                Debug("[AddressDB] %-17s : OK (" ADDR_FMT ")",
-                    entry.SymbolName.c_str(),
-                    entry.TargetAddress);
-                continue;
+            std::shared_lock lock(_Mutex);
+            for (const auto& [key, entry] : _Database) {
+                const bool valid = mode == VerifyMode::Full ? entry.Verify() : entry.VerifyResolved();
+                if (valid) {
+                    Debug("[AddressDB] %-17s : OK (" ADDR_FMT ")",
+                        entry.SymbolName.c_str(),
+                        entry.TargetAddress);
+                    continue;
+                }
+                stale.push_back({ _Database.HandleOf(_Database.Find(key.first, key.second)), entry,
+                    entry.TargetAddress, entry.ModuleAddress, entry.KnownOffset.value_or(0) });
             }
+        }
 
-            allGood = false;
-
-            const uintptr_t oldAddress = entry.TargetAddress;
-            const uintptr_t oldModuleBase = entry.ModuleAddress;
-            const uintptr_t oldOffset = entry.KnownOffset.value_or(0);
+        // Resolve without any lock: readers and writers keep going while we scan
+        for (Stale& item : stale)
+            item.Updated = item.Resolved.Update().has_value();
 
-            if (const auto updatedAddress = entry.Update(); updatedAddress.has_value()) {
-                Warn("[AddressDB] %-17s : UPDATED -> " ADDR_FMT " (was " ADDR_FMT ")",
-                    entry.SymbolName.c_str(),
-                    updatedAddress.value(),
-                    oldAddress);
+        // An entry still matches its snapshot if nothing it resolves from, and nothing it resolved to, changed.
+        // Add() replaces an entry in place and keeps its handles, so the handle alone does not prove that.
+        auto unchanged = [](const AddressEntry& entry, const Stale& item) {
+            const AddressEntry& snapshot = item.Resolved;
+            return entry.IsSymbolExport == snapshot.IsSymbolExport && entry.ScanPattern == snapshot.ScanPattern &&
+                entry.SkipCount == snapshot.SkipCount && entry.Scope == snapshot.Scope &&
+                entry.KnownOffset.value_or(0) == item.OldOffset && entry.ModuleAddress == item.OldModuleBase &&
+                entry.TargetAddress == item.OldAddress;
+        };
 
-                Debug("[AddressDB] %-17s : base " ADDR_FMT " -> " ADDR_FMT ", offset 0x%llx -> 0x%llx",
-                    entry.SymbolName.c_str(),
-                    oldModuleBase,
-                    entry.ModuleAddress,
-                    oldOffset,
-                    entry.KnownOffset.value_or(0));
+        // Publish, skipping entries that were removed, replaced or updated meanwhile
+        {
+            std::unique_lock lock(_Mutex);
+            for (const Stale& item : stale) {
+                const auto record = _Database.Resolve(item.Handle);
+                if (!item.Updated || !record || !unchanged(record->second, item))
+                    continue;
+                AddressEntry& entry = record->second;
+                entry.ModuleAddress = item.Resolved.ModuleAddress;
+                entry.TargetAddress = item.Resolved.TargetAddress;
+                entry.KnownOffset = item.Resolved.KnownOffset;
             }
-            else {
+        }
+
+        // The incremental check can reject an entry whose fresh resolution lands on the same address
+        bool allGood = true;
+        for (const Stale& item : stale) {
+            const AddressEntry& entry = item.Resolved;
+            if (!item.Updated) {
+                allGood = false;
                 Error("[AddressDB] %-17s : VERIFY FAILED and UPDATE FAILED (module=%ls)",
                     entry.SymbolName.c_str(),
                     entry.ModuleName.c_str());
+                continue;
+            }
+            if (mode == VerifyMode::Incremental && entry.TargetAddress == item.OldAddress && entry.ModuleAddress == item.OldModuleBase) {
+                Debug("[AddressDB] %-17s : OK after rescan (" ADDR_FMT ")",
+                    entry.SymbolName.c_str(),
+                    entry.TargetAddress);
+                continue;
             }
+
+            allGood = false;
+            Warn("[AddressDB] %-17s : UPDATED -> " ADDR_FMT " (was " ADDR_FMT ")",
+                entry.SymbolName.c_str(),
+                entry.TargetAddress,
+                item.OldAddress);
+
+            Debug("[AddressDB] %-17s : base " ADDR_FMT " -> " ADDR_FMT ", offset 0x%llx -> 0x%llx",
+                entry.SymbolName.c_str(),
+                item.OldModuleBase,
+                entry.ModuleAddress,
+                item.OldOffset,
+                entry.KnownOffset.value_or(0));
         }
 
         if (allGood) {
@@ -2,6 +2,8 @@
 
 #include <AddressEntry.h>
 #include <AddressScanner.h>
+#include <ModuleRegistry.h>
+#include <SignatureCache.h>
 
 namespace ByteWeaver {
 
@@ -30,9 +32,13 @@ namespace ByteWeaver {
 
     AddressEntry AddressEntry::WithScanPattern(std::string symbolName,
         std::wstring moduleName,
-        const std::string& pattern) {
+        const std::string& pattern,
+        const size_t skipCount,
+        ScanScope scope) {
         AddressEntry entry(std::move(symbolName), std::move(moduleName));
         entry.SetScanPattern(pattern);
+        entry.SkipCount = skipCount;
+        entry.Scope = std::move(scope);
         entry.IsSymbolExport = false;
         return entry;
     }
@@ -52,7 +58,11 @@ namespace ByteWeaver {
 
     void AddressEntry::SetScanPattern(const std::string& pattern) {
         this->ScanPattern = pattern;
-        this->_ScanBytes = AddressScanner::ParsePattern(pattern);
+        this->_CompiledPattern = CompiledPattern::Parse(pattern);
+    }
+
+    void AddressEntry::SetScanPattern(CompiledPattern pattern) {
+        this->_CompiledPattern = std::move(pattern);
     }
 
     // --- Accessors ---
@@ -70,8 +80,8 @@ namespace ByteWeaver {
             Error("[AddressEntry] Failed to lookup address by symbolName for %s", SymbolName.c_str());
         }
         // Case 3: pattern scan
-        else if (_ScanBytes.has_value()) {
-            if (auto scan = AddressScanner::ModuleSearch(ModuleName, SymbolName, _ScanBytes.value()); scan.has_value()) {
+        else if (_CompiledPattern.has_value()) {
+            if (auto scan = AddressScanner::ModuleSearch(ModuleName, SymbolName, _CompiledPattern.value(), SkipCount, Scope); scan.has_value()) {
                 auto& [moduleBase, sigAddress, offset] = scan.value();
                 SetModuleBase(moduleBase);
                 SetKnownAddress(sigAddress);
@@ -86,13 +96,13 @@ namespace ByteWeaver {
         }
         // Case 4: moduleName + offset
         else if (!ModuleName.empty() && KnownOffset.value_or(0) > 0) {
-            HMODULE hMod = GetModuleHandleW(ModuleName.c_str());
-            if (!hMod) {
+            const auto module = ModuleRegistry::Find(ModuleName);
+            if (!module) {
                 Error("[AddressScanner] Module %ls not loaded yet.", ModuleName.c_str());
                 return std::nullopt;
             }
-            SetModuleBase(reinterpret_cast<uintptr_t>(hMod));
-            SetKnownAddress(reinterpret_cast<uintptr_t>(hMod) + KnownOffset.value());
+            SetModuleBase(reinterpret_cast<uintptr_t>(module->Base));
+            SetKnownAddress(reinterpret_cast<uintptr_t>(module->Base) + KnownOffset.value());
             return TargetAddress;
         }
 
@@ -118,8 +128,8 @@ namespace ByteWeaver {
         }
         // Case 3: pattern scan
         else
-            if (_ScanBytes.has_value()) {
-                if (auto scan = AddressScanner::ModuleSearch(ModuleName, SymbolName, _ScanBytes.value()); scan.has_value()) {
+            if (_CompiledPattern.has_value()) {
+                if (auto scan = AddressScanner::ModuleSearch(ModuleName, SymbolName, _CompiledPattern.value(), SkipCount, Scope); scan.has_value()) {
                     auto& [moduleBase, sigAddress, offset] = scan.value();
                     Warn("[AddressEntry] Warning: const access against non-updated entry (%s). consider calling entry::Update()", SymbolName.c_str());
                     return sigAddress;
@@ -129,12 +139,12 @@ namespace ByteWeaver {
             // Case 4: moduleName + offset
             else
                 if (!ModuleName.empty() && KnownOffset.value_or(0) > 0) {
-                    HMODULE hMod = GetModuleHandleW(ModuleName.c_str());
-                    if (!hMod) {
+                    const auto module = ModuleRegistry::Find(ModuleName);
+                    if (!module) {
                         Error("[AddressScanner] Module %ls not loaded yet.", ModuleName.c_str());
                         return std::nullopt;
                     }
-                    return reinterpret_cast<uintptr_t>(hMod) + KnownOffset.value();
+                    return reinterpret_cast<uintptr_t>(module->Base) + KnownOffset.value();
                 }
 
         Error("[AddressEntry] Complete failure to find address for symbol %s", SymbolName.c_str());
@@ -166,7 +176,7 @@ namespace ByteWeaver {
         Debug("[AddressEntry]  - Module Name   : %ls", ModuleName.c_str());
         Debug("[AddressEntry]  - Module Base   : " ADDR_FMT, ModuleAddress);
         Debug("[AddressEntry]  - Offset        : 0x%llx", KnownOffset.value_or(0));
-        Debug("[AddressEntry]  - Final Address : " ADDR_FMT, GetAddress());
+        Debug("[AddressEntry]  - Final Address : " ADDR_FMT, GetAddress().value_or(0));
     }
 
     bool AddressEntry::Verify() const
@@ -190,8 +200,8 @@ namespace ByteWeaver {
 
         // Case 3: pattern scan
         else
-            if (_ScanBytes.has_value()) {
-                auto search = AddressScanner::ModuleSearch(ModuleName, SymbolName, _ScanBytes.value());
+            if (_CompiledPattern.has_value()) {
+                auto search = AddressScanner::ModuleSearch(ModuleName, SymbolName, _CompiledPattern.value(), SkipCount, Scope);
                 if (!search.has_value()) {
                     Error("[AddressEntry] Failed to search module for pattern matching symbol %s!", SymbolName.c_str());
                     return false;
@@ -211,4 +221,27 @@ namespace ByteWeaver {
 
         return false;
     }
+
+    bool AddressEntry::VerifyResolved() const
+    {
+        if (!TargetAddress)
+            return false;
+
+        // A hardcoded address has nothing to be checked against
+        if (!IsSymbolExport && !_CompiledPattern.has_value() && !KnownOffset.has_value())
+            return true;
+
+        // The module must still be mapped where the entry was resolved
+        const auto module = ModuleRegistry::Find(ModuleName);
+        if (!module || reinterpret_cast<uintptr_t>(module->Base) != ModuleAddress || !module->Contains(TargetAddress))
+            return false;
+
+        if (IsSymbolExport) {
+            const auto exports = module->Exports();
+            return exports && exports->FindByName(SymbolName) == TargetAddress;
+        }
+        if (_CompiledPattern.has_value())
+            return SignatureCache::Verify(module->Base, TargetAddress - ModuleAddress, _CompiledPattern.value());
+        return TargetAddress == ModuleAddress + KnownOffset.value();
+    }
 }
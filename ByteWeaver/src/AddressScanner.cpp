@@ -1,6 +1,9 @@
 // Copyright(C) 2025 0xKate - MIT License
 
 #include <AddressScanner.h>
+#include <ModuleRegistry.h>
+#include <ParallelScan.h>
+#include <ScanEngine.h>
 
 namespace ByteWeaver {
 #ifndef BYTEWEAVER_ENABLE_PATTERN_SCAN_LOGGING
@@ -22,59 +25,244 @@ namespace ByteWeaver {
         return pattern;
     }
 
+    // Runs one guarded scan; a fault only aborts the region being scanned
+    static std::optional<size_t> GuardedFind(const uint8_t* base, const size_t size, const CompiledPattern& pattern,
+                                             const size_t skipCount, size_t* skipped)
+    {
+        __try {
+            return ScanEngine::Find(base, size, pattern, skipCount, skipped);
+        }
+        __except (EXCEPTION_EXECUTE_HANDLER)
+        {
+            Error("[AddressScanner] Caught an exception: code=0x%X", GetExceptionCode());
+        }
+
+        return std::nullopt;
+    }
+
+    // Collects the offsets of up to `want` matches in a region; guarded like GuardedFind
+    static size_t CollectMatches(const uint8_t* base, const size_t size, const CompiledPattern& pattern,
+                                 const size_t want, size_t* offsets)
+    {
+        size_t count = 0;
+        __try {
+            size_t from = 0;
+            while (count < want) {
+                const auto found = ScanEngine::Find(base + from, size - from, pattern);
+                if (!found.has_value())
+                    break;
+                offsets[count++] = from + found.value();
+                from += found.value() + 1;
+            }
+        }
+        __except (EXCEPTION_EXECUTE_HANDLER)
+        {
+            Error("[AddressScanner] Caught an exception: code=0x%X", GetExceptionCode());
+        }
+        return count;
+    }
+
+    // Skip counts above this are scanned serially; parallel chunks keep up to skipCount + 1 matches each
+    static constexpr size_t MaxParallelSkip = 4096;
+
+    // Parallel counterpart of GuardedFind. Each chunk owns a range of start positions and reads
+    // pattern.Length - 1 bytes past it; merging the per-chunk matches in chunk order preserves
+    // the Nth-match-in-address-order meaning of skipCount.
+    static std::optional<size_t> ParallelFind(const uint8_t* base, const size_t size, const CompiledPattern& pattern,
+                                              const size_t skipCount, size_t* skipped)
+    {
+        if (skipped)
+            *skipped = 0;
+        if (!base || pattern.Length > size)
+            return std::nullopt;
+
+        const size_t chunkSize = ParallelScan::GetOptions().ChunkSize;
+        const size_t positions = size - pattern.Length + 1;
+        const size_t chunkCount = (positions + chunkSize - 1) / chunkSize;
+        const size_t want = skipCount + 1;
+
+        std::vector<size_t> counts(chunkCount, 0);
+        std::vector<size_t> offsets(chunkCount * want);
+
+        const size_t settled = ParallelScan::RunChunks(chunkCount, [&](const size_t chunk) {
+            const size_t begin = chunk * chunkSize;
+            const size_t end = (std::min)(begin + chunkSize, positions);
+            counts[chunk] = CollectMatches(base + begin, end - begin + pattern.Length - 1, pattern, want, &offsets[chunk * want]);
+            return counts[chunk] == want;
+        });
+
+        size_t seen = 0;
+        for (size_t chunk = 0; chunk < chunkCount && chunk <= settled; ++chunk) {
+            if (seen + counts[chunk] > skipCount)
+                return chunk * chunkSize + offsets[chunk * want + (skipCount - seen)];
+            seen += counts[chunk];
+        }
+
+        if (skipped)
+            *skipped = seen;
+        return std::nullopt;
+    }
+
+    static std::optional<size_t> ScanRegion(const uint8_t* base, const size_t size, const CompiledPattern& pattern,
+                                            const size_t skipCount, size_t* skipped)
+    {
+        if (skipCount <= MaxParallelSkip && ParallelScan::ShouldRun(size))
+            return ParallelFind(base, size, pattern, skipCount, skipped);
+        return GuardedFind(base, size, pattern, skipCount, skipped);
+    }
+
+    // Parallel counterpart of AddressScanner::FindSignatures. Every chunk scans with its own
+    // index seeded from the shared one and records what each job consumed; the records are
+    // then replayed into the shared index in chunk order.
+    static bool CanScanInParallel(const MultiPatternIndex& index) {
+        for (size_t j = 0; j < index.Jobs().size(); ++j) {
+            if (index.SkipsLeft(j) > MaxParallelSkip)
+                return false;
+        }
+        return true;
+    }
+
+    static size_t ParallelFindMany(const uint8_t* base, const size_t size, MultiPatternIndex& index)
+    {
+        const std::span<ScanJob> jobs = index.Jobs();
+        size_t maxLength = 0;
+        for (size_t j = 0; j < jobs.size(); ++j) {
+            if (jobs[j].Pattern && !index.IsResolved(j))
+                maxLength = (std::max)(maxLength, jobs[j].Pattern->Length);
+        }
+
+        const size_t pendingBefore = index.Pending();
+        const size_t chunkSize = ParallelScan::GetOptions().ChunkSize;
+        const size_t chunkCount = (size + chunkSize - 1) / chunkSize;
+
+        std::vector<std::vector<ScanJob>> chunkJobs(chunkCount);
+        std::vector<std::optional<MultiPatternIndex>> chunkIndexes(chunkCount);
+
+        const size_t settled = ParallelScan::RunChunks(chunkCount, [&](const size_t chunk) {
+            const size_t begin = chunk * chunkSize;
+            const size_t end = (std::min)(begin + chunkSize, size);
+            const size_t length = (std::min)(end - begin + (maxLength ? maxLength - 1 : 0), size - begin);
+
+            auto& local = chunkJobs[chunk];
+            local.resize(jobs.size());
+            for (size_t j = 0; j < jobs.size(); ++j) {
+                local[j] = { index.IsResolved(j) ? nullptr : jobs[j].Pattern, index.SkipsLeft(j) };
+            }
+
+            auto& localIndex = chunkIndexes[chunk].emplace(local, true);
+            AddressScanner::FindSignatures(const_cast<uint8_t*>(base + begin), length, localIndex);
+
+            // Settled when every pending job found all the matches it needs inside this chunk
+            const auto chunkEnd = reinterpret_cast<uintptr_t>(base + end);
+            for (size_t j = 0; j < local.size(); ++j) {
+                if (!local[j].Pattern)
+                    continue;
+                const auto matches = localIndex.Matches(j);
+                const auto inside = std::ranges::count_if(matches, [&](const uintptr_t address) { return address < chunkEnd; });
+                if (static_cast<size_t>(inside) <= local[j].SkipCount)
+                    return false;
+            }
+            return true;
+        });
+
+        for (size_t chunk = 0; chunk < chunkCount && chunk <= settled && index.Pending() > 0; ++chunk) {
+            const auto chunkEnd = reinterpret_cast<uintptr_t>(base + (std::min)((chunk + 1) * chunkSize, size));
+            for (size_t j = 0; j < jobs.size(); ++j) {
+                if (!chunkJobs[chunk][j].Pattern || index.IsResolved(j))
+                    continue;
+                // Matches starting past the chunk end belong to the next chunk
+                for (const uintptr_t address : chunkIndexes[chunk]->Matches(j)) {
+                    if (address >= chunkEnd || index.Record(j, address))
+                        break;
+                }
+            }
+        }
+
+        return pendingBefore - index.Pending();
+    }
+
     // FindSignature
+    std::optional<uintptr_t> AddressScanner::FindSignature(
+        uint8_t* base,
+        const size_t size,
+        const CompiledPattern& pattern,
+        const size_t skipCount)
+    {
+        // A skipCount of -1 returns the first match
+        const size_t skip = skipCount == static_cast<size_t>(-1) ? 0 : skipCount;
+
+        if (const auto offset = ScanRegion(base, size, pattern, skip, nullptr); offset.has_value())
+            return reinterpret_cast<uintptr_t>(base + offset.value());
+
+        return std::nullopt;
+    }
+
+    std::optional<uintptr_t> AddressScanner::FindSignature(
+        uint8_t* moduleBase,
+        const std::span<const ScanRange> ranges,
+        const CompiledPattern& pattern,
+        const size_t skipCount)
+    {
+        size_t remaining = skipCount == static_cast<size_t>(-1) ? 0 : skipCount;
+
+        for (const auto& [offset, size] : ranges) {
+            size_t skipped = 0;
+            if (const auto found = ScanRegion(moduleBase + offset, size, pattern, remaining, &skipped); found.has_value())
+                return reinterpret_cast<uintptr_t>(moduleBase + offset + found.value());
+            remaining -= skipped;
+        }
+
+        return std::nullopt;
+    }
+
     std::optional<uintptr_t> AddressScanner::FindSignature(
         uint8_t* base,
         const size_t size,
         const std::vector<std::optional<uint8_t>>& pattern,
         const size_t skipCount)
     {
-        const size_t patternSize = pattern.size();
+        return FindSignature(base, size, CompiledPattern::FromBytes(pattern), skipCount);
+    }
 
+    size_t AddressScanner::FindSignatures(uint8_t* base, const size_t size, MultiPatternIndex& index)
+    {
         __try {
-            size_t foundCount = 0;
-            for (size_t i = 0; i <= size - patternSize; ++i) {
-                bool match = true;
-                for (size_t j = 0; j < patternSize; ++j) {
-                    if (pattern[j].has_value() && base[i + j] != pattern[j].value()) {
-                        match = false;
-                        break;
-                    }
-                }
-
-                if (match) {
-                    if (skipCount != -1)
-                        if (foundCount < skipCount) {
-                            ++foundCount;
-                            continue;
-                        }
-                    return reinterpret_cast<uintptr_t>(&base[i]);
-                }
-            }
+            return ScanEngine::FindMany(base, size, index);
         }
         __except (EXCEPTION_EXECUTE_HANDLER)
         {
             Error("[AddressScanner] Caught an exception: code=0x%X", GetExceptionCode());
         }
 
-        return std::nullopt;
+        return 0;
+    }
+
+    static uint8_t* GetLoadedImage(const std::wstring& moduleName, size_t* moduleSize) {
+        const auto module = ModuleRegistry::Find(moduleName);
+        if (!module) {
+            Error("[AddressScanner] Module %ls not loaded yet.", moduleName.c_str());
+            return nullptr;
+        }
+
+        *moduleSize = module->Size;
+        return module->Base;
     }
 
     // ModuleSearch
-    SearchResults AddressScanner::ModuleSearch(const std::wstring& moduleName, const std::string& symbolName, const std::vector<std::optional<uint8_t>>& pattern, const size_t skipCount)
+    SearchResults AddressScanner::ModuleSearch(const std::wstring& moduleName, const std::string& symbolName, const CompiledPattern& pattern, const size_t skipCount, const ScanScope& scope)
     {
-        const HMODULE hMod = GetModuleHandleW(moduleName.c_str());
-        if (!hMod) {
-            Error("[AddressScanner] Module %ls not loaded yet.", moduleName.c_str());
+        size_t moduleSize = 0;
+        uint8_t* modulePointer = GetLoadedImage(moduleName, &moduleSize);
+        if (!modulePointer)
             return std::nullopt;
-        }
 
-        auto modulePointer = reinterpret_cast<uint8_t*>(hMod);
-        const auto dos = reinterpret_cast<IMAGE_DOS_HEADER*>(modulePointer);
-        const auto nt = reinterpret_cast<IMAGE_NT_HEADERS64*>(modulePointer + dos->e_lfanew);
-        const size_t moduleSize = nt->OptionalHeader.SizeOfImage;
+        const std::vector<ScanRange> ranges = scope.Resolve(modulePointer);
+        if (ranges.empty()) {
+            Error("[AddressScanner] %s: scan scope '%s' matches nothing in module %ls", symbolName.c_str(), scope.Describe().c_str(), moduleName.c_str());
+            return std::nullopt;
+        }
 
-        if (auto sigAddress = FindSignature(modulePointer, moduleSize, pattern, skipCount); sigAddress.has_value()) {
+        if (auto sigAddress = FindSignature(modulePointer, ranges, pattern, skipCount); sigAddress.has_value()) {
             uintptr_t moduleAddress = reinterpret_cast<uintptr_t>(modulePointer);
             uintptr_t offset = sigAddress.value() - moduleAddress;
             if constexpr (BYTEWEAVER_ENABLE_PATTERN_SCAN_LOGGING)
@@ -83,12 +271,14 @@ namespace ByteWeaver {
                     " Module: % ls\n"
                     " Base Address : " ADDR_FMT 
                     " Module Size  : 0x%zu\n"
+                    " Scan Scope   : %s\n"
                     " Sig Address  : " ADDR_FMT 
                     " Offset       : 0x%llx\n",
                     symbolName.c_str(),
                     moduleName.c_str(),
                     moduleAddress,
                     moduleSize,
+                    scope.Describe().c_str(),
                     sigAddress.value(),
                     offset
                 );
@@ -98,33 +288,64 @@ namespace ByteWeaver {
         return std::nullopt;
     }
 
+    // ModuleSearch
+    std::optional<uintptr_t> AddressScanner::ModuleSearch(const std::wstring& moduleName, const std::span<ScanJob> jobs, const ScanScope& scope)
+    {
+        size_t moduleSize = 0;
+        uint8_t* modulePointer = GetLoadedImage(moduleName, &moduleSize);
+        if (!modulePointer)
+            return std::nullopt;
+
+        const std::vector<ScanRange> ranges = scope.Resolve(modulePointer);
+        if (ranges.empty())
+            Error("[AddressScanner] Scan scope '%s' matches nothing in module %ls", scope.Describe().c_str(), moduleName.c_str());
+
+        MultiPatternIndex index(jobs);
+        size_t found = 0;
+        for (const auto& [offset, size] : ranges) {
+            found += ParallelScan::ShouldRun(size) && CanScanInParallel(index)
+                ? ParallelFindMany(modulePointer + offset, size, index)
+                : FindSignatures(modulePointer + offset, size, index);
+            if (index.Pending() == 0)
+                break;
+        }
+
+        if constexpr (BYTEWEAVER_ENABLE_PATTERN_SCAN_LOGGING)
+            Debug("[AddressScanner] Batch scan of %ls (%s) resolved %zu/%zu signatures.",
+                moduleName.c_str(), scope.Describe().c_str(), found, jobs.size());
+
+        return reinterpret_cast<uintptr_t>(modulePointer);
+    }
+
+    SearchResults AddressScanner::ModuleSearch(const std::wstring& moduleName, const std::string& symbolName, const std::vector<std::optional<uint8_t>>& pattern, const size_t skipCount) {
+        return ModuleSearch(moduleName, symbolName, CompiledPattern::FromBytes(pattern), skipCount);
+    }
+
     // ModuleSearch
     SearchResults AddressScanner::ModuleSearch(const std::wstring& moduleName, const std::string& symbolName, const std::string& signature, const size_t skipCount) {
-        const std::vector<std::optional<uint8_t>> pattern = ParsePattern(signature);
-        return ModuleSearch(moduleName, symbolName, pattern, skipCount);
+        return ModuleSearch(moduleName, symbolName, CompiledPattern::Parse(signature), skipCount);
     }
 
     // LookupExportAddress
     SearchResults AddressScanner::LookupExportAddress(const std::wstring& moduleName, const std::string& symbolName)
     {
-        HMODULE hMod = GetModuleHandleW(moduleName.c_str());
-        if (!hMod) {
+        const auto module = ModuleRegistry::Find(moduleName);
+        if (!module) {
             Error("[AddressScanner] Module %ls not loaded yet.", moduleName.c_str());
             return std::nullopt;
         }
 
-        FARPROC address = GetProcAddress(hMod, symbolName.c_str());
+        const auto exports = module->Exports();
+        const auto resolved = exports ? exports->FindByName(symbolName) : std::nullopt;
+        const auto address = reinterpret_cast<void*>(resolved.value_or(0));
         if (!address) {
             Error("[AddressScanner] Failed to find symbol %s in module %ls y !", symbolName.c_str(), moduleName.c_str());
             return std::nullopt;
         }
 
         if constexpr (BYTEWEAVER_ENABLE_PATTERN_SCAN_LOGGING) {
-            auto modulePointer = reinterpret_cast<uint8_t*>(hMod);
-            auto dos = reinterpret_cast<IMAGE_DOS_HEADER*>(modulePointer);
-            auto nt = reinterpret_cast<IMAGE_NT_HEADERS64*>(modulePointer + dos->e_lfanew);
-            size_t moduleSize = nt->OptionalHeader.SizeOfImage;
-            uintptr_t moduleAddress = reinterpret_cast<uintptr_t>(modulePointer);
+            size_t moduleSize = module->Size;
+            uintptr_t moduleAddress = reinterpret_cast<uintptr_t>(module->Base);
             uintptr_t offset = reinterpret_cast<uintptr_t>(address) - moduleAddress;
 
             Debug(
@@ -143,6 +364,7 @@ namespace ByteWeaver {
             );
         }
 
-        return std::tuple(reinterpret_cast<uintptr_t>(hMod), reinterpret_cast<uintptr_t>(address), reinterpret_cast<uintptr_t>(address) - reinterpret_cast<uintptr_t>(hMod));
+        const auto moduleBase = reinterpret_cast<uintptr_t>(module->Base);
+        return std::tuple(moduleBase, reinterpret_cast<uintptr_t>(address), reinterpret_cast<uintptr_t>(address) - moduleBase);
     }
 }
\ No newline at end of file
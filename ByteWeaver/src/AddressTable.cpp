@@ -0,0 +1,150 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include <AddressTable.h>
+
+namespace ByteWeaver {
+
+    static constexpr size_t MinBuckets = 64;
+
+    // ---- modules ----
+    uint32_t AddressTable::FindModule(const std::wstring_view moduleName) const {
+        const auto it = _ModuleIds.find(moduleName);
+        return it == _ModuleIds.end() ? NotFound : it->second;
+    }
+
+    uint32_t AddressTable::InternModule(const std::wstring_view moduleName) {
+        if (const uint32_t id = FindModule(moduleName); id != NotFound)
+            return id;
+        const auto id = static_cast<uint32_t>(_ModuleIds.size());
+        _ModuleIds.emplace(std::wstring(moduleName), id);
+        return id;
+    }
+
+    // ---- lookup ----
+    uint64_t AddressTable::Hash(const std::string_view symbolName, const uint32_t moduleId) noexcept {
+        return Hash(SymbolHash(symbolName), moduleId);
+    }
+
+    uint64_t AddressTable::Hash(const uint64_t symbolHash, const uint32_t moduleId) noexcept {
+        // FNV-1a over the symbol (SymbolHash), then a splitmix finalizer with the module folded in
+        uint64_t hash = symbolHash ^ static_cast<uint64_t>(moduleId) * 0x9e3779b97f4a7c15ULL;
+        hash ^= hash >> 30;
+        hash *= 0xbf58476d1ce4e5b9ULL;
+        hash ^= hash >> 27;
+        hash *= 0x94d049bb133111ebULL;
+        return hash ^ (hash >> 31);
+    }
+
+    uint32_t AddressTable::Find(const std::string_view symbolName, const uint32_t moduleId, const uint64_t hash) const {
+        if (_Buckets.empty() || moduleId == NotFound)
+            return NotFound;
+
+        const size_t mask = _Buckets.size() - 1;
+        for (size_t bucket = BucketOf(hash);; bucket = (bucket + 1) & mask) {
+            const uint32_t value = _Buckets[bucket];
+            if (value == EmptyBucket)
+                return NotFound;
+            if (value == Tombstone)
+                continue;
+
+            const Slot& slot = _Slots[value - 1];
+            if (slot.Hash == hash && slot.ModuleId == moduleId && slot.Value->first.first == symbolName)
+                return value - 1;
+        }
+    }
+
+    uint32_t AddressTable::Find(const std::string_view symbolName, const std::wstring_view moduleName) const {
+        const uint32_t moduleId = FindModule(moduleName);
+        return moduleId == NotFound ? NotFound : Find(symbolName, moduleId, Hash(symbolName, moduleId));
+    }
+
+    // ---- mutation ----
+    uint32_t AddressTable::InsertOrAssign(Key key, AddressEntry entry) {
+        const uint32_t moduleId = InternModule(key.second);
+        const uint64_t hash = Hash(key.first, moduleId);
+
+        // Replaced in place: the address of the entry and its handles stay valid
+        if (const uint32_t existing = Find(key.first, moduleId, hash); existing != NotFound) {
+            Slot& slot = _Slots[existing];
+            slot.Value.reset();
+            slot.Value.emplace(std::move(key), std::move(entry));
+            return existing;
+        }
+
+        // Keep the load (tombstones included) at or below 3/4 so probe runs stay short
+        if ((_Count + _Tombstones + 1) * 4 > _Buckets.size() * 3)
+            Rehash((std::max)(MinBuckets, std::bit_ceil((_Count + 1) * 2)));
+
+        uint32_t index;
+        if (!_FreeSlots.empty()) {
+            index = _FreeSlots.back();
+            _FreeSlots.pop_back();
+        }
+        else {
+            index = static_cast<uint32_t>(_Slots.size());
+            _Slots.emplace_back();
+        }
+
+        Slot& slot = _Slots[index];
+        slot.Value.emplace(std::move(key), std::move(entry));
+        slot.Hash = hash;
+        slot.ModuleId = moduleId;
+
+        const size_t mask = _Buckets.size() - 1;
+        size_t bucket = BucketOf(hash);
+        while (_Buckets[bucket] != EmptyBucket && _Buckets[bucket] != Tombstone)
+            bucket = (bucket + 1) & mask;
+        if (_Buckets[bucket] == Tombstone)
+            --_Tombstones;
+        _Buckets[bucket] = index + 1;
+        ++_Count;
+        return index;
+    }
+
+    void AddressTable::Erase(const uint32_t index) {
+        Slot& slot = _Slots[index];
+        if (!slot.Value)
+            return;
+
+        const size_t mask = _Buckets.size() - 1;
+        size_t bucket = BucketOf(slot.Hash);
+        while (_Buckets[bucket] != index + 1)
+            bucket = (bucket + 1) & mask;
+        _Buckets[bucket] = Tombstone;
+        ++_Tombstones;
+
+        slot.Value.reset();
+        ++slot.Generation;
+        _FreeSlots.push_back(index);
+        --_Count;
+    }
+
+    void AddressTable::Clear() {
+        _FreeSlots.clear();
+        for (uint32_t i = static_cast<uint32_t>(_Slots.size()); i-- > 0;) {
+            if (_Slots[i].Value) {
+                _Slots[i].Value.reset();
+                ++_Slots[i].Generation;
+            }
+            _FreeSlots.push_back(i);
+        }
+        std::ranges::fill(_Buckets, EmptyBucket);
+        _Count = 0;
+        _Tombstones = 0;
+    }
+
+    void AddressTable::Rehash(const size_t bucketCount) {
+        _Buckets.assign(bucketCount, EmptyBucket);
+        _Tombstones = 0;
+
+        const size_t mask = bucketCount - 1;
+        for (uint32_t i = 0; i < _Slots.size(); ++i) {
+            if (!_Slots[i].Value)
+                continue;
+            size_t bucket = BucketOf(_Slots[i].Hash);
+            while (_Buckets[bucket] != EmptyBucket)
+                bucket = (bucket + 1) & mask;
+            _Buckets[bucket] = i + 1;
+        }
+    }
+}
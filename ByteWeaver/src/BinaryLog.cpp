@@ -0,0 +1,179 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include <BinaryLog.h>
+
+namespace ByteWeaver {
+
+    using namespace BinaryLogFormat;
+
+    // Records are appended to this buffer and handed to the file or sink in large chunks
+    static constexpr size_t StreamBufferSize = 64 * 1024;
+
+    // ---- static storage ----
+    struct BinaryLogState {
+        std::mutex Mutex;
+        std::ofstream File;
+        BinaryLog::Sink Sink;
+        std::vector<uint8_t> Buffer;
+        std::unordered_map<const char*, uint32_t> FormatIds;
+        uint32_t NextFormatId = 1;
+        uint64_t Records = 0;
+        std::atomic<uint64_t> Session{ 0 };
+    };
+
+    // Never destroyed: hooks may still log while static destructors run
+    static BinaryLogState& State() {
+        static auto* state = new BinaryLogState();
+        return *state;
+    }
+
+    // ---- helpers ----
+    static void FlushLocked(BinaryLogState& state) {
+        if (state.Buffer.empty())
+            return;
+        if (state.Sink)
+            state.Sink(state.Buffer.data(), state.Buffer.size());
+        else if (state.File.is_open())
+            state.File.write(reinterpret_cast<const char*>(state.Buffer.data()), static_cast<std::streamsize>(state.Buffer.size()));
+        state.Buffer.clear();
+    }
+
+    static void Append(BinaryLogState& state, const RecordHeader& header, const void* payload, const size_t size) {
+        if (state.Buffer.size() + header.Size > StreamBufferSize)
+            FlushLocked(state);
+        const auto bytes = reinterpret_cast<const uint8_t*>(&header);
+        state.Buffer.insert(state.Buffer.end(), bytes, bytes + sizeof(header));
+        const auto data = static_cast<const uint8_t*>(payload);
+        state.Buffer.insert(state.Buffer.end(), data, data + size);
+    }
+
+    static void Begin(BinaryLogState& state) {
+        LARGE_INTEGER frequency, counter;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&counter);
+
+        FileHeader header{};
+        memcpy(header.Magic, Magic, sizeof(Magic));
+        header.Version = Version;
+        header.ProcessId = GetCurrentProcessId();
+        header.TimestampFrequency = static_cast<uint64_t>(frequency.QuadPart);
+        header.TimestampBase = static_cast<uint64_t>(counter.QuadPart);
+
+        state.Buffer.clear();
+        state.Buffer.reserve(StreamBufferSize);
+        const auto bytes = reinterpret_cast<const uint8_t*>(&header);
+        state.Buffer.insert(state.Buffer.end(), bytes, bytes + sizeof(header));
+        state.FormatIds.clear();
+        state.NextFormatId = 1;
+        state.Records = 0;
+        state.Session.fetch_add(1);
+        BinaryLogEnabled.store(true);
+    }
+
+    static void End(BinaryLogState& state) {
+        BinaryLogEnabled.store(false);
+        FlushLocked(state);
+        if (state.File.is_open())
+            state.File.close();
+        state.Sink = nullptr;
+    }
+
+    // ---- lifetime ----
+    bool BinaryLog::Open(const fs::path& path) {
+        BinaryLogState& state = State();
+        std::lock_guard lock(state.Mutex);
+        End(state);
+
+        state.File.open(path, std::ios::binary | std::ios::trunc);
+        if (!state.File.is_open()) {
+            Error("[BinaryLog] Unable to create %ls", path.c_str());
+            return false;
+        }
+        Begin(state);
+        return true;
+    }
+
+    void BinaryLog::Open(Sink sink) {
+        BinaryLogState& state = State();
+        std::lock_guard lock(state.Mutex);
+        End(state);
+        state.Sink = std::move(sink);
+        Begin(state);
+    }
+
+    void BinaryLog::Close() {
+        BinaryLogState& state = State();
+        std::lock_guard lock(state.Mutex);
+        End(state);
+    }
+
+    void BinaryLog::Flush() {
+        BinaryLogState& state = State();
+        std::lock_guard lock(state.Mutex);
+        FlushLocked(state);
+        if (state.File.is_open())
+            state.File.flush();
+    }
+
+    bool BinaryLog::IsOpen() {
+        return BinaryLogEnabled.load();
+    }
+
+    uint64_t BinaryLog::RecordCount() {
+        BinaryLogState& state = State();
+        std::lock_guard lock(state.Mutex);
+        return state.Records;
+    }
+
+    // ---- records ----
+    void WriteBinaryLog(const int level, const char* fmt, const uint8_t* args, const size_t size) {
+        BinaryLogState& state = State();
+
+        LARGE_INTEGER counter;
+        QueryPerformanceCounter(&counter);
+
+        RecordHeader header{};
+        header.Kind = RecordKind::Message;
+        header.Level = static_cast<uint8_t>(level);
+        header.Timestamp = static_cast<uint64_t>(counter.QuadPart);
+        header.ThreadId = GetCurrentThreadId();
+        header.Size = static_cast<uint16_t>(sizeof(header) + size);
+
+        // Ids of the formats this thread already used in the current stream
+        thread_local std::unordered_map<const char*, uint32_t> knownIds;
+        thread_local uint64_t knownSession = 0;
+        if (const uint64_t session = state.Session.load(std::memory_order_relaxed); knownSession != session) {
+            knownIds.clear();
+            knownSession = session;
+        }
+        if (const auto it = knownIds.find(fmt); it != knownIds.end())
+            header.FormatId = it->second;
+
+        std::lock_guard lock(state.Mutex);
+        if (!BinaryLogEnabled.load(std::memory_order_relaxed))
+            return;
+        if (knownSession != state.Session.load(std::memory_order_relaxed)) {
+            // The stream was reopened after the check above; ids from the old one are meaningless
+            header.FormatId = 0;
+        }
+
+        if (header.FormatId == 0) {
+            auto [it, added] = state.FormatIds.try_emplace(fmt, state.NextFormatId);
+            if (added) {
+                ++state.NextFormatId;
+                const size_t length = (std::min)(strlen(fmt), MaxPayload);
+                RecordHeader definition = header;
+                definition.Kind = RecordKind::Format;
+                definition.FormatId = it->second;
+                definition.Size = static_cast<uint16_t>(sizeof(definition) + length);
+                Append(state, definition, fmt, length);
+            }
+            header.FormatId = it->second;
+            if (knownSession == state.Session.load(std::memory_order_relaxed))
+                knownIds.emplace(fmt, it->second);
+        }
+
+        Append(state, header, args, size);
+        ++state.Records;
+    }
+}
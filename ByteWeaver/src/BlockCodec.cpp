@@ -0,0 +1,153 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include <BlockCodec.h>
+
+namespace ByteWeaver {
+
+    static constexpr size_t MinMatch = 4;
+    static constexpr size_t LastLiterals = 5;    // the format requires the last 5 bytes to be literals
+    static constexpr size_t MatchFindLimit = 12; // and the last match to start 12 bytes before the end
+    static constexpr size_t MaxOffset = 0xFFFF;
+    static constexpr int HashLog = 16;
+
+    static uint32_t Read32(const uint8_t* p) {
+        uint32_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    static uint32_t HashOf(const uint32_t sequence) {
+        return (sequence * 2654435761U) >> (32 - HashLog);
+    }
+
+    // Writes the 15+ tail of a literal or match length
+    static uint8_t* WriteLength(uint8_t* out, size_t length) {
+        for (; length >= 255; length -= 255)
+            *out++ = 255;
+        *out++ = static_cast<uint8_t>(length);
+        return out;
+    }
+
+    static uint8_t* WriteLiterals(uint8_t* out, uint8_t* token, const uint8_t* literals, const size_t length) {
+        if (length >= 15) {
+            *token = 15 << 4;
+            out = WriteLength(out, length - 15);
+        } else {
+            *token = static_cast<uint8_t>(length << 4);
+        }
+        memcpy(out, literals, length);
+        return out + length;
+    }
+
+    size_t BlockCodec::Compress(const uint8_t* source, const size_t size, uint8_t* destination, const size_t capacity) {
+        if (capacity < CompressBound(size) || size > UINT32_MAX)
+            return 0;
+
+        uint8_t* out = destination;
+        const uint8_t* anchor = source;
+
+        if (size > MatchFindLimit) {
+            // Positions are offsets from source; a stale or zero entry is rejected by the compare below
+            thread_local std::vector<uint32_t> table;
+            table.assign(size_t{ 1 } << HashLog, 0);
+
+            const uint8_t* const end = source + size;
+            const uint8_t* const matchLimit = end - LastLiterals;
+            const uint8_t* const findLimit = end - MatchFindLimit;
+
+            const uint8_t* in = source;
+            while (in <= findLimit) {
+                const uint32_t sequence = Read32(in);
+                uint32_t& slot = table[HashOf(sequence)];
+                const uint8_t* candidate = source + slot;
+                slot = static_cast<uint32_t>(in - source);
+
+                if (candidate >= in || static_cast<size_t>(in - candidate) > MaxOffset || Read32(candidate) != sequence) {
+                    in += 1 + ((in - anchor) >> 6);   // skip faster the longer nothing matches
+                    continue;
+                }
+
+                const uint8_t* matchEnd = in + MinMatch;
+                for (const uint8_t* from = candidate + MinMatch; matchEnd < matchLimit && *matchEnd == *from; ++matchEnd, ++from) {}
+
+                uint8_t* token = out++;
+                out = WriteLiterals(out, token, anchor, static_cast<size_t>(in - anchor));
+
+                const auto offset = static_cast<uint16_t>(in - candidate);
+                *out++ = static_cast<uint8_t>(offset);
+                *out++ = static_cast<uint8_t>(offset >> 8);
+
+                const size_t matchLength = static_cast<size_t>(matchEnd - in) - MinMatch;
+                if (matchLength >= 15) {
+                    *token |= 15;
+                    out = WriteLength(out, matchLength - 15);
+                } else {
+                    *token |= static_cast<uint8_t>(matchLength);
+                }
+
+                in = anchor = matchEnd;
+                if (in - 2 > source && in - 2 <= findLimit)
+                    table[HashOf(Read32(in - 2))] = static_cast<uint32_t>(in - 2 - source);
+            }
+        }
+
+        uint8_t* token = out++;
+        out = WriteLiterals(out, token, anchor, static_cast<size_t>(source + size - anchor));
+        return static_cast<size_t>(out - destination);
+    }
+
+    bool BlockCodec::Decompress(const uint8_t* source, const size_t sourceSize, uint8_t* destination, const size_t size) {
+        const uint8_t* in = source;
+        const uint8_t* const inEnd = source + sourceSize;
+        uint8_t* out = destination;
+        uint8_t* const outEnd = destination + size;
+
+        auto readLength = [&](size_t& length) {
+            uint8_t byte;
+            do {
+                if (in >= inEnd)
+                    return false;
+                byte = *in++;
+                length += byte;
+            } while (byte == 255);
+            return true;
+        };
+
+        while (in < inEnd) {
+            const uint8_t token = *in++;
+
+            size_t literals = token >> 4;
+            if (literals == 15 && !readLength(literals))
+                return false;
+            if (literals > static_cast<size_t>(inEnd - in) || literals > static_cast<size_t>(outEnd - out))
+                return false;
+            memcpy(out, in, literals);
+            in += literals;
+            out += literals;
+
+            if (in == inEnd)
+                break; // the last sequence has no match
+
+            if (inEnd - in < 2)
+                return false;
+            const size_t offset = in[0] | static_cast<size_t>(in[1]) << 8;
+            in += 2;
+            if (offset == 0 || offset > static_cast<size_t>(out - destination))
+                return false;
+
+            size_t matchLength = token & 15;
+            if (matchLength == 15 && !readLength(matchLength))
+                return false;
+            matchLength += MinMatch;
+            if (matchLength > static_cast<size_t>(outEnd - out))
+                return false;
+
+            // Byte by byte: a match may overlap the bytes it produces
+            const uint8_t* from = out - offset;
+            for (size_t i = 0; i < matchLength; ++i)
+                out[i] = from[i];
+            out += matchLength;
+        }
+        return out == outEnd;
+    }
+}
@@ -0,0 +1,63 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include <CompiledPattern.h>
+#include <AddressScanner.h>
+#include <ScanEngine.h>
+
+namespace ByteWeaver {
+
+    CompiledPattern CompiledPattern::FromBytes(const std::vector<std::optional<uint8_t>>& pattern) {
+        CompiledPattern compiled;
+        compiled.Length = pattern.size();
+        compiled.Values.resize(compiled.Length);
+        compiled.Masks.resize(compiled.Length);
+
+        for (size_t j = 0; j < compiled.Length; ++j) {
+            compiled.Values[j] = pattern[j].value_or(0x00);
+            compiled.Masks[j] = pattern[j].has_value() ? 0xFF : 0x00;
+        }
+
+        compiled.Analyse();
+        return compiled;
+    }
+
+    CompiledPattern CompiledPattern::Parse(const std::string& patternStr) {
+        return FromBytes(AddressScanner::ParsePattern(patternStr));
+    }
+
+    bool CompiledPattern::MatchesAt(const uint8_t* location) const {
+        for (size_t j = 0; j < Length; ++j) {
+            if ((location[j] & Masks[j]) != Values[j])
+                return false;
+        }
+        return true;
+    }
+
+    void CompiledPattern::Analyse() {
+        Anchor = ScanEngine::SelectAnchor(Values.data(), Masks.data(), Length);
+        Confirm = ScanEngine::SelectAnchor(Values.data(), Masks.data(), Length, Anchor);
+        if (Confirm == SIZE_MAX)
+            Confirm = Anchor;
+
+        if (Length == 0) {
+            SkipTable.fill(1);
+            return;
+        }
+
+        // Horspool: shift by the distance from the rightmost occurrence (excluding the last
+        // position) to the end. A wildcard matches every byte, so it caps every shift.
+        size_t defaultShift = Length;
+        for (size_t j = 0; j + 1 < Length; ++j) {
+            if (Masks[j] != 0xFF)
+                defaultShift = Length - 1 - j;
+        }
+        SkipTable.fill(static_cast<uint32_t>(defaultShift));
+
+        for (size_t j = 0; j + 1 < Length; ++j) {
+            if (Masks[j] != 0xFF)
+                continue;
+            if (const auto shift = static_cast<uint32_t>(Length - 1 - j); shift < SkipTable[Values[j]])
+                SkipTable[Values[j]] = shift;
+        }
+    }
+}
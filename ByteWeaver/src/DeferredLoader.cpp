@@ -0,0 +1,191 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include <DeferredLoader.h>
+#include <MemoryManager.h>
+
+namespace ByteWeaver {
+
+    // ---- static storage ----
+    std::vector<DeferredLoader::DeferredHook> DeferredLoader::_Hooks{};
+    std::mutex DeferredLoader::_HooksMutex{};
+
+    struct LoaderEvent {
+        ModuleRegistry::ModulePtr Module;
+        bool Loaded = false;
+    };
+
+    struct LoaderState {
+        std::mutex Mutex;
+        std::condition_variable Wake;
+        std::deque<LoaderEvent> Events;
+        std::thread Thread;
+        size_t ListenerId = 0;
+        bool Stopping = false;
+    };
+
+    // Never destroyed: joining from a static destructor would run under the loader lock
+    static LoaderState& State() {
+        static auto* state = new LoaderState();
+        return *state;
+    }
+
+    // ---- lifetime ----
+    void DeferredLoader::Start() {
+        LoaderState& state = State();
+        std::lock_guard lock(state.Mutex);
+        if (state.Thread.joinable())
+            return;
+
+        state.Stopping = false;
+        state.Thread = std::thread(WorkerLoop);
+
+        // Runs under the loader lock: only queues the event
+        state.ListenerId = ModuleRegistry::AddListener([](const ModuleRegistry::ModulePtr& module, const bool loaded) {
+            LoaderState& s = State();
+            {
+                std::lock_guard guard(s.Mutex);
+                s.Events.push_back({ module, loaded });
+            }
+            s.Wake.notify_one();
+        });
+    }
+
+    void DeferredLoader::Stop() {
+        LoaderState& state = State();
+        std::thread thread;
+        {
+            std::lock_guard lock(state.Mutex);
+            if (!state.Thread.joinable())
+                return;
+            ModuleRegistry::RemoveListener(state.ListenerId);
+            state.Stopping = true;
+            thread.swap(state.Thread);
+        }
+        state.Wake.notify_all();
+        thread.join();
+    }
+
+    void DeferredLoader::WorkerLoop() {
+        LoaderState& state = State();
+        for (;;) {
+            LoaderEvent event;
+            {
+                std::unique_lock lock(state.Mutex);
+                state.Wake.wait(lock, [&] { return state.Stopping || !state.Events.empty(); });
+                if (state.Stopping)
+                    return;
+                event = std::move(state.Events.front());
+                state.Events.pop_front();
+            }
+
+            if (event.Loaded)
+                ProcessModule(event.Module->Name);
+            else
+                OnModuleUnloaded(*event.Module);
+        }
+    }
+
+    // ---- hooks ----
+    bool DeferredLoader::DeferHook(std::string modKey, std::string symbolName, std::wstring moduleName, HookInstaller install) {
+        if (!AddressDB::Defer(symbolName, moduleName)) {
+            Error("[DeferredLoader] %s: no AddressDB entry for %s in %ls", modKey.c_str(), symbolName.c_str(), moduleName.c_str());
+            return false;
+        }
+
+        {
+            std::lock_guard lock(_HooksMutex);
+            _Hooks.push_back({ std::move(modKey), { std::move(symbolName), moduleName }, std::move(install) });
+        }
+
+        Start();
+
+        // Already loaded: no notification will come for it
+        if (ModuleRegistry::Find(moduleName))
+            ProcessModule(moduleName);
+        return true;
+    }
+
+    size_t DeferredLoader::ProcessModule(const std::wstring& moduleName) {
+        const auto module = ModuleRegistry::Find(moduleName);
+        if (!module)
+            return 0;
+
+        // Most loads are system DLLs nobody asked for; skip them without taking the write lock
+        bool hasEntries = false;
+        for (const auto& key : AddressDB::Iterate() | std::views::keys) {
+            if (ModuleRegistry::NameMatches(key.second, *module)) {
+                hasEntries = true;
+                break;
+            }
+        }
+        if (!hasEntries)
+            return 0;
+
+        std::vector<AddressDB::Key> unresolved;
+        if (!AddressDB::UpdateModule(module->Name, &unresolved))
+            Warn("[DeferredLoader] %zu entries of %ls did not resolve", unresolved.size(), module->Name.c_str());
+
+        std::lock_guard lock(_HooksMutex);
+        std::vector<DeferredHook*> created;
+        std::vector<std::string> keys;
+        for (DeferredHook& hook : _Hooks) {
+            if (hook.Installed || !ModuleRegistry::NameMatches(hook.Symbol.second, *module))
+                continue;
+
+            // Copied under AddressDB's lock: the entry may be republished or replaced meanwhile
+            const std::optional<uintptr_t> target = AddressDB::TryGetAddress(hook.Symbol.first, hook.Symbol.second);
+            if (!target.has_value()) {
+                Error("[DeferredLoader] %s: %s was not resolved in %ls", hook.ModKey.c_str(), hook.Symbol.first.c_str(), module->Name.c_str());
+                continue;
+            }
+
+            if (!hook.Install(target.value()) || !MemoryManager::ModExists(hook.ModKey)) {
+                Error("[DeferredLoader] %s: failed to install at " ADDR_FMT, hook.ModKey.c_str(), target.value());
+                continue;
+            }
+            created.push_back(&hook);
+            keys.push_back(hook.ModKey);
+        }
+
+        // One batch for the whole module, so other threads are suspended once rather than once per hook.
+        // A detour batch is all or nothing; if it fails, the hooks are retried one by one so a single
+        // bad target does not hold back the rest.
+        std::vector<std::string> failed;
+        if (!keys.empty() && !MemoryManager::ApplyMods(keys, &failed)) {
+            for (const std::string& key : failed)
+                MemoryManager::ApplyMod(key);
+        }
+
+        size_t installed = 0;
+        for (DeferredHook* hook : created) {
+            std::shared_ptr<MemoryModification> mod;
+            if (!MemoryManager::ModExists(hook->ModKey, &mod) || !mod->IsModified) {
+                Error("[DeferredLoader] %s: failed to apply", hook->ModKey.c_str());
+                continue;
+            }
+            hook->Installed = true;
+            ++installed;
+        }
+
+        if (installed)
+            Debug("[DeferredLoader] Installed %zu deferred hooks in %ls", installed, module->Name.c_str());
+        return installed;
+    }
+
+    void DeferredLoader::OnModuleUnloaded(const LoadedModule& module) {
+        std::lock_guard lock(_HooksMutex);
+        for (DeferredHook& hook : _Hooks) {
+            if (!hook.Installed || !ModuleRegistry::NameMatches(hook.Symbol.second, module))
+                continue;
+
+            // The patched code went away with the module; forget the mod so the next load recreates it
+            MemoryManager::EraseMod(hook.ModKey);
+            hook.Installed = false;
+        }
+    }
+
+    size_t DeferredLoader::PendingHooks() {
+        std::lock_guard lock(_HooksMutex);
+        return std::ranges::count_if(_Hooks, [](const DeferredHook& hook) { return !hook.Installed; });
+    }
+}
@@ -0,0 +1,204 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include <ExportIndex.h>
+#include <ModuleRegistry.h>
+
+namespace ByteWeaver {
+
+    // Forwarder chains longer than this are treated as broken
+    static constexpr int MaxForwarderDepth = 8;
+
+    // ---- static storage ----
+    static std::mutex CacheMutex;
+    static std::unordered_map<const uint8_t*, std::shared_ptr<const ExportIndex>> Cache;
+    static std::atomic<bool> HashLookup{ false };
+
+    // ---- cache ----
+    std::shared_ptr<const ExportIndex> ExportIndex::Get(const uint8_t* moduleBase) {
+        const auto identity = ModuleIdentity::FromImage(moduleBase);
+        if (!identity.has_value())
+            return nullptr;
+
+        const bool hashLookup = HashLookup.load();
+        {
+            std::lock_guard lock(CacheMutex);
+            const auto it = Cache.find(moduleBase);
+            if (it != Cache.end()) {
+                // Another image mapped at the same address after an unload we did not see
+                if (it->second && it->second->_Identity == *identity && it->second->_HashLookup == hashLookup)
+                    return it->second;
+                Cache.erase(it);
+            }
+        }
+
+        // Unloads reach Invalidate() through the registry's loader notifications
+        ModuleRegistry::StartWatching();
+
+        auto index = Build(moduleBase, *identity, hashLookup);
+        std::lock_guard lock(CacheMutex);
+        auto& slot = Cache[moduleBase];
+        if (!slot || slot->_Identity != *identity || slot->_HashLookup != hashLookup)
+            slot = std::move(index);
+        return slot;
+    }
+
+    void ExportIndex::Invalidate(const uint8_t* moduleBase) {
+        std::shared_ptr<const ExportIndex> dropped;
+        std::lock_guard lock(CacheMutex);
+        if (const auto it = Cache.find(moduleBase); it != Cache.end()) {
+            dropped = std::move(it->second);
+            Cache.erase(it);
+        }
+    }
+
+    void ExportIndex::Clear() {
+        std::lock_guard lock(CacheMutex);
+        Cache.clear();
+    }
+
+    void ExportIndex::SetHashLookup(const bool enabled) {
+        HashLookup.store(enabled);
+    }
+
+    // ---- build ----
+    std::shared_ptr<const ExportIndex> ExportIndex::Build(const uint8_t* moduleBase, const ModuleIdentity& identity, const bool hashLookup) {
+        const auto dos = reinterpret_cast<const IMAGE_DOS_HEADER*>(moduleBase);
+        const auto nt = reinterpret_cast<const IMAGE_NT_HEADERS*>(moduleBase + dos->e_lfanew);
+        const IMAGE_DATA_DIRECTORY& directory = nt->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT];
+        if (directory.VirtualAddress == 0 || directory.Size == 0 || directory.VirtualAddress >= identity.SizeOfImage)
+            return nullptr;
+
+        const auto exports = reinterpret_cast<const IMAGE_EXPORT_DIRECTORY*>(moduleBase + directory.VirtualAddress);
+
+        std::shared_ptr<ExportIndex> index(new ExportIndex());
+        index->_Base = moduleBase;
+        index->_Identity = identity;
+        index->_Functions = reinterpret_cast<const uint32_t*>(moduleBase + exports->AddressOfFunctions);
+        index->_FunctionCount = exports->NumberOfFunctions;
+        index->_OrdinalBase = exports->Base;
+        index->_DirectoryBegin = directory.VirtualAddress;
+        index->_DirectoryEnd = directory.VirtualAddress + directory.Size;
+        index->_HashLookup = hashLookup;
+
+        const auto nameRvas = reinterpret_cast<const uint32_t*>(moduleBase + exports->AddressOfNames);
+        const auto nameOrdinals = reinterpret_cast<const uint16_t*>(moduleBase + exports->AddressOfNameOrdinals);
+
+        index->_Names.reserve(exports->NumberOfNames);
+        for (DWORD i = 0; i < exports->NumberOfNames; ++i) {
+            if (nameRvas[i] >= identity.SizeOfImage || nameOrdinals[i] >= exports->NumberOfFunctions)
+                continue;
+            const auto name = reinterpret_cast<const char*>(moduleBase + nameRvas[i]);
+            index->_Names.emplace_back(std::string_view(name, strnlen(name, identity.SizeOfImage - nameRvas[i])), nameOrdinals[i]);
+        }
+
+        // The linker emits the table sorted, but packers and hand-built images do not always keep it that way
+        if (!std::ranges::is_sorted(index->_Names, {}, &std::pair<std::string_view, uint32_t>::first))
+            std::ranges::sort(index->_Names, {}, &std::pair<std::string_view, uint32_t>::first);
+
+        if (hashLookup) {
+            index->_Hashed.reserve(index->_Names.size());
+            for (const auto& [name, functionIndex] : index->_Names) {
+                index->_Hashed.emplace(name, functionIndex);
+            }
+        }
+
+        Debug("[ExportIndex] Indexed %zu named exports (%u functions) at " ADDR_FMT,
+            index->_Names.size(), index->_FunctionCount, reinterpret_cast<uintptr_t>(moduleBase));
+        return index;
+    }
+
+    // ---- lookups ----
+    std::optional<uint32_t> ExportIndex::FindFunctionIndex(const std::string_view name) const {
+        if (_HashLookup) {
+            const auto it = _Hashed.find(name);
+            if (it == _Hashed.end())
+                return std::nullopt;
+            return it->second;
+        }
+
+        const auto it = std::ranges::lower_bound(_Names, name, {}, &std::pair<std::string_view, uint32_t>::first);
+        if (it == _Names.end() || it->first != name)
+            return std::nullopt;
+        return it->second;
+    }
+
+    std::optional<uintptr_t> ExportIndex::FindByName(const std::string_view name) const {
+        const auto functionIndex = FindFunctionIndex(name);
+        if (!functionIndex.has_value())
+            return std::nullopt;
+        return ResolveFunction(*functionIndex, 0);
+    }
+
+    std::optional<uintptr_t> ExportIndex::FindByOrdinal(const uint32_t ordinal) const {
+        if (ordinal < _OrdinalBase)
+            return std::nullopt;
+        return ResolveFunction(ordinal - _OrdinalBase, 0);
+    }
+
+    std::string_view ExportIndex::ForwarderOf(const std::string_view name) const {
+        const auto functionIndex = FindFunctionIndex(name);
+        if (!functionIndex.has_value() || *functionIndex >= _FunctionCount)
+            return {};
+
+        const uint32_t rva = _Functions[*functionIndex];
+        if (rva < _DirectoryBegin || rva >= _DirectoryEnd)
+            return {};
+        return reinterpret_cast<const char*>(_Base + rva);
+    }
+
+    std::optional<uintptr_t> ExportIndex::ResolveFunction(const uint32_t functionIndex, const int depth) const {
+        if (functionIndex >= _FunctionCount)
+            return std::nullopt;
+
+        const uint32_t rva = _Functions[functionIndex];
+        if (rva == 0)
+            return std::nullopt;
+
+        // An RVA inside the export directory is a forwarder string instead of code
+        if (rva >= _DirectoryBegin && rva < _DirectoryEnd)
+            return ResolveForwarder(reinterpret_cast<const char*>(_Base + rva), depth + 1);
+
+        return reinterpret_cast<uintptr_t>(_Base) + rva;
+    }
+
+    std::optional<uintptr_t> ExportIndex::ResolveForwarder(const std::string_view forwarder, const int depth) {
+        const size_t dot = forwarder.rfind('.');
+        if (depth > MaxForwarderDepth || dot == std::string_view::npos || dot == 0 || dot + 1 == forwarder.size()) {
+            Warn("[ExportIndex] Unresolvable forwarder '%.*s'", static_cast<int>(forwarder.size()), forwarder.data());
+            return std::nullopt;
+        }
+
+        const std::string moduleName = std::string(forwarder.substr(0, dot)) + ".dll";
+        const std::string_view target = forwarder.substr(dot + 1);
+
+        // The target is normally registered already; API sets only resolve through the loader.
+        // A lookup never loads anything: it may run inside a loader notification, and a reference
+        // taken here would never be released
+        const uint8_t* module = nullptr;
+        if (const auto registered = ModuleRegistry::Find(std::wstring(moduleName.begin(), moduleName.end())))
+            module = registered->Base;
+        else
+            module = reinterpret_cast<const uint8_t*>(GetModuleHandleA(moduleName.c_str()));
+        if (!module) {
+            Warn("[ExportIndex] Forwarder target %s is not loaded", moduleName.c_str());
+            return std::nullopt;
+        }
+
+        const auto index = Get(module);
+        if (!index)
+            return std::nullopt;
+
+        if (target.front() == '#') {
+            uint32_t ordinal = 0;
+            const auto [end, ec] = std::from_chars(target.data() + 1, target.data() + target.size(), ordinal);
+            if (ec != std::errc{} || ordinal < index->_OrdinalBase)
+                return std::nullopt;
+            return index->ResolveFunction(ordinal - index->_OrdinalBase, depth);
+        }
+
+        const auto functionIndex = index->FindFunctionIndex(target);
+        if (!functionIndex.has_value())
+            return std::nullopt;
+        return index->ResolveFunction(*functionIndex, depth);
+    }
+}
@@ -0,0 +1,133 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include <HookStats.h>
+
+namespace ByteWeaver {
+
+    // ---- static storage ----
+    // Hooks are declared as statics, so the registry must outlive every static destructor
+    struct HookStatsRegistry {
+        std::mutex Mutex;
+        std::vector<HookStats*> Stats;
+    };
+
+    static HookStatsRegistry& Registry() {
+        static auto* registry = new HookStatsRegistry();
+        return *registry;
+    }
+
+    static std::atomic<size_t> NextShard{ 0 };
+
+    // ---- HookStatsSnapshot ----
+    uint64_t HookStatsSnapshot::PercentileCycles(const double percentile) const noexcept {
+        if (Calls == 0)
+            return 0;
+
+        const auto rank = static_cast<uint64_t>(static_cast<double>(Calls) * (std::clamp)(percentile, 0.0, 100.0) / 100.0);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BucketCount; ++i) {
+            seen += Buckets[i];
+            if (seen > rank || seen == Calls)
+                return uint64_t{ 2 } << i;
+        }
+        return uint64_t{ 2 } << (BucketCount - 1);
+    }
+
+    // ---- HookStats ----
+    HookStats::HookStats(const char* key) : _Key(key ? key : "") {
+        HookStatsRegistry& registry = Registry();
+        std::lock_guard lock(registry.Mutex);
+        registry.Stats.push_back(this);
+    }
+
+    HookStats::~HookStats() {
+        HookStatsRegistry& registry = Registry();
+        std::lock_guard lock(registry.Mutex);
+        std::erase(registry.Stats, this);
+    }
+
+    size_t HookStats::ShardIndex() noexcept {
+        // Threads take shards round-robin, so up to ShardCount threads never share a line
+        thread_local const size_t shard = NextShard.fetch_add(1, std::memory_order_relaxed) % ShardCount;
+        return shard;
+    }
+
+    HookStatsSnapshot HookStats::Snapshot() const noexcept {
+        HookStatsSnapshot snapshot;
+        for (const Shard& shard : _Shards) {
+            snapshot.Calls += shard.Calls.load(std::memory_order_relaxed);
+            snapshot.TotalCycles += shard.Cycles.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < HookStatsSnapshot::BucketCount; ++i) {
+                snapshot.Buckets[i] += shard.Buckets[i].load(std::memory_order_relaxed);
+            }
+        }
+        return snapshot;
+    }
+
+    void HookStats::Reset() noexcept {
+        for (Shard& shard : _Shards) {
+            shard.Calls.store(0, std::memory_order_relaxed);
+            shard.Cycles.store(0, std::memory_order_relaxed);
+            for (auto& bucket : shard.Buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // ---- registry ----
+    static void Accumulate(HookStatsSnapshot& total, const HookStatsSnapshot& part) {
+        total.Calls += part.Calls;
+        total.TotalCycles += part.TotalCycles;
+        for (size_t i = 0; i < HookStatsSnapshot::BucketCount; ++i) {
+            total.Buckets[i] += part.Buckets[i];
+        }
+    }
+
+    std::optional<HookStatsSnapshot> HookStats::Find(const std::string& key) {
+        HookStatsRegistry& registry = Registry();
+        std::lock_guard lock(registry.Mutex);
+
+        std::optional<HookStatsSnapshot> total;
+        for (const HookStats* stats : registry.Stats) {
+            if (stats->_Key != key)
+                continue;
+            if (!total)
+                total.emplace();
+            Accumulate(*total, stats->Snapshot());
+        }
+        return total;
+    }
+
+    std::vector<std::pair<std::string, HookStatsSnapshot>> HookStats::All() {
+        HookStatsRegistry& registry = Registry();
+        std::lock_guard lock(registry.Mutex);
+
+        std::map<std::string, HookStatsSnapshot> totals;
+        for (const HookStats* stats : registry.Stats) {
+            Accumulate(totals[stats->_Key], stats->Snapshot());
+        }
+        return { totals.begin(), totals.end() };
+    }
+
+    bool HookStats::Reset(const std::string& key) {
+        HookStatsRegistry& registry = Registry();
+        std::lock_guard lock(registry.Mutex);
+
+        bool found = false;
+        for (HookStats* stats : registry.Stats) {
+            if (stats->_Key == key) {
+                stats->Reset();
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    void HookStats::ResetAll() {
+        HookStatsRegistry& registry = Registry();
+        std::lock_guard lock(registry.Mutex);
+        for (HookStats* stats : registry.Stats) {
+            stats->Reset();
+        }
+    }
+}
@@ -0,0 +1,350 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include <InlineHook.h>
+#include <RegionMap.h>
+#include <TrampolinePool.h>
+#include <detours.h>
+#include <tlhelp32.h>
+
+namespace ByteWeaver
+{
+    // Longest x86/x64 instruction plus the growth of a rel8 branch rewritten as rel32
+    constexpr size_t MaxRelocatedInstruction = 15 + 4;
+
+    // Encodes into buffer a jmp rel32 that will run from address
+    static void EncodeRel32Jump(uint8_t* buffer, const uintptr_t address, const uintptr_t to) {
+        buffer[0] = 0xE9;
+        const auto displacement = static_cast<int32_t>(to - (address + InlineHook::JumpSize));
+        memcpy(buffer + 1, &displacement, sizeof(displacement));
+    }
+
+    // Returns and unconditional jumps: whatever follows them in the prologue may not be code
+    static bool EndsControlFlow(const uint8_t* instruction) {
+        if (*instruction == 0xF3 || *instruction == 0xF2)
+            ++instruction; // rep ret, bnd jmp
+        if constexpr (WIN64) {
+            if ((*instruction & 0xF0) == 0x40)
+                ++instruction; // REX
+        }
+        switch (instruction[0]) {
+            case 0xC2: case 0xC3: case 0xCA: case 0xCB: case 0xE9: case 0xEB:
+                return true;
+            case 0xFF: {
+                const uint8_t reg = (instruction[1] >> 3) & 7;
+                return reg == 4 || reg == 5;
+            }
+            default:
+                return false;
+        }
+    }
+
+    // Decodes whole instructions at code until they cover the jump, recording where each starts.
+    // Returns their length, or 0 if the code cannot be read; kept free of destructible locals for __try.
+    static size_t GuardedDecode(const uint8_t* code, uint8_t* offsets, uint8_t* instructions) {
+        __try {
+            // Every instruction is at least one byte, so JumpSize instructions always cover the jump
+            size_t size = 0;
+            while (size < InlineHook::JumpSize) {
+                LONG extra = 0;
+                offsets[(*instructions)++] = static_cast<uint8_t>(size);
+                const auto* next = static_cast<const uint8_t*>(DetourCopyInstruction(nullptr, nullptr,
+                    const_cast<uint8_t*>(code + size), nullptr, &extra));
+                size = next - code;
+            }
+            offsets[*instructions] = static_cast<uint8_t>(size);
+            return size;
+        }
+        __except (EXCEPTION_EXECUTE_HANDLER) {
+            *instructions = 0;
+            offsets[0] = 0;
+            return 0;
+        }
+    }
+
+    // Copies the prologue [source, source + size) into the trampoline and appends the jump back.
+    // Returns the trampoline length, or 0 with *failure set; kept free of destructible locals for __try.
+    static size_t GuardedRelocate(uint8_t* trampoline, const size_t capacity, const uint8_t* source, const size_t size, uint8_t* offsets, const char** failure) {
+        __try {
+            size_t read = 0;
+            size_t written = 0;
+            size_t index = 0;
+            while (read < size) {
+                if (written + MaxRelocatedInstruction + InlineHook::JumpSize > capacity) {
+                    *failure = "relocated prologue does not fit a slot";
+                    return 0;
+                }
+                PVOID branch = nullptr;
+                LONG extra = 0;
+                offsets[index] = static_cast<uint8_t>(written);
+                const auto* next = static_cast<const uint8_t*>(DetourCopyInstruction(trampoline + written, nullptr,
+                    const_cast<uint8_t*>(source + read), &branch, &extra));
+                const size_t length = next - (source + read);
+
+                if (EndsControlFlow(source + read) && read + length < size) {
+                    *failure = "function ends before the jump fits";
+                    return 0;
+                }
+                const auto* target = static_cast<const uint8_t*>(branch);
+                if (branch != DETOUR_INSTRUCTION_TARGET_DYNAMIC && target > source && target < source + size) {
+                    *failure = "prologue branches into the overwritten bytes";
+                    return 0;
+                }
+
+                written += length + extra;
+                read += length;
+                ++index;
+            }
+            offsets[index] = static_cast<uint8_t>(written);
+
+            const uintptr_t resume = reinterpret_cast<uintptr_t>(source) + size;
+            if (!InlineHook::IsRel32Reachable(reinterpret_cast<uintptr_t>(trampoline + written) + InlineHook::JumpSize, resume)) {
+                *failure = "trampoline is out of rel32 reach of the target";
+                return 0;
+            }
+            EncodeRel32Jump(trampoline + written, reinterpret_cast<uintptr_t>(trampoline + written), resume);
+            return written + InlineHook::JumpSize;
+        }
+        __except (EXCEPTION_EXECUTE_HANDLER) {
+            *failure = "exception while reading the prologue";
+            return 0;
+        }
+    }
+
+    // Returns 0 or the exception code; kept free of destructible locals for __try
+    static DWORD GuardedSwapBytes(void* target, const void* source, void* save, const size_t size) {
+        __try {
+            if (save)
+                memcpy(save, target, size);
+            memcpy(target, source, size);
+            return 0;
+        }
+        __except (EXCEPTION_EXECUTE_HANDLER) {
+            return GetExceptionCode();
+        }
+    }
+
+    // ---- threads ----
+
+    // Opens every other thread of the process; nothing is suspended yet, so allocating here cannot
+    // deadlock on a heap lock held by a suspended thread
+    static std::vector<HANDLE> OpenOtherThreads() {
+        std::vector<HANDLE> threads;
+        const HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+        if (snapshot == INVALID_HANDLE_VALUE) {
+            Warn("[InlineHook] Thread snapshot failed (0x%08X); other threads are not suspended", GetLastError());
+            return threads;
+        }
+
+        const DWORD processId = GetCurrentProcessId();
+        const DWORD currentThreadId = GetCurrentThreadId();
+
+        THREADENTRY32 entry{};
+        entry.dwSize = sizeof(entry);
+        for (BOOL more = Thread32First(snapshot, &entry); more; more = Thread32Next(snapshot, &entry)) {
+            if (entry.th32OwnerProcessID != processId || entry.th32ThreadID == currentThreadId)
+                continue;
+            if (const HANDLE thread = OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | THREAD_SET_CONTEXT, FALSE, entry.th32ThreadID))
+                threads.push_back(thread);
+        }
+
+        CloseHandle(snapshot);
+        return threads;
+    }
+
+    // Moves a thread stopped at instruction i of [from, from + fromOffsets[count]) to instruction i of to
+    static void MoveInstructionPointer(const HANDLE thread, const uintptr_t from, const uint8_t* fromOffsets,
+                                       const uintptr_t to, const uint8_t* toOffsets, const size_t count) {
+        CONTEXT context{};
+        context.ContextFlags = CONTEXT_CONTROL;
+        if (!GetThreadContext(thread, &context))
+            return;
+
+        #if defined(_WIN64)
+            DWORD64& ip = context.Rip;
+        #else
+            DWORD& ip = context.Eip;
+        #endif
+
+        if (ip < from || ip - from > fromOffsets[count])
+            return;
+        for (size_t i = 0; i <= count; ++i) {
+            if (ip - from == fromOffsets[i]) {
+                ip = to + toOffsets[i];
+                SetThreadContext(thread, &context);
+                return;
+            }
+        }
+    }
+
+    // ---- inline hook ----
+    InlineHook::InlineHook(const uintptr_t targetAddress, const ModType type, const size_t slotCount) : _SlotCount(slotCount)
+    {
+        this->IsModified = false;
+        this->TargetAddress = targetAddress;
+        this->Type = type;
+
+        // A target that cannot be read keeps Size 0, which Apply() refuses
+        size_t size = 0;
+        if (targetAddress != 0) {
+            size = GuardedDecode(reinterpret_cast<const uint8_t*>(targetAddress), _SourceOffsets.data(), &_Instructions);
+            if (size == 0)
+                Error("[%s] Exception while decoding " ADDR_FMT, Name(), targetAddress);
+        }
+
+        this->Size = size;
+        this->OriginalBytes.resize(Size);
+    }
+
+    InlineHook::~InlineHook()
+    {
+        // An applied hook still jumps into its slot; leaking it is the only safe choice. Otherwise
+        // the slot is retired, never reused (see TrampolinePool::Free)
+        if (!IsModified)
+            TrampolinePool::Free(_Slot, _SlotCount);
+    }
+
+    const char* InlineHook::Name() const
+    {
+        return Type == ModType::MidHook ? "MidHook" : "NearHook";
+    }
+
+    bool InlineHook::WriteTarget(const uint8_t* bytes, const bool apply)
+    {
+        auto* target = reinterpret_cast<void*>(TargetAddress);
+
+        DWORD oldProtection;
+        DWORD _;
+        if (!VirtualProtect(target, Size, PAGE_EXECUTE_READWRITE, &oldProtection)) {
+            Error("[%s] Failed to set permissions at " ADDR_FMT " (size: %zu). Error %lu", Name(), TargetAddress, Size, GetLastError());
+            return false;
+        }
+
+        std::vector<HANDLE> threads = OpenOtherThreads();
+        for (const HANDLE thread : threads)
+            SuspendThread(thread);
+
+        // Threads stay suspended until the bytes and their instruction pointers agree
+        const DWORD code = GuardedSwapBytes(target, bytes, apply ? OriginalBytes.data() : nullptr, Size);
+        if (code == 0) {
+            const auto trampoline = reinterpret_cast<uintptr_t>(_Trampoline);
+            for (const HANDLE thread : threads) {
+                if (apply)
+                    MoveInstructionPointer(thread, TargetAddress, _SourceOffsets.data(), trampoline, _TrampolineOffsets.data(), _Instructions);
+                else
+                    MoveInstructionPointer(thread, trampoline, _TrampolineOffsets.data(), TargetAddress, _SourceOffsets.data(), _Instructions);
+            }
+        }
+
+        for (const HANDLE thread : threads) {
+            ResumeThread(thread);
+            CloseHandle(thread);
+        }
+
+        VirtualProtect(target, Size, oldProtection, &_);
+        FlushInstructionCache(GetCurrentProcess(), target, Size);
+        RegionMap::Invalidate(TargetAddress, Size);
+
+        if (code != 0) {
+            Error("[%s] Exception %s " ADDR_FMT " (Size: %zu): 0x%08X", Name(), apply ? "hooking" : "restoring", TargetAddress, Size, code);
+            return false;
+        }
+        return true;
+    }
+
+    bool InlineHook::Apply()
+    {
+        if (IsModified)
+            return true;
+
+        if (TargetAddress == 0 || Size < JumpSize || !RegionMap::IsRangeAccessible(TargetAddress, Size, RegionMap::ExecutableProtections)) {
+            Error("[%s] Target memory is not executable: " ADDR_FMT, Name(), TargetAddress);
+            return false;
+        }
+
+        // A slot that was ever live is retired, not rewritten: a thread may still be inside it after
+        // Restore() (returning into a relocated call, or through an original pointer it loaded earlier)
+        if (_Slot && _SlotWentLive) {
+            TrampolinePool::Free(_Slot, _SlotCount);
+            _Slot = nullptr;
+            _Trampoline = nullptr;
+            _SlotWentLive = false;
+        }
+
+        if (!_Slot && !(_Slot = TrampolinePool::Allocate(TargetAddress, _SlotCount))) {
+            Error("[%s] No trampoline slot within reach of " ADDR_FMT, Name(), TargetAddress);
+            return false;
+        }
+
+        // Built from the target as it is now: the code may have changed since the last Restore()
+        uintptr_t entry = 0;
+        const char* failure = nullptr;
+        size_t trampolineSize = 0;
+        {
+            TrampolinePool::Writer writer(_Slot, _SlotCount);
+            if (!writer)
+                return false;
+
+            const std::optional<size_t> entrySize = WriteEntry(_Slot, entry);
+            if (!entrySize.has_value() || *entrySize + RelocatedCapacity > _SlotCount * TrampolinePool::SlotSize) {
+                failure = !entrySize.has_value() ? "entry code could not be written" : "entry code does not fit its slots";
+            } else {
+                _Trampoline = _Slot + *entrySize;
+                trampolineSize = GuardedRelocate(_Trampoline, RelocatedCapacity, reinterpret_cast<const uint8_t*>(TargetAddress), Size,
+                                                 _TrampolineOffsets.data(), &failure);
+            }
+        }
+
+        if (trampolineSize == 0) {
+            Error("[%s] Cannot hook " ADDR_FMT "%s%s: %s", Name(), TargetAddress, Key.empty() ? "" : " Key: ", Key.c_str(), failure);
+            return false;
+        }
+
+        // The jump, padded with int3 over the rest of the last overwritten instruction
+        std::array<uint8_t, MaxRelocatedInstruction + JumpSize> jump;
+        jump.fill(0xCC);
+        EncodeRel32Jump(jump.data(), TargetAddress, entry);
+
+        // Before the jump goes live: the entry code may run at once
+        OnLiveChanged(true);
+        _SlotWentLive = true;
+        OriginalBytes.assign(Size, 0);
+        if (!WriteTarget(jump.data(), true)) {
+            OnLiveChanged(false);
+            return false;
+        }
+        IsModified = true;
+
+        if constexpr (BYTEWEAVER_ENABLE_LOGGING) {
+            if (!this->Key.empty()) {
+                Debug("[%s] (Apply) [Target: " ADDR_FMT " -> Entry: " ADDR_FMT " Size: %zu, Trampoline: " ADDR_FMT ", Key: %s]",
+                    Name(), TargetAddress, entry, Size, _Trampoline, Key.c_str());
+            } else {
+                Debug("[%s] (Apply) [Target: " ADDR_FMT " -> Entry: " ADDR_FMT " Size: %zu, Trampoline: " ADDR_FMT "]",
+                    Name(), TargetAddress, entry, Size, _Trampoline);
+                Warn("[%s] WARNING: Applied unmanaged hook @" ADDR_FMT, Name(), TargetAddress);
+            }
+        }
+        return true;
+    }
+
+    bool InlineHook::Restore()
+    {
+        if (!IsModified)
+            return true;
+
+        if (!WriteTarget(OriginalBytes.data(), false))
+            return false;
+
+        IsModified = false;
+        OnLiveChanged(false);
+
+        if constexpr (BYTEWEAVER_ENABLE_LOGGING) {
+            if (!this->Key.empty()) {
+                Debug("[%s] (Restore) [Target: " ADDR_FMT " Size: %zu, Key: %s]", Name(), TargetAddress, Size, Key.c_str());
+            } else {
+                Debug("[%s] (Restore) [Target: " ADDR_FMT " Size: %zu]", Name(), TargetAddress, Size);
+            }
+        }
+        return true;
+    }
+}
@@ -1,7 +1,12 @@
 // Copyright(C) 2025 0xKate - MIT License
 
 #include <cassert>
+#include <AddressDB.h>
+#include <DeferredLoader.h>
 #include <MemoryManager.h>
+#include <ModArena.h>
+#include <ModuleRegistry.h>
+#include <RegionMap.h>
 
 #include <WinDetour.h>
 #include <WinPatch.h>
@@ -11,19 +16,245 @@ namespace ByteWeaver {
     std::map<std::string, std::shared_ptr<MemoryModification>> MemoryManager::Mods;
     std::shared_mutex MemoryManager::ModsMutex;
 
+    // Address-ordered view of every registered mod, guarded by ModsMutex. Queries check IsModified on
+    // the few entries that overlap, so mods applied directly through their own Apply() are seen too.
+    using ModNode = std::map<std::string, std::shared_ptr<MemoryModification>>::const_iterator;
+
+    struct ModInterval {
+        uintptr_t Start;
+        uintptr_t End;
+        const MemoryModification* Mod;  // Node->second, read without the hop through the map node
+        ModNode Node;
+    };
+
+    static std::vector<ModInterval> Intervals;
+    static size_t MaxIntervalSize = 0;
+
+    static void InsertInterval(const ModNode node) {
+        const MemoryModification& mod = *node->second;
+        const ModInterval interval{ mod.TargetAddress, mod.TargetAddress + mod.Size, &mod, node };
+        const auto it = std::ranges::upper_bound(Intervals, interval.Start, {}, &ModInterval::Start);
+        Intervals.insert(it, interval);
+        MaxIntervalSize = (std::max)(MaxIntervalSize, mod.Size);
+    }
+
+    static void RemoveInterval(const ModNode node) {
+        std::erase_if(Intervals, [node](const ModInterval& interval) { return interval.Node == node; });
+    }
+
+    static void RebuildIntervals(const std::map<std::string, std::shared_ptr<MemoryModification>>& mods) {
+        Intervals.clear();
+        MaxIntervalSize = 0;
+        Intervals.reserve(mods.size());
+        for (auto it = mods.begin(); it != mods.end(); ++it) {
+            Intervals.push_back({ it->second->TargetAddress, it->second->TargetAddress + it->second->Size, it->second.get(), it });
+            MaxIntervalSize = (std::max)(MaxIntervalSize, it->second->Size);
+        }
+        std::ranges::sort(Intervals, {}, &ModInterval::Start);
+    }
+
+    // Calls visit(interval) for every applied mod overlapping [address, endAddress) until it returns false
+    template <typename Visitor>
+    static void ForEachOverlap(const uintptr_t address, const uintptr_t endAddress, Visitor visit) {
+        // No mod is longer than MaxIntervalSize, so nothing starting earlier can reach address
+        const uintptr_t first = address > MaxIntervalSize ? address - MaxIntervalSize : 0;
+        for (auto it = std::ranges::lower_bound(Intervals, first, {}, &ModInterval::Start);
+             it != Intervals.end() && it->Start < endAddress; ++it) {
+            if (it->End > address && it->Mod->IsModified && !visit(*it))
+                return;
+        }
+    }
+
+    // Immutable snapshot of Mods for lock-free lookups. Writers rebuild it under the unique ModsMutex
+    // and publish it with an atomic pointer store; readers hold a TableReader while they use it.
+    struct ModTable {
+        std::vector<std::string> Keys;                                // by slot; empty = free slot
+        std::vector<std::shared_ptr<MemoryModification>> Slots;       // by slot
+        std::vector<uint32_t> Generations;                            // by slot
+        std::vector<uint32_t> Buckets;                                // open addressing, slot + 1 (0 = empty)
+
+        const uint32_t* FindSlot(const std::string_view key) const {
+            return FindSlot(key, HashModKey(key));
+        }
+
+        // hash is HashModKey(key), possibly computed at compile time (HookDescriptor::KeyHash)
+        const uint32_t* FindSlot(const std::string_view key, const uint64_t hash) const {
+            if (Buckets.empty())
+                return nullptr;
+            const size_t mask = Buckets.size() - 1;
+            for (size_t i = static_cast<size_t>(hash) & mask;; i = (i + 1) & mask) {
+                const uint32_t& bucket = Buckets[i];
+                if (bucket == 0)
+                    return nullptr;
+                if (Keys[bucket - 1] == key)
+                    return &bucket;
+            }
+        }
+
+        std::shared_ptr<MemoryModification> Find(const std::string_view key) const {
+            const uint32_t* bucket = FindSlot(key);
+            return bucket ? Slots[*bucket - 1] : nullptr;
+        }
+
+        std::shared_ptr<MemoryModification> Resolve(const ModHandle handle) const {
+            if (handle.Index >= Slots.size() || Generations[handle.Index] != handle.Generation)
+                return nullptr;
+            return Slots[handle.Index];
+        }
+    };
+
+    // ---- table reclamation ----
+    // Epoch-based: a reader counts itself in the shard of its thread under the parity of the global
+    // epoch, then loads the table. A table unpublished in epoch e is freed once the epoch reaches
+    // e + 2; the epoch only advances past a parity no reader is counted in. Readers touch their own
+    // shard's cache line and never wait; writers never wait for readers either (a thread may read
+    // while it registers a mod), they free what has become unreachable on their next publish.
+    struct alignas(64) ReaderShard {
+        std::atomic<uint32_t> Count[2]{};
+    };
+
+    static constexpr size_t ReaderShardCount = 64;
+    static ReaderShard ReaderShards[ReaderShardCount];
+    static std::atomic<uint64_t> TableEpoch{ 0 };
+    static std::atomic<const ModTable*> PublishedTable{ new ModTable() };
+
+    // Guarded by ModsMutex
+    static std::vector<std::pair<const ModTable*, uint64_t>> RetiredTables;
+
+    static ReaderShard& ThisThreadShard() {
+        static std::atomic<size_t> nextShard{ 0 };
+        thread_local ReaderShard& shard = ReaderShards[nextShard.fetch_add(1, std::memory_order_relaxed) % ReaderShardCount];
+        return shard;
+    }
+
+    // Keeps the table published at construction alive until destruction; may be nested
+    class TableReader {
+    public:
+        TableReader() : _Shard(ThisThreadShard()) {
+            _Parity = static_cast<uint32_t>(TableEpoch.load() & 1);
+            _Shard.Count[_Parity].fetch_add(1);
+            _Table = PublishedTable.load();
+        }
+        ~TableReader() { _Shard.Count[_Parity].fetch_sub(1, std::memory_order_release); }
+
+        TableReader(const TableReader&) = delete;
+        TableReader& operator=(const TableReader&) = delete;
+
+        const ModTable* operator->() const noexcept { return _Table; }
+        const ModTable& operator*() const noexcept { return *_Table; }
+
+    private:
+        ReaderShard& _Shard;
+        uint32_t _Parity = 0;
+        const ModTable* _Table = nullptr;
+    };
+
+    // Advances the epoch past parities no reader holds (at most twice) and frees the tables that
+    // became unreachable. Caller holds the unique ModsMutex.
+    static void ReclaimTables() {
+        for (int step = 0; step < 2; ++step) {
+            const uint64_t epoch = TableEpoch.load();
+            const auto previous = static_cast<uint32_t>((epoch + 1) & 1);
+            const bool quiet = std::ranges::all_of(ReaderShards, [previous](const ReaderShard& shard) {
+                return shard.Count[previous].load() == 0;
+            });
+            if (!quiet)
+                break;
+            TableEpoch.store(epoch + 1);
+        }
+
+        const uint64_t epoch = TableEpoch.load();
+        std::erase_if(RetiredTables, [epoch](const std::pair<const ModTable*, uint64_t>& retired) {
+            if (epoch < retired.second + 2)
+                return false;
+            delete retired.first;
+            return true;
+        });
+    }
+
+    // Caller holds the unique ModsMutex
+    static void ReplaceTable(const ModTable* table) {
+        const ModTable* previous = PublishedTable.exchange(table);
+        RetiredTables.emplace_back(previous, TableEpoch.load());
+        ReclaimTables();
+    }
+
+    // Rebuilds the snapshot from mods; slots keep their index across versions so handles stay valid
+    static void PublishTable(const std::map<std::string, std::shared_ptr<MemoryModification>>& mods) {
+        const ModTable* previous = PublishedTable.load();
+        auto table = std::make_unique<ModTable>();
+        table->Keys = previous->Keys;
+        table->Slots = previous->Slots;
+        table->Generations = previous->Generations;
+
+        std::unordered_map<std::string_view, uint32_t> slotOf;
+        std::vector<uint32_t> freeSlots;
+        for (uint32_t slot = 0; slot < table->Keys.size(); ++slot) {
+            const auto it = table->Keys[slot].empty() ? mods.end() : mods.find(table->Keys[slot]);
+            if (it == mods.end()) {
+                if (!table->Keys[slot].empty()) {
+                    table->Keys[slot].clear();
+                    table->Slots[slot].reset();
+                    ++table->Generations[slot];
+                }
+                freeSlots.push_back(slot);
+                continue;
+            }
+            if (table->Slots[slot] != it->second) {
+                // Same key, different object: handles to the old one must not reach the new one
+                table->Slots[slot] = it->second;
+                ++table->Generations[slot];
+            }
+            slotOf.emplace(it->first, slot);
+        }
+
+        std::ranges::reverse(freeSlots); // reuse low slots first
+        for (const auto& [key, hMod] : mods) {
+            if (slotOf.contains(key))
+                continue;
+            uint32_t slot;
+            if (!freeSlots.empty()) {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+            } else {
+                slot = static_cast<uint32_t>(table->Keys.size());
+                table->Keys.emplace_back();
+                table->Slots.emplace_back();
+                table->Generations.push_back(0);
+            }
+            table->Keys[slot] = key;
+            table->Slots[slot] = hMod;
+            slotOf.emplace(key, slot);
+        }
+
+        // Load factor at most 1/2 keeps probe chains short
+        size_t bucketCount = 16;
+        while (bucketCount < mods.size() * 2)
+            bucketCount *= 2;
+        table->Buckets.assign(bucketCount, 0);
+        const size_t mask = bucketCount - 1;
+        for (const auto& [key, slot] : slotOf) {
+            size_t i = static_cast<size_t>(HashModKey(key)) & mask;
+            while (table->Buckets[i] != 0)
+                i = (i + 1) & mask;
+            table->Buckets[i] = slot + 1;
+        }
+
+        ReplaceTable(table.release());
+    }
+
     uintptr_t MemoryManager::GetBaseAddress() {
         HMODULE hModule = GetModuleHandle(nullptr);
         return reinterpret_cast<uintptr_t>(hModule);
     }
 
     bool MemoryManager::ModExists(const std::string& key, std::shared_ptr<MemoryModification>* hOutMod) {
-        std::shared_lock lock(ModsMutex);
-        if (const auto it = Mods.find(key); it != Mods.end()) {
-            if (hOutMod)
-                *hOutMod = it->second;
-            return true;
-        }
-        return false;
+        auto hMod = TableReader()->Find(key);
+        if (!hMod)
+            return false;
+        if (hOutMod)
+            *hOutMod = std::move(hMod);
+        return true;
     }
 
     bool MemoryManager::AddMod(const std::string& key, std::shared_ptr<MemoryModification> hMod, const uint16_t groupID) {
@@ -31,7 +262,10 @@ namespace ByteWeaver {
             std::unique_lock lock(ModsMutex);
             hMod->Key = key;
             hMod->GroupID = groupID;
-            Mods.emplace(key, hMod);
+            if (const auto [it, inserted] = Mods.emplace(key, hMod); inserted) {
+                InsertInterval(it);
+                PublishTable(Mods);
+            }
             return true;
         }
         return false;
@@ -56,7 +290,9 @@ namespace ByteWeaver {
     bool MemoryManager::EraseMod(const std::string& key) {
         std::unique_lock lock(ModsMutex);
         if (const auto it = Mods.find(key); it != Mods.end()) {
+            RemoveInterval(it);
             Mods.erase(it);
+            PublishTable(Mods);
             return true;
         }
         Error("[MemoryManager] (EraseMod) Mod with key '%s' does not exist!", key.c_str());
@@ -64,9 +300,8 @@ namespace ByteWeaver {
     }
 
     auto MemoryManager::GetMod(const std::string& key) -> std::shared_ptr<MemoryModification> {
-        std::shared_lock lock(ModsMutex);
-        if (const auto it = Mods.find(key); it != Mods.end()) {
-            return it->second;
+        if (auto hMod = TableReader()->Find(key)) {
+            return hMod;
         }
         Error("[MemoryManager] (GetMod) Mod with key '%s' does not exist!", key.c_str());
         return nullptr;
@@ -75,7 +310,7 @@ namespace ByteWeaver {
     bool MemoryManager::ApplyMod(const std::string& key) {
         std::shared_ptr<MemoryModification> hMod;
         if (ModExists(key, &hMod)) {
-            hMod->Apply();
+            return hMod->Apply();
         }
         return false;
     }
@@ -83,21 +318,60 @@ namespace ByteWeaver {
     bool MemoryManager::RestoreMod(const std::string& key) {
         std::shared_ptr<MemoryModification> hMod;
         if (ModExists(key, &hMod)) {
-            hMod->Restore();
+            return hMod->Restore();
         }
         return false;
     }
 
+    ModHandle MemoryManager::GetHandle(const std::string& key) {
+        const TableReader table;
+        const uint32_t* bucket = table->FindSlot(key);
+        if (!bucket)
+            return {};
+        const uint32_t slot = *bucket - 1;
+        return { slot, table->Generations[slot] };
+    }
+
+    auto MemoryManager::GetMod(const ModHandle handle) -> std::shared_ptr<MemoryModification> {
+        return TableReader()->Resolve(handle);
+    }
+
+    bool MemoryManager::ApplyMod(const ModHandle handle) {
+        const auto hMod = TableReader()->Resolve(handle);
+        return hMod && hMod->Apply();
+    }
+
+    bool MemoryManager::RestoreMod(const ModHandle handle) {
+        const auto hMod = TableReader()->Resolve(handle);
+        return hMod && hMod->Restore();
+    }
+
     bool MemoryManager::RestoreAndEraseMod(const std::string& key) {
         const bool a = RestoreMod(key);
         const bool b = EraseMod(key);
         return a & b;
     }
 
+    std::optional<HookStatsSnapshot> MemoryManager::GetHookStats(const std::string& key) {
+        return HookStats::Find(key);
+    }
+
+    std::vector<std::pair<std::string, HookStatsSnapshot>> MemoryManager::GetAllHookStats() {
+        return HookStats::All();
+    }
+
+    bool MemoryManager::ResetHookStats(const std::string& key) {
+        return HookStats::Reset(key);
+    }
+
+    void MemoryManager::ResetAllHookStats() {
+        HookStats::ResetAll();
+    }
+
     std::shared_ptr<Patch> MemoryManager::CreatePatch(const std::string& key, uintptr_t patchAddress, const std::vector<uint8_t>& patchBytes, const uint16_t groupID) {
         std::shared_ptr<MemoryModification> existingMod;
         if (!ModExists(key, &existingMod)) {
-            auto patch = std::make_shared<Patch>(patchAddress, patchBytes);
+            auto patch = ModArena::MakeShared<Patch>(patchAddress, patchBytes);
             AddMod(key, patch, groupID);
             return patch;
         }
@@ -109,7 +383,7 @@ namespace ByteWeaver {
     std::shared_ptr<Detour> MemoryManager::CreateDetour(const std::string& key, uintptr_t targetAddress, PVOID* originalFunction, PVOID detourFunction, const uint16_t groupID) {
         std::shared_ptr<MemoryModification> existingMod = nullptr;
         if (!ModExists(key, &existingMod)) {
-            auto detour = std::make_shared<Detour>(targetAddress, originalFunction, detourFunction);
+            auto detour = ModArena::MakeShared<Detour>(targetAddress, originalFunction, detourFunction);
             AddMod(key, detour, groupID);
             return detour;
         }
@@ -118,6 +392,195 @@ namespace ByteWeaver {
         return std::dynamic_pointer_cast<Detour>(existingMod); // Will return nullptr if the existing mod by 'Key' was not actually a detour.
     }
 
+    std::shared_ptr<NearHook> MemoryManager::CreateNearHook(const std::string& key, uintptr_t targetAddress, PVOID* originalFunction, PVOID detourFunction, const uint16_t groupID) {
+        std::shared_ptr<MemoryModification> existingMod = nullptr;
+        if (!ModExists(key, &existingMod)) {
+            auto hook = ModArena::MakeShared<NearHook>(targetAddress, originalFunction, detourFunction);
+            AddMod(key, hook, groupID);
+            return hook;
+        }
+
+        Warn("Attempted to create a NearHook with already existing key (%s) and returned existing NearHook instead.", key.empty() ? "" : key.c_str());
+        return std::dynamic_pointer_cast<NearHook>(existingMod);
+    }
+
+    std::shared_ptr<MidHook> MemoryManager::CreateMidHook(const std::string& key, uintptr_t targetAddress, MidHookCallback callback,
+                                                          const RegisterMask liveRegisters, const uint16_t groupID) {
+        std::shared_ptr<MemoryModification> existingMod = nullptr;
+        if (!ModExists(key, &existingMod)) {
+            auto hook = ModArena::MakeShared<MidHook>(targetAddress, callback, liveRegisters);
+            AddMod(key, hook, groupID);
+            return hook;
+        }
+
+        Warn("Attempted to create a MidHook with already existing key (%s) and returned existing MidHook instead.", key.empty() ? "" : key.c_str());
+        return std::dynamic_pointer_cast<MidHook>(existingMod);
+    }
+
+    // ---- handle registration ----
+
+    // Handle of the mod under key if it has the given type, else an invalid handle
+    static ModHandle HandleOfType(const std::string& key, const ModType type) {
+        const TableReader table;
+        const uint32_t* bucket = table->FindSlot(key);
+        if (!bucket)
+            return {};
+        const uint32_t slot = *bucket - 1;
+        if (table->Slots[slot]->Type != type) {
+            Warn("[MemoryManager] (Register) %s already exists with another type.", key.c_str());
+            return {};
+        }
+        return { slot, table->Generations[slot] };
+    }
+
+    // Registers hMod unless key was taken meanwhile, and returns the handle of whatever holds key
+    static ModHandle RegisterForHandle(const std::string& key, const std::shared_ptr<MemoryModification>& hMod, const uint16_t groupID) {
+        {
+            std::unique_lock lock(MemoryManager::ModsMutex);
+            if (const auto [it, inserted] = MemoryManager::Mods.try_emplace(key, hMod); inserted) {
+                hMod->Key = key;
+                hMod->GroupID = groupID;
+                InsertInterval(it);
+                PublishTable(MemoryManager::Mods);
+            }
+        }
+        return HandleOfType(key, hMod->Type);
+    }
+
+    ModHandle MemoryManager::RegisterPatch(const std::string& key, const uintptr_t patchAddress, const std::span<const uint8_t> patchBytes, const uint16_t groupID) {
+        if (ModExists(key))
+            return HandleOfType(key, ModType::Patch);
+        return RegisterForHandle(key, ModArena::MakeShared<Patch>(patchAddress, patchBytes), groupID);
+    }
+
+    ModHandle MemoryManager::RegisterDetour(const std::string& key, const uintptr_t targetAddress, PVOID* originalFunction, PVOID detourFunction, const uint16_t groupID) {
+        if (ModExists(key))
+            return HandleOfType(key, ModType::Detour);
+        return RegisterForHandle(key, ModArena::MakeShared<Detour>(targetAddress, originalFunction, detourFunction), groupID);
+    }
+
+    // ---- hook tables ----
+
+    // The modification a descriptor asks for; its outputs are only written once it is registered
+    static std::shared_ptr<MemoryModification> MakeHook(const HookDescriptor& hook, const uintptr_t target) {
+        auto* original = static_cast<PVOID*>(hook.OriginalOut);
+        if (hook.Kind == HookKind::NearHook)
+            return ModArena::MakeShared<NearHook>(target, original, hook.Detour());
+        return ModArena::MakeShared<Detour>(target, original, hook.Detour());
+    }
+
+    static void PublishHookTargets(const HookDescriptor& hook, const uintptr_t target) {
+        *hook.TargetOut = target;
+        *static_cast<PVOID*>(hook.OriginalOut) = reinterpret_cast<PVOID>(target);
+    }
+
+    static ModType ModTypeOf(const HookKind kind) {
+        return kind == HookKind::NearHook ? ModType::NearHook : ModType::Detour;
+    }
+
+    size_t MemoryManager::InstallHooks(const std::span<const HookDescriptor> hooks, std::vector<std::string_view>* failedNames) {
+        auto fail = [failedNames](const HookDescriptor& hook) {
+            if (failedNames)
+                failedNames->push_back(hook.Name);
+        };
+
+        // Every symbol in one pass under one AddressDB lock
+        std::vector<AddressQuery> queries;
+        for (const HookDescriptor& hook : hooks) {
+            if (hook.Resolve == HookResolve::Symbol)
+                queries.push_back({ hook.Symbol, hook.Module, hook.SymbolHash });
+        }
+        std::vector<AddressEntry*> entries(queries.size());
+        AddressDB::FindBatch(queries, entries);
+
+        struct PendingHook {
+            const HookDescriptor* Hook;
+            uintptr_t Target;
+            std::shared_ptr<MemoryModification> Mod;
+        };
+        std::vector<PendingHook> pending;
+        pending.reserve(hooks.size());
+
+        size_t installed = 0;
+        size_t query = 0;
+        const TableReader table;
+        for (const HookDescriptor& hook : hooks) {
+            if (hook.Resolve == HookResolve::Deferred) {
+                const bool deferred = DeferredLoader::DeferHook(std::string(hook.Name), std::string(hook.Symbol), std::wstring(hook.Module),
+                    [descriptor = &hook](const uintptr_t address) -> bool {
+                        std::shared_ptr<MemoryModification> existingMod;
+                        if (ModExists(std::string(descriptor->Name), &existingMod)) {
+                            Warn("[MemoryManager] (InstallHooks) %.*s already exists; keeping the existing mod.",
+                                static_cast<int>(descriptor->Name.size()), descriptor->Name.data());
+                            if (existingMod->Type != ModTypeOf(descriptor->Kind))
+                                return false;
+                            // Name##Address and Name##Original must not stay null; an applied mod has
+                            // already written its trampoline to Name##Original
+                            if (existingMod->IsModified)
+                                *descriptor->TargetOut = existingMod->TargetAddress;
+                            else
+                                PublishHookTargets(*descriptor, existingMod->TargetAddress);
+                            return true;
+                        }
+                        if (!AddMod(std::string(descriptor->Name), MakeHook(*descriptor, address), descriptor->GroupID))
+                            return false;
+                        PublishHookTargets(*descriptor, address);
+                        return true;
+                    });
+                if (deferred)
+                    ++installed;
+                else
+                    fail(hook);
+                continue;
+            }
+
+            uintptr_t target = hook.Address;
+            if (hook.Resolve == HookResolve::Symbol) {
+                AddressEntry* entry = entries[query++];
+                target = entry ? entry->GetAddress().value_or(0) : 0;
+                if (!target) {
+                    Error("[%.*s] Could not find %.*s in %.*ls", static_cast<int>(hook.Name.size()), hook.Name.data(),
+                        static_cast<int>(hook.Symbol.size()), hook.Symbol.data(), static_cast<int>(hook.Module.size()), hook.Module.data());
+                    fail(hook);
+                    continue;
+                }
+                Debug("[%.*s] Resolved %.*s at " ADDR_FMT, static_cast<int>(hook.Name.size()), hook.Name.data(),
+                    static_cast<int>(hook.Symbol.size()), hook.Symbol.data(), target);
+            }
+
+            if (table->FindSlot(hook.Name, hook.KeyHash)) {
+                Warn("[MemoryManager] (InstallHooks) %.*s already exists; keeping the existing mod.",
+                    static_cast<int>(hook.Name.size()), hook.Name.data());
+                fail(hook);
+                continue;
+            }
+            pending.push_back({ &hook, target, MakeHook(hook, target) });
+        }
+
+        if (pending.empty())
+            return installed;
+
+        // One lock, one interval rebuild and one snapshot for the whole table
+        std::unique_lock lock(ModsMutex);
+        for (PendingHook& entry : pending) {
+            const HookDescriptor& hook = *entry.Hook;
+            const auto [it, inserted] = Mods.emplace(std::string(hook.Name), entry.Mod);
+            if (!inserted) {
+                Warn("[MemoryManager] (InstallHooks) %.*s already exists; keeping the existing mod.",
+                    static_cast<int>(hook.Name.size()), hook.Name.data());
+                fail(hook);
+                continue;
+            }
+            entry.Mod->Key = it->first;
+            entry.Mod->GroupID = hook.GroupID;
+            PublishHookTargets(hook, entry.Target);
+            ++installed;
+        }
+        RebuildIntervals(Mods);
+        PublishTable(Mods);
+        return installed;
+    }
+
     auto MemoryManager::GetAllMods() -> std::vector<std::shared_ptr<MemoryModification>>
     {
         std::shared_lock lock(ModsMutex);
@@ -132,36 +595,99 @@ namespace ByteWeaver {
         return allMods;
     }
 
+    // Detours among the selected mods share one transaction and patches are written in page runs;
+    // other mods are applied one by one. Patches go first on apply and last on restore, so detours
+    // never hook over a pending patch.
+    template <typename Selector>
+    static bool ApplySelected(const std::map<std::string, std::shared_ptr<MemoryModification>>& mods, Selector selected, const bool apply,
+                              std::vector<std::string>* failedKeys = nullptr)
+    {
+        std::vector<Detour*> detours;
+        std::vector<Patch*> patches;
+        std::vector<MemoryModification*> others;
+        for (const auto& hMod : mods | std::views::values) {
+            if (!hMod || !selected(*hMod))
+                continue;
+            if (auto* detour = dynamic_cast<Detour*>(hMod.get()))
+                detours.push_back(detour);
+            else if (auto* patch = dynamic_cast<Patch*>(hMod.get()))
+                patches.push_back(patch);
+            else
+                others.push_back(hMod.get());
+        }
+
+        bool result = true;
+        if (apply) {
+            result = Patch::ApplyBatch(patches) && result;
+            for (MemoryModification* mod : others) {
+                result = mod->Apply() && result;
+            }
+            result = Detour::ApplyBatch(detours) && result;
+        }
+        else {
+            result = Detour::RestoreBatch(detours) && result;
+            for (MemoryModification* mod : others) {
+                result = mod->Restore() && result;
+            }
+            result = Patch::RestoreBatch(patches) && result;
+        }
+
+        if (!result && failedKeys) {
+            for (const auto& [key, hMod] : mods) {
+                if (hMod && selected(*hMod) && hMod->IsModified != apply)
+                    failedKeys->push_back(key);
+            }
+        }
+        return result;
+    }
+
     bool MemoryManager::ApplyAllMods() {
         std::shared_lock lock(ModsMutex);
-        return std::ranges::all_of(Mods | std::views::values,
-            [](const auto& hMod) -> bool {
-                return hMod->Apply();
-            });
+        return ApplySelected(Mods, [](const MemoryModification&) { return true; }, true);
+    }
+
+    bool MemoryManager::ApplyMods(const std::span<const std::string> keys, std::vector<std::string>* failedKeys) {
+        std::shared_lock lock(ModsMutex);
+
+        bool result = true;
+        std::vector<const MemoryModification*> wanted;
+        wanted.reserve(keys.size());
+        for (const std::string& key : keys) {
+            if (const auto it = Mods.find(key); it != Mods.end() && it->second) {
+                wanted.push_back(it->second.get());
+                continue;
+            }
+            result = false;
+            if (failedKeys)
+                failedKeys->push_back(key);
+        }
+        std::ranges::sort(wanted);
+
+        return ApplySelected(Mods, [&wanted](const MemoryModification& mod) { return std::ranges::binary_search(wanted, &mod); }, true, failedKeys)
+            && result;
     }
 
     bool MemoryManager::RestoreAllMods()
     {
         std::shared_lock lock(ModsMutex);
-
-        return std::ranges::all_of(Mods | std::views::values,
-            [](const auto& hMod) { return hMod->Restore(); });
+        return ApplySelected(Mods, [](const MemoryModification&) { return true; }, false);
     }
 
     void MemoryManager::RestoreAndEraseAllMods()
     {
         std::unique_lock lock(ModsMutex);
-
-        std::erase_if(Mods, [](const auto& pair) {
-            pair.second->Restore();
-            return true;
-        });
+        ApplySelected(Mods, [](const MemoryModification&) { return true; }, false);
+        Mods.clear();
+        RebuildIntervals(Mods);
+        PublishTable(Mods);
     }
 
     void MemoryManager::EraseAllMods()
     {
         std::unique_lock lock(ModsMutex);
         Mods.clear();
+        RebuildIntervals(Mods);
+        PublishTable(Mods);
     }
 
     auto MemoryManager::GetModsByGroupID(const uint16_t groupID)-> std::vector<std::shared_ptr<MemoryModification>>
@@ -180,26 +706,16 @@ namespace ByteWeaver {
         return groupIdMods;
     }
 
-    bool MemoryManager::ApplyByGroupID(const uint16_t groupID)
+    bool MemoryManager::ApplyByGroupID(const uint16_t groupID, std::vector<std::string>* failedKeys)
     {
         std::shared_lock lock(ModsMutex);
-        return std::ranges::all_of(Mods | std::views::values,
-            [groupID](const auto& hMod) -> bool {
-                if (hMod->GroupID == groupID)
-                    return hMod->Apply();
-                return true;
-            });
+        return ApplySelected(Mods, [groupID](const MemoryModification& mod) { return mod.GroupID == groupID; }, true, failedKeys);
     }
 
-    bool MemoryManager::RestoreByGroupID(const uint16_t groupID)
+    bool MemoryManager::RestoreByGroupID(const uint16_t groupID, std::vector<std::string>* failedKeys)
     {
         std::shared_lock lock(ModsMutex);
-        return std::ranges::all_of(Mods | std::views::values,
-            [groupID](const auto& hMod) -> bool {
-                if (hMod->GroupID == groupID)
-                    return hMod->Restore();
-                return true;
-            });
+        return ApplySelected(Mods, [groupID](const MemoryModification& mod) { return mod.GroupID == groupID; }, false, failedKeys);
     }
 
     void MemoryManager::EraseByGroupID(const uint16_t groupID)
@@ -211,19 +727,19 @@ namespace ByteWeaver {
             }
             return false;
         });
-
+        RebuildIntervals(Mods);
+        PublishTable(Mods);
     }
 
     void MemoryManager::RestoreAndEraseByGroupID(const uint16_t groupID)
     {
         std::unique_lock lock(ModsMutex);
+        ApplySelected(Mods, [groupID](const MemoryModification& mod) { return mod.GroupID == groupID; }, false);
         std::erase_if(Mods, [groupID](const auto& pair) {
-            if (pair.second->GroupID == groupID) {
-                pair.second->Restore();
-                return true; // Tells erase_if to erase this element
-            }
-            return false;
+            return pair.second->GroupID == groupID;
         });
+        RebuildIntervals(Mods);
+        PublishTable(Mods);
     }
 
     auto MemoryManager::GetModsByType(const ModType modType)-> std::vector<std::shared_ptr<MemoryModification>>
@@ -242,28 +758,16 @@ namespace ByteWeaver {
         return typeMods;
     }
 
-    bool MemoryManager::ApplyByType(const ModType modType)
+    bool MemoryManager::ApplyByType(const ModType modType, std::vector<std::string>* failedKeys)
     {
         std::shared_lock lock(ModsMutex);
-
-        return std::ranges::all_of(Mods | std::views::values,
-            [modType](const auto& hMod) -> bool {
-                if (hMod->Type == modType && hMod)
-                    return hMod->Apply();
-                return true;
-            });
+        return ApplySelected(Mods, [modType](const MemoryModification& mod) { return mod.Type == modType; }, true, failedKeys);
     }
 
-    bool MemoryManager::RestoreByType(const ModType modType)
+    bool MemoryManager::RestoreByType(const ModType modType, std::vector<std::string>* failedKeys)
     {
         std::shared_lock lock(ModsMutex);
-
-        return std::ranges::all_of(Mods | std::views::values,
-            [modType](const auto& hMod) -> bool {
-                if (hMod->Type == modType)
-                    return hMod->Restore();
-                return true;
-            });
+        return ApplySelected(Mods, [modType](const MemoryModification& mod) { return mod.Type == modType; }, false, failedKeys);
     }
 
     void MemoryManager::EraseByType(const ModType modType)
@@ -276,20 +780,19 @@ namespace ByteWeaver {
             }
             return false;
         });
-
+        RebuildIntervals(Mods);
+        PublishTable(Mods);
     }
 
     void MemoryManager::RestoreAndEraseByType(const ModType modType)
     {
         std::unique_lock lock(ModsMutex);
-
+        ApplySelected(Mods, [modType](const MemoryModification& mod) { return mod.Type == modType; }, false);
         std::erase_if(Mods, [modType](const auto& pair) {
-            if (pair.second->Type == modType) {
-                pair.second->Restore();
-                return true; // Tells erase_if to erase this element
-            }
-            return false;
+            return pair.second->Type == modType;
         });
+        RebuildIntervals(Mods);
+        PublishTable(Mods);
     }
 
     // --- Memory Modifying Functions
@@ -311,25 +814,12 @@ namespace ByteWeaver {
         return addr1 < end2 && addr2 < end1;
     }
 
-    // ReSharper disable once CppTooWideScopeInitStatement // disabled for compiler optimization
     bool MemoryManager::IsLocationModifiedFast(const uintptr_t address, const size_t length, std::vector<const char*>& detectedKeys) {
-        detectedKeys.reserve(Mods.size()); // prevents reallocations
-
-        const uintptr_t endAddress = address + length;
-
-        // loop without any auto-unpacking, just pointers to avoid structured bindings
-        for (auto it = Mods.begin(); it != Mods.end(); ++it) {
-            const MemoryModification* mm = it->second.get(); // direct pointer access
-            const uintptr_t modStart = mm->TargetAddress;
-
-            const uintptr_t modEnd   = modStart + mm->Size;
-
-            // branchless style (compiler may auto-vectorize)
-            if (mm->IsModified & (address < modEnd) & (endAddress > modStart)) {
-                detectedKeys.push_back(it->first.c_str()); // use string pointer to avoid copies
-            }
-        }
-
+        std::shared_lock lock(ModsMutex);
+        ForEachOverlap(address, address + length, [&](const ModInterval& interval) {
+            detectedKeys.push_back(interval.Node->first.c_str()); // use string pointer to avoid copies
+            return true;
+        });
         return !detectedKeys.empty();
     }
 
@@ -341,58 +831,43 @@ namespace ByteWeaver {
             assert(endAddress >= address && "address range overflow");
         }
 
-        for (const auto& [key, mod] : Mods) {
-            if (mod->IsModified) {
-                if (const uintptr_t modEnd = mod->TargetAddress + mod->Size; address < modEnd && endAddress > mod->TargetAddress) {
-                    detectedKeys->push_back(key);
-                }
-            }
-        }
+        std::shared_lock lock(ModsMutex);
+        bool modified = false;
+        ForEachOverlap(address, endAddress, [&](const ModInterval& interval) {
+            modified = true;
+            if (!detectedKeys)
+                return false; // the first hit answers the question
+            detectedKeys->push_back(interval.Node->first);
+            return true;
+        });
+        return modified;
+    }
 
-        return !detectedKeys->empty();
+    auto MemoryManager::FindModAt(const uintptr_t address, std::string* outKey) -> std::shared_ptr<MemoryModification> {
+        std::shared_lock lock(ModsMutex);
+        std::shared_ptr<MemoryModification> owner;
+        ForEachOverlap(address, address + 1, [&](const ModInterval& interval) {
+            owner = interval.Node->second;
+            if (outKey)
+                *outKey = interval.Node->first;
+            return false;
+        });
+        return owner;
     }
 
     bool MemoryManager::IsAddressValid(const uintptr_t address) {
-        MEMORY_BASIC_INFORMATION mbi;
-        if (VirtualQueryEx(GetCurrentProcess(), reinterpret_cast<void*>(address), &mbi, sizeof(mbi))) {
-            return mbi.State == MEM_COMMIT &&
-                mbi.Protect & (PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY |
-                    PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE);
-        }
-        return false;
+        const auto region = RegionMap::Query(address);
+        return region.has_value() && region->Protect & RegionMap::ReadableProtections;
     }
 
     bool MemoryManager::IsMemoryRangeValid(const uintptr_t address, const size_t length) {
-        uintptr_t currentAddress = address;
-        const uintptr_t endAddress = address + length;
-
-        while (currentAddress < endAddress) {
-            MEMORY_BASIC_INFORMATION mbi;
-            if (VirtualQueryEx(GetCurrentProcess(), reinterpret_cast<void*>(currentAddress), &mbi, sizeof(mbi))) {
-                if (mbi.State != MEM_COMMIT ||
-                    !(mbi.Protect & (PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY |
-                        PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE)))
-                {
-                    return false;
-                }
-                currentAddress = reinterpret_cast<uintptr_t>(mbi.BaseAddress) + mbi.RegionSize;
-            }
-            else {
-                return false;
-            }
-        }
-        return true;
+        return RegionMap::IsRangeAccessible(address, length, RegionMap::ReadableProtections);
     }
 
     bool MemoryManager::IsAddressReadable(const uintptr_t address)
     {
-        MEMORY_BASIC_INFORMATION mbi;
-        if (VirtualQueryEx(GetCurrentProcess(), reinterpret_cast<void*>(address), &mbi, sizeof(mbi)))
-        {
-            return mbi.State == MEM_COMMIT &&
-                mbi.Protect & PAGE_READONLY;
-        }
-        return false;
+        const auto region = RegionMap::Query(address);
+        return region.has_value() && region->Protect & PAGE_READONLY;
     }
 
     uintptr_t MemoryManager::ReadAddress(const uintptr_t address) {
@@ -431,12 +906,12 @@ namespace ByteWeaver {
 
     uintptr_t MemoryManager::GetModuleBaseAddress(const wchar_t* moduleName)
     {
-        if (HMODULE hMod = GetModuleHandleW(moduleName); !hMod) {
-            Error("%s not loaded yet.", moduleName);
+        if (const auto module = ModuleRegistry::Find(moduleName); !module) {
+            Error("%ls not loaded yet.", moduleName);
             return NULL;
         }
         else {
-            return reinterpret_cast<uintptr_t>(hMod);
+            return reinterpret_cast<uintptr_t>(module->Base);
         }
     }
 
@@ -462,16 +937,14 @@ namespace ByteWeaver {
 
     std::pair<uintptr_t, uintptr_t> MemoryManager::GetModuleBounds(const uintptr_t address)
     {
-        uintptr_t moduleBase = GetModuleBaseAddressFast(address);
-        if (!moduleBase) {
+        const auto module = ModuleRegistry::FindByAddress(address);
+        if (!module) {
             Error("[GetModuleBounds] Address " ADDR_FMT " is not inside a module!", address);
             return { 0,0 };
         }
 
-        const auto* dos = reinterpret_cast<IMAGE_DOS_HEADER*>(moduleBase);
-        const auto* nt = reinterpret_cast<IMAGE_NT_HEADERS*>(moduleBase + dos->e_lfanew);
-
-        return { moduleBase , moduleBase + nt->OptionalHeader.SizeOfImage };
+        const auto moduleBase = reinterpret_cast<uintptr_t>(module->Base);
+        return { moduleBase , moduleBase + module->Size };
     }
 
     fs::path MemoryManager::GetModulePath(const uintptr_t moduleBase)
@@ -533,16 +1006,123 @@ namespace ByteWeaver {
         outFile.close();
     }
 
-    std::vector<uint8_t> MemoryManager::ReadBytesSafe(const uintptr_t address, const size_t size) {
+    std::span<const uint8_t> MemoryManager::ReadSpanSafe(const uintptr_t address, const size_t size) {
         if (!address || !size)
             return {};
 
         if (!IsMemoryRangeValid(address, size))
             return {};
 
-        std::vector<uint8_t> buffer(size);
-        std::memcpy(buffer.data(), reinterpret_cast<const void*>(address), size);
-        return buffer;
+        return { reinterpret_cast<const uint8_t*>(address), size };
+    }
+
+    std::vector<uint8_t> MemoryManager::ReadBytesSafe(const uintptr_t address, const size_t size) {
+        const std::span<const uint8_t> bytes = ReadSpanSafe(address, size);
+        return { bytes.begin(), bytes.end() };
+    }
+
+    // ---- batched reads ----
+
+    uint8_t* ReadArena::Allocate(const size_t size) {
+        constexpr size_t alignment = alignof(std::max_align_t);
+        const size_t aligned = (size + alignment - 1) & ~(alignment - 1);
+
+        // The tail of a block too small for this request is skipped, never split
+        for (; _Current < _Blocks.size(); ++_Current, _Offset = 0) {
+            if (Block& block = _Blocks[_Current]; block.Size - _Offset >= aligned) {
+                uint8_t* data = block.Data.get() + _Offset;
+                _Offset += aligned;
+                _Used += aligned;
+                return data;
+            }
+        }
+
+        const size_t blockSize = (std::max)(_BlockSize, aligned);
+        _Blocks.push_back({ std::make_unique_for_overwrite<uint8_t[]>(blockSize), blockSize });
+        _Current = _Blocks.size() - 1;
+        _Offset = aligned;
+        _Used += aligned;
+        return _Blocks.back().Data.get();
+    }
+
+    void ReadArena::Reset() noexcept {
+        _Current = 0;
+        _Offset = 0;
+        _Used = 0;
+    }
+
+    // Performs requests from *index on until one faults. Returns 0 once all are done, or the
+    // exception code with *index at the faulting request. Kept free of destructible locals for __try.
+    static DWORD GuardedReadBatch(ReadRequest* requests, const size_t count, size_t* index) {
+        __try {
+            for (; *index < count; ++*index) {
+                ReadRequest& request = requests[*index];
+                request.Succeeded = false;
+                if (!request.Address || !request.Length || !request.Destination ||
+                    request.Address + request.Length < request.Address)
+                    continue;
+                memcpy(request.Destination, reinterpret_cast<const void*>(request.Address), request.Length);
+                request.Succeeded = true;
+            }
+            return 0;
+        }
+        __except (EXCEPTION_EXECUTE_HANDLER) {
+            return GetExceptionCode();
+        }
+    }
+
+    // Dereferences every offset but the last, adds the last, then copies length bytes from there
+    // when destination is set. Kept free of destructible locals for __try.
+    static bool GuardedWalkChain(uintptr_t address, const ptrdiff_t* offsets, const size_t count,
+        void* destination, const size_t length, uintptr_t* result) {
+        __try {
+            for (size_t i = 0; i + 1 < count; ++i) {
+                address = *reinterpret_cast<const uintptr_t*>(address + offsets[i]);
+                if (!address)
+                    return false;
+            }
+            if (count)
+                address += offsets[count - 1];
+            if (destination)
+                memcpy(destination, reinterpret_cast<const void*>(address), length);
+            *result = address;
+            return true;
+        }
+        __except (EXCEPTION_EXECUTE_HANDLER) {
+            return false;
+        }
+    }
+
+    size_t MemoryManager::ReadBatch(const std::span<ReadRequest> requests) {
+        // One frame for the whole batch; it is only set up again after a fault
+        for (size_t index = 0; index < requests.size(); ++index) {
+            if (GuardedReadBatch(requests.data(), requests.size(), &index) == 0)
+                break;
+        }
+        return static_cast<size_t>(std::ranges::count_if(requests, &ReadRequest::Succeeded));
+    }
+
+    size_t MemoryManager::ReadBatch(const std::span<ReadRequest> requests, ReadArena& arena) {
+        for (ReadRequest& request : requests) {
+            if (!request.Destination && request.Address && request.Length)
+                request.Destination = arena.Allocate(request.Length);
+        }
+        return ReadBatch(requests);
+    }
+
+    uintptr_t MemoryManager::ResolvePointerChain(const uintptr_t base, const std::span<const ptrdiff_t> offsets) {
+        uintptr_t result = 0;
+        if (!base || !GuardedWalkChain(base, offsets.data(), offsets.size(), nullptr, 0, &result))
+            return 0;
+        return result;
+    }
+
+    bool MemoryManager::ReadPointerChain(const uintptr_t base, const std::span<const ptrdiff_t> offsets,
+        void* destination, const size_t length) {
+        uintptr_t result = 0;
+        if (!base || !destination || !length)
+            return false;
+        return GuardedWalkChain(base, offsets.data(), offsets.size(), destination, length, &result);
     }
 
     std::string MemoryManager::BytesToHex(const std::vector<uint8_t>& data) {
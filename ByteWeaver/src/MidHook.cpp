@@ -0,0 +1,164 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include <MidHook.h>
+#include <TrampolinePool.h>
+
+namespace ByteWeaver
+{
+    // Slot layout: [callback pointer][stub][relocated instructions + jmp back]
+    constexpr size_t CallbackSlotSize = 8;
+    constexpr int32_t ContextSize = (sizeof(MidHookContext) + 15) & ~size_t{ 15 };
+    constexpr unsigned StackPointer = 4;
+    constexpr unsigned Scratch = 0; // rax/eax: clobbered by the call anyway, saved first when live
+
+    #if defined(_WIN64)
+        constexpr int32_t CallFrameSize = 48;   // 32 bytes of shadow space, then the saved stack pointer
+        constexpr int32_t SavedStackPointer = 32;
+    #else
+        constexpr int32_t CallFrameSize = 16;   // the argument, then the saved stack pointer
+        constexpr int32_t SavedStackPointer = 8;
+    #endif
+
+    static_assert(offsetof(MidHookContext, Flags) == Registers::GpCount * sizeof(uintptr_t));
+    static_assert(offsetof(MidHookContext, Xmm) % 16 == 0);
+
+    static int32_t GpOffset(const unsigned index) { return static_cast<int32_t>(index * sizeof(uintptr_t)); }
+    static int32_t XmmOffset(const unsigned index) { return static_cast<int32_t>(offsetof(MidHookContext, Xmm) + index * 16); }
+    constexpr int32_t FlagsOffset = offsetof(MidHookContext, Flags);
+
+    // ---- encoding ----
+
+    // [REX] opcode ModRM(reg, [rsp + displacement]) SIB disp8/disp32
+    static void EmitStackOperand(std::vector<uint8_t>& code, const bool wide, const std::initializer_list<uint8_t> opcode,
+                                 const unsigned reg, const int32_t displacement) {
+        if constexpr (WIN64) {
+            const uint8_t rex = 0x40 | (wide ? 0x08 : 0) | (reg >= 8 ? 0x04 : 0);
+            if (rex != 0x40)
+                code.push_back(rex);
+        }
+        code.insert(code.end(), opcode);
+
+        const bool shortDisplacement = displacement >= INT8_MIN && displacement <= INT8_MAX;
+        code.push_back(static_cast<uint8_t>((shortDisplacement ? 0x40 : 0x80) | ((reg & 7) << 3) | 0x04));
+        code.push_back(0x24);
+        if (shortDisplacement) {
+            code.push_back(static_cast<uint8_t>(displacement));
+        } else {
+            const auto* bytes = reinterpret_cast<const uint8_t*>(&displacement);
+            code.insert(code.end(), bytes, bytes + sizeof(displacement));
+        }
+    }
+
+    // Register-to-register or immediate forms, with REX.W on x64
+    static void EmitWide(std::vector<uint8_t>& code, const std::initializer_list<uint8_t> bytes) {
+        if constexpr (WIN64)
+            code.push_back(0x48);
+        code.insert(code.end(), bytes);
+    }
+
+    static void EmitSave(std::vector<uint8_t>& code, const RegisterMask live) {
+        for (unsigned i = 0; i < Registers::GpCount; ++i) {
+            if (i != StackPointer && (live & Registers::Gp(i)))
+                EmitStackOperand(code, true, { 0x89 }, i, GpOffset(i));                     // mov [rsp+o], r
+        }
+        for (unsigned i = 0; i < Registers::XmmCount; ++i) {
+            if (live & Registers::Xmm(i))
+                EmitStackOperand(code, false, { 0x0F, 0x11 }, i, XmmOffset(i));             // movups [rsp+o], xmm
+        }
+        if (live & Registers::Flags) {
+            code.push_back(0x9C);                                                           // pushf
+            EmitStackOperand(code, false, { 0x8F }, 0, FlagsOffset);                        // pop [rsp+o]
+        }
+    }
+
+    static void EmitLoad(std::vector<uint8_t>& code, const RegisterMask live) {
+        if (live & Registers::Flags) {
+            EmitStackOperand(code, false, { 0xFF }, 6, FlagsOffset);                        // push [rsp+o]
+            code.push_back(0x9D);                                                           // popf
+        }
+        for (unsigned i = 0; i < Registers::XmmCount; ++i) {
+            if (live & Registers::Xmm(i))
+                EmitStackOperand(code, false, { 0x0F, 0x10 }, i, XmmOffset(i));             // movups xmm, [rsp+o]
+        }
+        for (unsigned i = 0; i < Registers::GpCount; ++i) {
+            if (i != StackPointer && (live & Registers::Gp(i)))
+                EmitStackOperand(code, true, { 0x8B }, i, GpOffset(i));                     // mov r, [rsp+o]
+        }
+    }
+
+    // The stub, to run at codeAddress and call through the pointer stored at callbackAddress.
+    // Nothing between the first and last instruction touches the flags before they are saved or
+    // after they are loaded: the frame is moved with lea, not add/sub.
+    static std::vector<uint8_t> BuildStub(const uintptr_t codeAddress, const uintptr_t callbackAddress, const RegisterMask live) {
+        std::vector<uint8_t> code;
+        code.reserve(512);
+
+        EmitStackOperand(code, true, { 0x8D }, StackPointer, -ContextSize);                 // lea rsp, [rsp-ctx]
+        EmitSave(code, live);
+
+        EmitStackOperand(code, true, { 0x8D }, Scratch, ContextSize);                       // lea rax, [rsp+ctx]
+        EmitStackOperand(code, true, { 0x89 }, Scratch, GpOffset(StackPointer));            // mov [rsp+o], rax
+        EmitWide(code, { 0x89, 0xE0 });                                                     // mov rax, rsp
+        EmitWide(code, { 0x83, 0xE4, 0xF0 });                                               // and rsp, -16
+        EmitWide(code, { 0x83, 0xEC, static_cast<uint8_t>(CallFrameSize) });               // sub rsp, frame
+        EmitStackOperand(code, true, { 0x89 }, Scratch, SavedStackPointer);                 // mov [rsp+s], rax
+        if constexpr (WIN64)
+            EmitWide(code, { 0x89, 0xC1 });                                                 // mov rcx, rax
+        else
+            code.insert(code.end(), { 0x89, 0x04, 0x24 });                                  // mov [esp], eax
+
+        // call [callback]: rip-relative on x64, absolute on x86
+        code.insert(code.end(), { 0xFF, 0x15 });
+        int32_t operand;
+        if constexpr (WIN64)
+            operand = static_cast<int32_t>(callbackAddress - (codeAddress + code.size() + sizeof(operand)));
+        else
+            operand = static_cast<int32_t>(callbackAddress);
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&operand);
+        code.insert(code.end(), bytes, bytes + sizeof(operand));
+
+        EmitStackOperand(code, true, { 0x8B }, StackPointer, SavedStackPointer);            // mov rsp, [rsp+s]
+        EmitLoad(code, live);
+        EmitStackOperand(code, true, { 0x8D }, StackPointer, ContextSize);                  // lea rsp, [rsp+ctx]
+        return code;
+    }
+
+    static size_t SlotsFor(const RegisterMask live) {
+        const size_t bytes = CallbackSlotSize + MidHook::StubSize(live) + InlineHook::RelocatedCapacity;
+        return (bytes + TrampolinePool::SlotSize - 1) / TrampolinePool::SlotSize;
+    }
+
+    // ---- mid hook ----
+    size_t MidHook::StubSize(const RegisterMask liveRegisters)
+    {
+        return BuildStub(0, 0, liveRegisters & Registers::All).size();
+    }
+
+    MidHook::MidHook(const uintptr_t targetAddress, MidHookCallback callback, const RegisterMask liveRegisters)
+        : InlineHook(targetAddress, ModType::MidHook, SlotsFor(liveRegisters & Registers::All)),
+          Callback(callback), LiveRegisters(liveRegisters & Registers::All)
+    {
+    }
+
+    bool MidHook::Apply()
+    {
+        if (!IsModified && (!Callback || TargetAddress == 0)) {
+            Error("[MidHook] Invalid parameters: " ADDR_FMT, TargetAddress);
+            return false;
+        }
+        return InlineHook::Apply();
+    }
+
+    std::optional<size_t> MidHook::WriteEntry(uint8_t* slot, uintptr_t& entry)
+    {
+        const auto callbackAddress = reinterpret_cast<uintptr_t>(slot);
+        entry = callbackAddress + CallbackSlotSize;
+
+        const auto callback = reinterpret_cast<uint64_t>(Callback);
+        memcpy(slot, &callback, sizeof(callback));
+
+        const std::vector<uint8_t> stub = BuildStub(entry, callbackAddress, LiveRegisters);
+        memcpy(slot + CallbackSlotSize, stub.data(), stub.size());
+        return CallbackSlotSize + stub.size();
+    }
+}
@@ -0,0 +1,101 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include <ModArena.h>
+
+namespace ByteWeaver {
+
+    static constexpr size_t ClassCount = ModArena::MaxCellSize / ModArena::CellSize;
+
+    // Intentionally leaked, see ModArena
+    struct ArenaState {
+        std::mutex Mutex;
+        std::vector<std::unique_ptr<uint8_t[]>> Blocks;
+        std::array<void*, ClassCount> FreeLists{};  // singly linked through the first word of each cell
+        uint8_t* Cursor = nullptr;                   // unused tail of the newest block
+        size_t Remaining = 0;
+        size_t Reserved = 0;
+        size_t InUse = 0;
+    };
+
+    static ArenaState& State() {
+        static ArenaState* state = new ArenaState();
+        return *state;
+    }
+
+    static bool IsPooled(const size_t size, const size_t alignment) {
+        return size != 0 && size <= ModArena::MaxCellSize && alignment <= ModArena::CellSize;
+    }
+
+    static size_t ClassOf(const size_t size) {
+        return (size + ModArena::CellSize - 1) / ModArena::CellSize - 1;
+    }
+
+    void* ModArena::Allocate(const size_t size, const size_t alignment) {
+        if (!IsPooled(size, alignment))
+            return ::operator new(size, std::align_val_t{ (std::max)(alignment, alignof(std::max_align_t)) });
+
+        const size_t sizeClass = ClassOf(size);
+        const size_t cellBytes = (sizeClass + 1) * CellSize;
+        ArenaState& state = State();
+        std::lock_guard lock(state.Mutex);
+
+        void* cell = state.FreeLists[sizeClass];
+        if (cell) {
+            state.FreeLists[sizeClass] = *static_cast<void**>(cell);
+        } else {
+            if (state.Remaining < cellBytes) {
+                // The tail of the old block is too small for this class; hand it to the free lists
+                while (state.Remaining >= CellSize) {
+                    const size_t tailClass = (std::min)(state.Remaining / CellSize - 1, ClassCount - 1);
+                    const size_t tailBytes = (tailClass + 1) * CellSize;
+                    *reinterpret_cast<void**>(state.Cursor) = state.FreeLists[tailClass];
+                    state.FreeLists[tailClass] = state.Cursor;
+                    state.Cursor += tailBytes;
+                    state.Remaining -= tailBytes;
+                }
+
+                // operator new[] only guarantees max_align_t, so over-allocate and align the cursor
+                auto block = std::make_unique<uint8_t[]>(BlockSize + CellSize);
+                const auto base = reinterpret_cast<uintptr_t>(block.get());
+                state.Cursor = reinterpret_cast<uint8_t*>((base + CellSize - 1) & ~(CellSize - 1));
+                state.Remaining = BlockSize;
+                state.Reserved += BlockSize;
+                state.Blocks.push_back(std::move(block));
+            }
+            cell = state.Cursor;
+            state.Cursor += cellBytes;
+            state.Remaining -= cellBytes;
+        }
+
+        state.InUse += cellBytes;
+        return cell;
+    }
+
+    void ModArena::Free(void* pointer, const size_t size, const size_t alignment) noexcept {
+        if (!pointer)
+            return;
+        if (!IsPooled(size, alignment)) {
+            ::operator delete(pointer, std::align_val_t{ (std::max)(alignment, alignof(std::max_align_t)) });
+            return;
+        }
+
+        const size_t sizeClass = ClassOf(size);
+        ArenaState& state = State();
+        std::lock_guard lock(state.Mutex);
+        *static_cast<void**>(pointer) = state.FreeLists[sizeClass];
+        state.FreeLists[sizeClass] = pointer;
+        state.InUse -= (sizeClass + 1) * CellSize;
+    }
+
+    size_t ModArena::BytesReserved() {
+        ArenaState& state = State();
+        std::lock_guard lock(state.Mutex);
+        return state.Reserved;
+    }
+
+    size_t ModArena::BytesInUse() {
+        ArenaState& state = State();
+        std::lock_guard lock(state.Mutex);
+        return state.InUse;
+    }
+}
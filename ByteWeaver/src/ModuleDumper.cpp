@@ -0,0 +1,462 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include <ModuleDumper.h>
+#include <BlockCodec.h>
+#include <ModuleDumpFormat.hpp>
+#include <MemoryManager.h>
+#include <RegionMap.h>
+
+namespace ByteWeaver {
+
+    namespace Format = ModuleDumpFormat;
+
+    static constexpr size_t MaxChunkSize = 64 * 1024 * 1024;
+    static constexpr size_t WritesInFlight = 4;
+
+    // Limits a dump file must respect before Load() allocates for it
+    static constexpr uint32_t MaxNameLength = 32767;            // longest Windows path, in UTF-16 units
+    static constexpr uint32_t MaxSectionCount = 96;             // the loader's limit
+    static constexpr uint32_t MaxImageSize = 0x80000000;        // 2 GiB, the largest image Windows maps
+
+    // A range of the image, copied by the reading thread and packed by the worker
+    struct DumpChunk {
+        uint32_t Rva = 0;
+        uint32_t Size = 0;
+        std::unique_ptr<uint8_t[]> Data;  // null if the range could not be read
+    };
+
+    // Bounded hand-off from the reading thread to the worker
+    class ChunkQueue {
+    public:
+        explicit ChunkQueue(const size_t capacity) : _Capacity((std::max)(capacity, size_t{ 1 })) {}
+
+        void Push(DumpChunk chunk) {
+            std::unique_lock lock(_Mutex);
+            _NotFull.wait(lock, [this] { return _Chunks.size() < _Capacity; });
+            _Chunks.push_back(std::move(chunk));
+            _NotEmpty.notify_one();
+        }
+
+        // Returns false once the queue is closed and drained
+        bool Pop(DumpChunk& chunk) {
+            std::unique_lock lock(_Mutex);
+            _NotEmpty.wait(lock, [this] { return !_Chunks.empty() || _Closed; });
+            if (_Chunks.empty())
+                return false;
+            chunk = std::move(_Chunks.front());
+            _Chunks.pop_front();
+            _NotFull.notify_one();
+            return true;
+        }
+
+        void Close() {
+            std::lock_guard lock(_Mutex);
+            _Closed = true;
+            _NotEmpty.notify_all();
+        }
+
+    private:
+        std::mutex _Mutex;
+        std::condition_variable _NotFull;
+        std::condition_variable _NotEmpty;
+        std::deque<DumpChunk> _Chunks;
+        size_t _Capacity;
+        bool _Closed = false;
+    };
+
+    // Sequential overlapped writes from one thread; a few are in flight, each owning its buffer
+    class OverlappedWriter {
+    public:
+        explicit OverlappedWriter(const HANDLE file) : _File(file) {
+            for (Slot& slot : _Slots)
+                slot.Overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        }
+
+        ~OverlappedWriter() {
+            Finish();
+            for (Slot& slot : _Slots) {
+                if (slot.Overlapped.hEvent)
+                    CloseHandle(slot.Overlapped.hEvent);
+            }
+        }
+
+        OverlappedWriter(const OverlappedWriter&) = delete;
+        OverlappedWriter& operator=(const OverlappedWriter&) = delete;
+
+        bool Write(std::vector<uint8_t> bytes) {
+            Slot& slot = _Slots[_Next];
+            _Next = (_Next + 1) % _Slots.size();
+            if (!Complete(slot) || !slot.Overlapped.hEvent) {
+                _Failed = true;
+                return false;
+            }
+
+            slot.Buffer = std::move(bytes);
+            slot.Overlapped.Offset = static_cast<DWORD>(_Offset);
+            slot.Overlapped.OffsetHigh = static_cast<DWORD>(_Offset >> 32);
+            ResetEvent(slot.Overlapped.hEvent);
+            _Offset += slot.Buffer.size();
+
+            if (!WriteFile(_File, slot.Buffer.data(), static_cast<DWORD>(slot.Buffer.size()), nullptr, &slot.Overlapped) &&
+                GetLastError() != ERROR_IO_PENDING) {
+                Error("[ModuleDumper] WriteFile failed at offset %llu. Error %lu", _Offset - slot.Buffer.size(), GetLastError());
+                _Failed = true;
+                return false;
+            }
+            slot.Pending = true;
+            return true;
+        }
+
+        // Waits for every write; returns false if any failed
+        bool Finish() {
+            for (Slot& slot : _Slots)
+                Complete(slot);
+            return !_Failed;
+        }
+
+    private:
+        struct Slot {
+            OVERLAPPED Overlapped{};
+            std::vector<uint8_t> Buffer;
+            bool Pending = false;
+        };
+
+        bool Complete(Slot& slot) {
+            if (!slot.Pending)
+                return !_Failed;
+            slot.Pending = false;
+            DWORD written = 0;
+            if (!GetOverlappedResult(_File, &slot.Overlapped, &written, TRUE) || written != slot.Buffer.size()) {
+                Error("[ModuleDumper] Overlapped write failed. Error %lu", GetLastError());
+                _Failed = true;
+            }
+            return !_Failed;
+        }
+
+        HANDLE _File;
+        std::array<Slot, WritesInFlight> _Slots{};
+        size_t _Next = 0;
+        uint64_t _Offset = 0;
+        bool _Failed = false;
+    };
+
+    static size_t PageSize() {
+        static const size_t pageSize = [] {
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            return static_cast<size_t>(info.dwPageSize);
+        }();
+        return pageSize;
+    }
+
+    // Returns 0 or the exception code; kept free of destructible locals for __try
+    static DWORD GuardedCopy(void* destination, const void* source, const size_t size) {
+        __try {
+            memcpy(destination, source, size);
+            return 0;
+        }
+        __except (EXCEPTION_EXECUTE_HANDLER) {
+            return GetExceptionCode();
+        }
+    }
+
+    // Bytes an applied mod replaced, at their offset in the module
+    struct ActiveMod {
+        uint32_t Rva = 0;
+        std::vector<uint8_t> OriginalBytes;
+    };
+
+    // Snapshot of the mods applied inside the module when the dump starts
+    static std::vector<ActiveMod> CollectActiveMods(const LoadedModule& module) {
+        std::vector<ActiveMod> active;
+        const auto base = reinterpret_cast<uintptr_t>(module.Base);
+        for (const auto& mod : MemoryManager::GetAllMods()) {
+            if (!mod->IsModified || mod->OriginalBytes.size() == 0)
+                continue;
+            if (mod->TargetAddress < base || mod->TargetAddress - base >= module.Size)
+                continue;
+            active.push_back({ static_cast<uint32_t>(mod->TargetAddress - base), mod->OriginalBytes });
+        }
+        return active;
+    }
+
+    // Puts the original bytes of every active mod back into a copied chunk; returns the bytes replaced
+    static size_t RestoreOriginalBytes(DumpChunk& chunk, const std::vector<ActiveMod>& mods) {
+        size_t restored = 0;
+        const size_t chunkEnd = static_cast<size_t>(chunk.Rva) + chunk.Size;
+        for (const ActiveMod& mod : mods) {
+            const size_t modEnd = static_cast<size_t>(mod.Rva) + mod.OriginalBytes.size();
+            const size_t begin = (std::max)(static_cast<size_t>(chunk.Rva), static_cast<size_t>(mod.Rva));
+            const size_t end = (std::min)(chunkEnd, modEnd);
+            if (begin >= end)
+                continue;
+            memcpy(chunk.Data.get() + (begin - chunk.Rva), mod.OriginalBytes.data() + (begin - mod.Rva), end - begin);
+            restored += end - begin;
+        }
+        return restored;
+    }
+
+    static std::vector<uint8_t> BuildPreamble(const LoadedModule& module, const size_t chunkSize) {
+        Format::FileHeader header{};
+        memcpy(header.Magic, Format::Magic, sizeof(header.Magic));
+        header.Version = Format::Version;
+        header.TimeDateStamp = module.Identity.TimeDateStamp;
+        header.CheckSum = module.Identity.CheckSum;
+        header.SizeOfImage = static_cast<uint32_t>(module.Size);
+        header.ImageBase = reinterpret_cast<uintptr_t>(module.Base);
+        header.NameLength = static_cast<uint32_t>(module.Name.size());
+        header.SectionCount = static_cast<uint32_t>(module.Sections.size());
+        header.ChunkSize = static_cast<uint32_t>(chunkSize);
+
+        const size_t nameBytes = module.Name.size() * sizeof(wchar_t);
+        std::vector<uint8_t> preamble(sizeof(header) + nameBytes + module.Sections.size() * sizeof(Format::SectionRecord));
+        uint8_t* out = preamble.data();
+        memcpy(out, &header, sizeof(header));
+        out += sizeof(header);
+        memcpy(out, module.Name.data(), nameBytes);
+        out += nameBytes;
+
+        for (const ModuleSection& section : module.Sections) {
+            Format::SectionRecord record{};
+            memcpy(record.Name, section.Name.data(), (std::min)(section.Name.size(), sizeof(record.Name)));
+            record.Rva = section.Rva;
+            record.Size = section.Size;
+            record.Characteristics = section.Characteristics;
+            memcpy(out, &record, sizeof(record));
+            out += sizeof(record);
+        }
+        return preamble;
+    }
+
+    // Header and payload of one chunk, compressed when that makes it smaller
+    static std::vector<uint8_t> PackChunk(const DumpChunk& chunk, const bool compress) {
+        Format::ChunkHeader header{ chunk.Rva, chunk.Size, 0, 0 };
+        if (!chunk.Data) {
+            header.Flags = Format::ChunkFlags::Unreadable;
+            std::vector<uint8_t> frame(sizeof(header));
+            memcpy(frame.data(), &header, sizeof(header));
+            return frame;
+        }
+
+        std::vector<uint8_t> frame(sizeof(header) + (compress ? BlockCodec::CompressBound(chunk.Size) : chunk.Size));
+        uint8_t* payload = frame.data() + sizeof(header);
+        const size_t packed = compress ? BlockCodec::Compress(chunk.Data.get(), chunk.Size, payload, frame.size() - sizeof(header)) : 0;
+        if (packed && packed < chunk.Size) {
+            header.Flags = Format::ChunkFlags::Compressed;
+            header.StoredSize = static_cast<uint32_t>(packed);
+        } else {
+            memcpy(payload, chunk.Data.get(), chunk.Size);
+            header.StoredSize = chunk.Size;
+        }
+        frame.resize(sizeof(header) + header.StoredSize);
+        memcpy(frame.data(), &header, sizeof(header));
+        return frame;
+    }
+
+    // Copies [rva, rva + size) into a chunk; a faulting chunk is retried one page at a time
+    static void ReadChunk(const LoadedModule& module, const uint32_t rva, const uint32_t size, ChunkQueue& queue) {
+        auto data = std::make_unique_for_overwrite<uint8_t[]>(size);
+        if (GuardedCopy(data.get(), module.Base + rva, size) == 0) {
+            queue.Push({ rva, size, std::move(data) });
+            return;
+        }
+
+        const auto page = static_cast<uint32_t>(PageSize());
+        for (uint32_t offset = 0; offset < size;) {
+            const uint32_t length = (std::min)(size - offset, page - (rva + offset) % page);
+            auto pageData = std::make_unique_for_overwrite<uint8_t[]>(length);
+            if (GuardedCopy(pageData.get(), module.Base + rva + offset, length) != 0)
+                pageData.reset();
+            queue.Push({ rva + offset, length, std::move(pageData) });
+            offset += length;
+        }
+    }
+
+    // Walks [rva, end) region by region, queueing readable ranges in chunks and the rest as unreadable.
+    // Asks VirtualQuery rather than RegionMap: a dump must see the protections as they are now.
+    static void ReadRange(const LoadedModule& module, uint32_t rva, const uint32_t end, const size_t chunkSize, ChunkQueue& queue) {
+        while (rva < end) {
+            const auto address = reinterpret_cast<uintptr_t>(module.Base) + rva;
+            MEMORY_BASIC_INFORMATION mbi;
+            if (!VirtualQuery(reinterpret_cast<LPCVOID>(address), &mbi, sizeof(mbi))) {
+                queue.Push({ rva, end - rva, nullptr });
+                return;
+            }
+
+            const uintptr_t regionEnd = reinterpret_cast<uintptr_t>(mbi.BaseAddress) + mbi.RegionSize;
+            const auto spanEnd = static_cast<uint32_t>((std::min)(static_cast<uintptr_t>(end), regionEnd - reinterpret_cast<uintptr_t>(module.Base)));
+            const bool readable = mbi.State == MEM_COMMIT && (mbi.Protect & RegionMap::ReadableProtections) && !(mbi.Protect & PAGE_GUARD);
+
+            if (!readable) {
+                queue.Push({ rva, spanEnd - rva, nullptr });
+            } else {
+                for (uint32_t offset = rva; offset < spanEnd; offset += static_cast<uint32_t>(chunkSize))
+                    ReadChunk(module, offset, static_cast<uint32_t>((std::min)(chunkSize, static_cast<size_t>(spanEnd - offset))), queue);
+            }
+            rva = spanEnd;
+        }
+    }
+
+    // The whole image, so the headers, every section and the padding between them are all in the dump
+    // (ranges that are not committed are recorded as unreadable by ReadRange)
+    static void ReadImage(const LoadedModule& module, const size_t chunkSize, ChunkQueue& queue) {
+        ReadRange(module, 0, static_cast<uint32_t>(module.Size), chunkSize, queue);
+    }
+
+    DumpResult ModuleDumper::Dump(const std::wstring& moduleName, const fs::path& outPath, const DumpOptions& options) {
+        const auto module = ModuleRegistry::Find(moduleName);
+        if (!module) {
+            Error("[ModuleDumper] Module %ls is not loaded", moduleName.c_str());
+            return {};
+        }
+        return Dump(*module, outPath, options);
+    }
+
+    DumpResult ModuleDumper::Dump(const LoadedModule& module, const fs::path& outPath, const DumpOptions& options) {
+        DumpResult result;
+        if (!module.Base || !module.Size || module.Size > UINT32_MAX)
+            return result;
+
+        const size_t page = PageSize();
+        const size_t chunkSize = ((std::clamp)(options.ChunkSize, page, MaxChunkSize) + page - 1) & ~(page - 1);
+
+        const HANDLE file = CreateFileW(outPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                                        FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            Error("[ModuleDumper] Failed to create %ls. Error %lu", outPath.c_str(), GetLastError());
+            return result;
+        }
+
+        // Taken before reading so the dump shows the module as it was loaded, not as it is hooked
+        const std::vector<ActiveMod> activeMods = CollectActiveMods(module);
+
+        bool written;
+        bool read = true;
+        {
+            OverlappedWriter writer(file);
+            writer.Write(BuildPreamble(module, chunkSize));
+
+            // The worker packs and writes while this thread reads the next chunks
+            ChunkQueue queue(options.ChunksInFlight);
+            std::thread worker([&] {
+                DumpChunk chunk;
+                while (queue.Pop(chunk)) {
+                    if (chunk.Data)
+                        result.RestoredBytes += RestoreOriginalBytes(chunk, activeMods);
+                    std::vector<uint8_t> frame = PackChunk(chunk, options.Compress);
+                    ++result.Chunks;
+                    if (chunk.Data) {
+                        result.RawBytes += chunk.Size;
+                        result.StoredBytes += frame.size() - sizeof(Format::ChunkHeader);
+                    } else {
+                        ++result.UnreadableChunks;
+                    }
+                    writer.Write(std::move(frame));
+                }
+            });
+
+            // The worker is joined on every path: a joinable std::thread must not be destroyed
+            try {
+                ReadImage(module, chunkSize, queue);
+            }
+            catch (const std::exception& e) {
+                Error("[ModuleDumper] Reading %ls failed: %s", module.Name.c_str(), e.what());
+                read = false;
+            }
+            queue.Close();
+            worker.join();
+
+            if (read) {
+                constexpr Format::ChunkHeader end{ 0, 0, 0, Format::ChunkFlags::End };
+                std::vector<uint8_t> endFrame(sizeof(end));
+                memcpy(endFrame.data(), &end, sizeof(end));
+                writer.Write(std::move(endFrame));
+            }
+            written = writer.Finish();
+        }
+        CloseHandle(file);
+
+        if (!read || !written) {
+            std::error_code ec;
+            fs::remove(outPath, ec);
+            return result;
+        }
+
+        result.Succeeded = true;
+        Debug("[ModuleDumper] Dumped %ls: %zu chunks (%zu unreadable), %llu bytes stored as %llu, %zu bytes of %zu active mods restored",
+              module.Name.c_str(), result.Chunks, result.UnreadableChunks, result.RawBytes, result.StoredBytes,
+              result.RestoredBytes, activeMods.size());
+        return result;
+    }
+
+    // ---- loading ----
+
+    std::optional<ModuleDump> ModuleDump::Load(const fs::path& path, std::string* error) {
+        auto fail = [error](const char* reason) -> std::optional<ModuleDump> {
+            if (error)
+                *error = reason;
+            return std::nullopt;
+        };
+
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            return fail("cannot open file");
+
+        Format::FileHeader header{};
+        if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) || memcmp(header.Magic, Format::Magic, sizeof(header.Magic)) != 0)
+            return fail("not a module dump");
+        if (header.Version != Format::Version)
+            return fail("unsupported dump version");
+        if (header.NameLength > MaxNameLength || header.SectionCount > MaxSectionCount ||
+            header.SizeOfImage == 0 || header.SizeOfImage > MaxImageSize)
+            return fail("corrupt header");
+
+        ModuleDump dump;
+        dump.Identity = { header.TimeDateStamp, header.CheckSum, header.SizeOfImage };
+        dump.ImageBase = header.ImageBase;
+
+        dump.Name.resize(header.NameLength);
+        if (!in.read(reinterpret_cast<char*>(dump.Name.data()), static_cast<std::streamsize>(dump.Name.size() * sizeof(wchar_t))))
+            return fail("truncated header");
+
+        for (uint32_t i = 0; i < header.SectionCount; ++i) {
+            Format::SectionRecord record{};
+            if (!in.read(reinterpret_cast<char*>(&record), sizeof(record)))
+                return fail("truncated section table");
+            dump.Sections.push_back({ std::string(record.Name, strnlen(record.Name, sizeof(record.Name))),
+                                      record.Rva, record.Size, record.Characteristics });
+        }
+
+        dump.Image.assign(header.SizeOfImage, 0);
+        std::vector<uint8_t> payload;
+        for (;;) {
+            Format::ChunkHeader chunk{};
+            if (!in.read(reinterpret_cast<char*>(&chunk), sizeof(chunk)))
+                return fail("truncated dump (no end marker)");
+            if (chunk.Flags & Format::ChunkFlags::End)
+                break;
+            if (chunk.Rva > dump.Image.size() || chunk.RawSize > dump.Image.size() - chunk.Rva)
+                return fail("chunk outside the image");
+
+            if (chunk.Flags & Format::ChunkFlags::Unreadable) {
+                dump.Unreadable.emplace_back(chunk.Rva, chunk.RawSize);
+                continue;
+            }
+
+            uint8_t* target = dump.Image.data() + chunk.Rva;
+            if (chunk.Flags & Format::ChunkFlags::Compressed) {
+                if (chunk.StoredSize > BlockCodec::CompressBound(chunk.RawSize))
+                    return fail("corrupt chunk");
+                payload.resize(chunk.StoredSize);
+                if (!in.read(reinterpret_cast<char*>(payload.data()), chunk.StoredSize))
+                    return fail("truncated chunk");
+                if (!BlockCodec::Decompress(payload.data(), payload.size(), target, chunk.RawSize))
+                    return fail("corrupt chunk");
+            } else {
+                if (chunk.StoredSize != chunk.RawSize || !in.read(reinterpret_cast<char*>(target), chunk.RawSize))
+                    return fail("truncated chunk");
+            }
+        }
+        return dump;
+    }
+}
@@ -0,0 +1,304 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include <ModuleRegistry.h>
+#include <RegionMap.h>
+
+#include <winternl.h>
+
+namespace ByteWeaver {
+
+    // ---- loader notifications (not in the SDK headers) ----
+    struct DllNotificationData {
+        ULONG Flags;
+        const UNICODE_STRING* FullDllName;
+        const UNICODE_STRING* BaseDllName;
+        PVOID DllBase;
+        ULONG SizeOfImage;
+    };
+
+    static constexpr ULONG DllNotificationLoaded = 1;
+    static constexpr ULONG DllNotificationUnloaded = 2;
+
+    using DllNotificationFunction = VOID(CALLBACK*)(ULONG reason, const DllNotificationData* data, PVOID context);
+    using LdrRegisterDllNotificationFn = NTSTATUS(NTAPI*)(ULONG flags, DllNotificationFunction callback, PVOID context, PVOID* cookie);
+
+    // ---- static storage ----
+    static std::shared_mutex RegistryMutex;
+    static std::map<uintptr_t, ModuleRegistry::ModulePtr> ByBase;
+    static std::unordered_map<std::wstring, ModuleRegistry::ModulePtr> ByName;
+    static bool Seeded = false;
+    static std::atomic<uint64_t> GenerationCounter{ 0 };
+    static std::once_flag WatchOnce;
+
+    static std::mutex ListenerMutex;
+    static std::vector<std::pair<size_t, ModuleRegistry::ModuleListener>> Listeners;
+    static size_t NextListenerId = 1;
+
+    // ---- helpers ----
+    static std::wstring NameKey(const std::wstring_view name) {
+        std::wstring key(name);
+        for (auto& c : key) {
+            if (c >= L'A' && c <= L'Z')
+                c += L'a' - L'A';
+        }
+        // Same default extension rule as GetModuleHandleW
+        if (key.find(L'.') == std::wstring::npos)
+            key += L".dll";
+        return key;
+    }
+
+    static std::wstring_view FileNameOf(const std::wstring_view path) {
+        const size_t slash = path.find_last_of(L"\\/");
+        return slash == std::wstring_view::npos ? path : path.substr(slash + 1);
+    }
+
+    static std::wstring ToWString(const UNICODE_STRING* text) {
+        if (!text || !text->Buffer)
+            return {};
+        return { text->Buffer, text->Length / sizeof(wchar_t) };
+    }
+
+    // ---- LoadedModule ----
+    const ModuleSection* LoadedModule::SectionAt(const uint32_t rva) const noexcept {
+        for (const auto& section : Sections) {
+            if (rva >= section.Rva && rva - section.Rva < section.Size)
+                return &section;
+        }
+        return nullptr;
+    }
+
+    // ---- notifications ----
+    struct ModuleRegistryNotifications {
+        // Runs under the loader lock: only parses headers of the mapped image and updates the maps
+        static VOID CALLBACK OnDllNotification(const ULONG reason, const DllNotificationData* data, PVOID) {
+            if (!data || !data->DllBase)
+                return;
+
+            if (reason == DllNotificationLoaded) {
+                if (auto module = ModuleRegistry::Describe(static_cast<uint8_t*>(data->DllBase), ToWString(data->FullDllName))) {
+                    ModuleRegistry::Add(module);
+                    ModuleRegistry::Notify(module, true);
+                }
+            }
+            else if (reason == DllNotificationUnloaded) {
+                if (const auto module = ModuleRegistry::Remove(static_cast<const uint8_t*>(data->DllBase)))
+                    ModuleRegistry::Notify(module, false);
+            }
+        }
+    };
+
+    void ModuleRegistry::StartWatching() {
+        std::call_once(WatchOnce, [] {
+            const HMODULE ntdll = GetModuleHandleW(L"ntdll.dll");
+            const auto registerFn = ntdll
+                ? reinterpret_cast<LdrRegisterDllNotificationFn>(GetProcAddress(ntdll, "LdrRegisterDllNotification"))
+                : nullptr;
+
+            PVOID cookie = nullptr;
+            if (!registerFn || registerFn(0, ModuleRegistryNotifications::OnDllNotification, nullptr, &cookie) < 0)
+                Warn("[ModuleRegistry] Loader notifications unavailable; modules are only found through GetModuleHandleW.");
+        });
+    }
+
+    // ---- registration ----
+    ModuleRegistry::ModulePtr ModuleRegistry::Describe(uint8_t* base, std::wstring path) {
+        const auto identity = ModuleIdentity::FromImage(base);
+        if (!identity.has_value())
+            return nullptr;
+
+        const auto dos = reinterpret_cast<const IMAGE_DOS_HEADER*>(base);
+        const auto nt = reinterpret_cast<const IMAGE_NT_HEADERS*>(base + dos->e_lfanew);
+
+        auto module = std::make_shared<LoadedModule>();
+        module->Name = std::wstring(FileNameOf(path));
+        module->Path = std::move(path);
+        module->Base = base;
+        module->Size = nt->OptionalHeader.SizeOfImage;
+        module->Identity = *identity;
+
+        const IMAGE_DATA_DIRECTORY& exports = nt->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT];
+        module->ExportRva = exports.VirtualAddress;
+        module->ExportSize = exports.Size;
+
+        const IMAGE_SECTION_HEADER* section = IMAGE_FIRST_SECTION(nt);
+        module->Sections.reserve(nt->FileHeader.NumberOfSections);
+        for (WORD i = 0; i < nt->FileHeader.NumberOfSections; ++i, ++section) {
+            const auto name = reinterpret_cast<const char*>(section->Name);
+            module->Sections.push_back({
+                std::string(name, strnlen(name, IMAGE_SIZEOF_SHORT_NAME)),
+                section->VirtualAddress,
+                section->Misc.VirtualSize ? section->Misc.VirtualSize : section->SizeOfRawData,
+                section->Characteristics
+            });
+        }
+
+        return module;
+    }
+
+    void ModuleRegistry::Add(ModulePtr module) {
+        std::unique_lock lock(RegistryMutex);
+        ByName[NameKey(module->Name)] = module;
+        ByBase[reinterpret_cast<uintptr_t>(module->Base)] = std::move(module);
+        GenerationCounter.fetch_add(1);
+    }
+
+    ModuleRegistry::ModulePtr ModuleRegistry::Remove(const uint8_t* base) {
+        ModulePtr dropped;
+        {
+            std::unique_lock lock(RegistryMutex);
+            const auto it = ByBase.find(reinterpret_cast<uintptr_t>(base));
+            if (it == ByBase.end())
+                return nullptr;
+
+            dropped = std::move(it->second);
+            ByBase.erase(it);
+            if (const auto named = ByName.find(NameKey(dropped->Name)); named != ByName.end() && named->second == dropped)
+                ByName.erase(named);
+            GenerationCounter.fetch_add(1);
+        }
+        ExportIndex::Invalidate(base);
+        RegionMap::Invalidate(reinterpret_cast<uintptr_t>(base), dropped->Size);
+        return dropped;
+    }
+
+    void ModuleRegistry::Notify(const ModulePtr& module, const bool loaded) {
+        std::vector<ModuleListener> listeners;
+        {
+            std::lock_guard lock(ListenerMutex);
+            for (const auto& listener : Listeners | std::views::values) {
+                listeners.push_back(listener);
+            }
+        }
+        for (const auto& listener : listeners) {
+            listener(module, loaded);
+        }
+    }
+
+    size_t ModuleRegistry::AddListener(ModuleListener listener) {
+        StartWatching();
+        std::lock_guard lock(ListenerMutex);
+        const size_t id = NextListenerId++;
+        Listeners.emplace_back(id, std::move(listener));
+        return id;
+    }
+
+    void ModuleRegistry::RemoveListener(const size_t id) {
+        std::lock_guard lock(ListenerMutex);
+        std::erase_if(Listeners, [id](const auto& entry) { return entry.first == id; });
+    }
+
+    bool ModuleRegistry::NameMatches(const std::wstring_view moduleName, const LoadedModule& module) {
+        return NameKey(FileNameOf(moduleName)) == NameKey(module.Name);
+    }
+
+    void ModuleRegistry::Refresh() {
+        // Register first so nothing loaded during the walk is missed
+        StartWatching();
+
+        const uint64_t generation = GenerationCounter.load();
+        std::vector<ModulePtr> modules;
+        const PEB* peb = NtCurrentTeb()->ProcessEnvironmentBlock;
+        if (peb && peb->Ldr) {
+            const LIST_ENTRY* listHead = &peb->Ldr->InMemoryOrderModuleList;
+            for (const LIST_ENTRY* curr = listHead->Flink; curr != listHead; curr = curr->Flink) {
+                const auto entry = CONTAINING_RECORD(curr, LDR_DATA_TABLE_ENTRY, InMemoryOrderLinks);
+                if (!entry->DllBase)
+                    continue;
+                if (auto module = Describe(static_cast<uint8_t*>(entry->DllBase), ToWString(&entry->FullDllName)))
+                    modules.push_back(std::move(module));
+            }
+        }
+
+        std::unique_lock lock(RegistryMutex);
+        // A notification that raced the walk is newer than the walk; only drop stale entries otherwise
+        if (GenerationCounter.load() == generation) {
+            ByBase.clear();
+            ByName.clear();
+        }
+        for (auto& module : modules) {
+            ByName.emplace(NameKey(module->Name), module);
+            ByBase[reinterpret_cast<uintptr_t>(module->Base)] = std::move(module);
+        }
+        Seeded = true;
+        GenerationCounter.fetch_add(1);
+        Debug("[ModuleRegistry] Registered %zu loaded modules.", ByBase.size());
+    }
+
+    void ModuleRegistry::EnsureSeeded() {
+        {
+            std::shared_lock lock(RegistryMutex);
+            if (Seeded)
+                return;
+        }
+        Refresh();
+    }
+
+    // ---- lookups ----
+    ModuleRegistry::ModulePtr ModuleRegistry::Find(const wchar_t* moduleName) {
+        if (!moduleName || !*moduleName) {
+            static const auto mainModule = reinterpret_cast<uintptr_t>(GetModuleHandleW(nullptr));
+            return FindByAddress(mainModule);
+        }
+
+        EnsureSeeded();
+        const std::wstring key = NameKey(FileNameOf(moduleName));
+        {
+            std::shared_lock lock(RegistryMutex);
+            if (const auto it = ByName.find(key); it != ByName.end())
+                return it->second;
+        }
+
+        // Not seen by the walk or a notification (e.g. notifications unavailable); ask the loader once
+        const HMODULE hMod = GetModuleHandleW(moduleName);
+        if (!hMod)
+            return nullptr;
+        return Register(reinterpret_cast<uint8_t*>(hMod), moduleName);
+    }
+
+    ModuleRegistry::ModulePtr ModuleRegistry::Register(uint8_t* base, const wchar_t* fallbackName) {
+        {
+            std::shared_lock lock(RegistryMutex);
+            if (const auto it = ByBase.find(reinterpret_cast<uintptr_t>(base)); it != ByBase.end())
+                return it->second;
+        }
+
+        wchar_t path[MAX_PATH];
+        const DWORD length = GetModuleFileNameW(reinterpret_cast<HMODULE>(base), path, MAX_PATH);
+        std::wstring name = length ? std::wstring(path, length) : std::wstring(fallbackName ? fallbackName : L"");
+
+        auto module = Describe(base, std::move(name));
+        if (module)
+            Add(module);
+        return module;
+    }
+
+    ModuleRegistry::ModulePtr ModuleRegistry::FindByAddress(const uintptr_t address) {
+        EnsureSeeded();
+        {
+            std::shared_lock lock(RegistryMutex);
+            auto it = ByBase.upper_bound(address);
+            if (it != ByBase.begin() && (--it)->second->Contains(address))
+                return it->second;
+        }
+
+        PVOID moduleBase = nullptr;
+        if (!RtlPcToFileHeader(reinterpret_cast<PVOID>(address), &moduleBase) || !moduleBase)
+            return nullptr;
+        return Register(static_cast<uint8_t*>(moduleBase), nullptr);
+    }
+
+    std::vector<ModuleRegistry::ModulePtr> ModuleRegistry::Snapshot() {
+        EnsureSeeded();
+        std::shared_lock lock(RegistryMutex);
+        std::vector<ModulePtr> modules;
+        modules.reserve(ByBase.size());
+        for (const auto& module : ByBase | std::views::values) {
+            modules.push_back(module);
+        }
+        return modules;
+    }
+
+    uint64_t ModuleRegistry::Generation() {
+        return GenerationCounter.load();
+    }
+}
@@ -0,0 +1,52 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include <NearHook.h>
+
+namespace ByteWeaver
+{
+    // Slot layout: [absolute relay, when needed][relocated instructions + jmp back]
+    constexpr size_t RelaySize = 14;
+
+    // jmp [rip+0] followed by the 64-bit destination
+    static void WriteAbsoluteJump(uint8_t* at, const uintptr_t to) {
+        constexpr uint8_t opcode[] = { 0xFF, 0x25, 0x00, 0x00, 0x00, 0x00 };
+        memcpy(at, opcode, sizeof(opcode));
+        const auto destination = static_cast<uint64_t>(to);
+        memcpy(at + sizeof(opcode), &destination, sizeof(destination));
+    }
+
+    NearHook::NearHook(const uintptr_t targetAddress, PVOID* originalFunction, PVOID detourFunction)
+        : InlineHook(targetAddress, ModType::NearHook, 1)
+    {
+        this->OriginalFunction = originalFunction;
+        this->DetourFunction = detourFunction;
+    }
+
+    bool NearHook::Apply()
+    {
+        if (!IsModified && (!OriginalFunction || !DetourFunction || TargetAddress == 0)) {
+            Error("[NearHook] Invalid parameters: " ADDR_FMT, TargetAddress);
+            return false;
+        }
+        return InlineHook::Apply();
+    }
+
+    std::optional<size_t> NearHook::WriteEntry(uint8_t* slot, uintptr_t& entry)
+    {
+        entry = reinterpret_cast<uintptr_t>(DetourFunction);
+        _Relay = !IsRel32Reachable(TargetAddress + JumpSize, entry);
+        if (!_Relay)
+            return 0; // The target jumps straight to the detour
+
+        WriteAbsoluteJump(slot, entry);
+        entry = reinterpret_cast<uintptr_t>(slot);
+        return RelaySize;
+    }
+
+    void NearHook::OnLiveChanged(const bool live)
+    {
+        // Published before the jump goes live: the detour may run (and call through it) at once
+        if (OriginalFunction)
+            *OriginalFunction = live ? static_cast<PVOID>(_Trampoline) : reinterpret_cast<PVOID>(TargetAddress);
+    }
+}
@@ -0,0 +1,173 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include <ParallelScan.h>
+
+#include <winternl.h>
+
+namespace ByteWeaver {
+
+    // ---- worker pool ----
+    struct ScanPool {
+        std::mutex Mutex;
+        std::condition_variable Wake;
+        std::deque<std::function<void()>> Tasks;
+        std::vector<std::thread> Threads;
+        bool Stopping = false;
+    };
+
+    // Never destroyed: joining threads from a static destructor would run under the loader lock
+    static ScanPool& Pool() {
+        static auto* pool = new ScanPool();
+        return *pool;
+    }
+
+    static void WorkerLoop(ScanPool& pool) {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(pool.Mutex);
+                pool.Wake.wait(lock, [&] { return pool.Stopping || !pool.Tasks.empty(); });
+                if (pool.Stopping && pool.Tasks.empty())
+                    return;
+                task = std::move(pool.Tasks.front());
+                pool.Tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    static size_t PoolSize() {
+        const unsigned cores = std::thread::hardware_concurrency();
+        return std::clamp<size_t>(cores > 1 ? cores - 1 : 1, 1, 15);
+    }
+
+    static void SubmitToPool(std::function<void()> task) {
+        ScanPool& pool = Pool();
+        {
+            std::lock_guard lock(pool.Mutex);
+            if (pool.Threads.empty()) {
+                pool.Stopping = false;
+                const size_t count = PoolSize();
+                for (size_t i = 0; i < count; ++i) {
+                    pool.Threads.emplace_back(WorkerLoop, std::ref(pool));
+                }
+                Debug("[ParallelScan] Started %zu scan workers.", count);
+            }
+            pool.Tasks.push_back(std::move(task));
+        }
+        pool.Wake.notify_one();
+    }
+
+    void ParallelScan::Shutdown() {
+        ScanPool& pool = Pool();
+        std::vector<std::thread> threads;
+        {
+            std::lock_guard lock(pool.Mutex);
+            pool.Stopping = true;
+            threads.swap(pool.Threads);
+        }
+        pool.Wake.notify_all();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    // ---- options ----
+    static std::mutex OptionsMutex;
+    static ParallelScanOptions Options{};
+
+    void ParallelScan::SetOptions(ParallelScanOptions options) {
+        if (options.ChunkSize == 0)
+            options.ChunkSize = ParallelScanOptions{}.ChunkSize;
+        std::lock_guard lock(OptionsMutex);
+        Options = std::move(options);
+    }
+
+    ParallelScanOptions ParallelScan::GetOptions() {
+        std::lock_guard lock(OptionsMutex);
+        return Options;
+    }
+
+    bool ParallelScan::IsLoaderLockHeld() {
+        // PEB::LoaderLock is not part of the documented PEB layout
+        constexpr size_t loaderLockOffset = WIN64 ? 0x110 : 0xA0;
+        const auto peb = reinterpret_cast<const uint8_t*>(NtCurrentTeb()->ProcessEnvironmentBlock);
+        const auto loaderLock = *reinterpret_cast<RTL_CRITICAL_SECTION* const*>(peb + loaderLockOffset);
+        return loaderLock && reinterpret_cast<uintptr_t>(loaderLock->OwningThread) == GetCurrentThreadId();
+    }
+
+    bool ParallelScan::ShouldRun(const size_t regionSize) {
+        {
+            std::lock_guard lock(OptionsMutex);
+            if (!Options.Enabled || regionSize < Options.MinimumSize || regionSize <= Options.ChunkSize)
+                return false;
+        }
+        return !IsLoaderLockHeld();
+    }
+
+    // ---- chunk scheduling ----
+    struct ChunkRun {
+        const std::function<bool(size_t)>* Process = nullptr;
+        size_t ChunkCount = 0;
+        std::atomic<size_t> Next{ 0 };
+        std::atomic<size_t> Settled{ SIZE_MAX };
+
+        std::mutex Mutex;
+        std::condition_variable Idle;
+        size_t InFlight = 0;
+
+        // Claims and processes chunks until none are left. Helpers may start after the scan
+        // returned; they then claim nothing and never touch Process.
+        void Drain() {
+            for (;;) {
+                {
+                    std::lock_guard lock(Mutex);
+                    ++InFlight;
+                }
+
+                const size_t chunk = Next.fetch_add(1);
+                if (chunk < ChunkCount && chunk <= Settled.load() && (*Process)(chunk)) {
+                    size_t settled = Settled.load();
+                    while (chunk < settled && !Settled.compare_exchange_weak(settled, chunk)) {}
+                }
+
+                bool done;
+                {
+                    std::lock_guard lock(Mutex);
+                    --InFlight;
+                    done = chunk >= ChunkCount || chunk > Settled.load();
+                }
+                Idle.notify_all();
+                if (done)
+                    return;
+            }
+        }
+    };
+
+    size_t ParallelScan::RunChunks(const size_t chunkCount, const std::function<bool(size_t)>& process) {
+        if (chunkCount == 0)
+            return SIZE_MAX;
+
+        const ParallelScanOptions options = GetOptions();
+
+        auto run = std::make_shared<ChunkRun>();
+        run->Process = &process;
+        run->ChunkCount = chunkCount;
+
+        const size_t maxWorkers = options.MaxWorkers ? options.MaxWorkers : PoolSize() + 1;
+        const size_t helpers = (std::min)(maxWorkers, chunkCount) - 1;
+        for (size_t i = 0; i < helpers; ++i) {
+            auto task = [run] { run->Drain(); };
+            if (options.Executor)
+                options.Executor(task);
+            else
+                SubmitToPool(task);
+        }
+
+        run->Drain();
+
+        std::unique_lock lock(run->Mutex);
+        run->Idle.wait(lock, [&] { return run->InFlight == 0; });
+        return run->Settled.load();
+    }
+}
@@ -0,0 +1,157 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include <RegionMap.h>
+
+namespace ByteWeaver {
+
+    // Immutable list of committed regions, sorted by base and never overlapping. Writers copy it
+    // under WriterMutex and publish the copy; readers keep the version they loaded alive.
+    struct RegionSnapshot {
+        std::vector<MemoryRegion> Regions;
+
+        const MemoryRegion* Find(const uintptr_t address) const {
+            auto it = std::ranges::upper_bound(Regions, address, {}, &MemoryRegion::Base);
+            if (it == Regions.begin())
+                return nullptr;
+            --it;
+            return it->Contains(address) ? &*it : nullptr;
+        }
+    };
+
+    // ---- static storage ----
+    static std::atomic<bool> Enabled{ false };
+    static std::mutex WriterMutex;
+    static std::atomic<std::shared_ptr<const RegionSnapshot>> Published;
+
+    static std::optional<MemoryRegion> QuerySystem(const uintptr_t address) {
+        MEMORY_BASIC_INFORMATION mbi;
+        if (!VirtualQuery(reinterpret_cast<LPCVOID>(address), &mbi, sizeof(mbi)) || mbi.State != MEM_COMMIT)
+            return std::nullopt;
+        return MemoryRegion{ reinterpret_cast<uintptr_t>(mbi.BaseAddress), mbi.RegionSize, mbi.Protect, mbi.Type };
+    }
+
+    static std::shared_ptr<const RegionSnapshot> BuildSnapshot() {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+
+        auto snapshot = std::make_shared<RegionSnapshot>();
+        uintptr_t address = reinterpret_cast<uintptr_t>(info.lpMinimumApplicationAddress);
+        const uintptr_t last = reinterpret_cast<uintptr_t>(info.lpMaximumApplicationAddress);
+        MEMORY_BASIC_INFORMATION mbi;
+        while (address <= last && VirtualQuery(reinterpret_cast<LPCVOID>(address), &mbi, sizeof(mbi))) {
+            const uintptr_t base = reinterpret_cast<uintptr_t>(mbi.BaseAddress);
+            if (mbi.State == MEM_COMMIT)
+                snapshot->Regions.push_back({ base, mbi.RegionSize, mbi.Protect, mbi.Type });
+            if (base + mbi.RegionSize <= address)
+                break;
+            address = base + mbi.RegionSize;
+        }
+        return snapshot;
+    }
+
+    // Loads the snapshot, building it on first use after the cache was enabled
+    static std::shared_ptr<const RegionSnapshot> CurrentSnapshot() {
+        if (auto snapshot = Published.load(std::memory_order_acquire))
+            return snapshot;
+
+        std::lock_guard lock(WriterMutex);
+        if (!Enabled.load())
+            return nullptr;
+        auto snapshot = Published.load(std::memory_order_acquire);
+        if (!snapshot) {
+            snapshot = BuildSnapshot();
+            Published.store(snapshot, std::memory_order_release);
+        }
+        return snapshot;
+    }
+
+    // Publishes a copy of the snapshot without the regions overlapping [begin, end), plus added
+    static void Republish(const uintptr_t begin, const uintptr_t end, const MemoryRegion* added) {
+        std::lock_guard lock(WriterMutex);
+        const auto previous = Published.load(std::memory_order_acquire);
+        if (!previous)
+            return; // Disabled, or not built yet: nothing to correct
+
+        const auto overlaps = [begin, end](const MemoryRegion& region) { return region.Base < end && region.End() > begin; };
+        if (!added && std::ranges::none_of(previous->Regions, overlaps))
+            return;
+
+        auto snapshot = std::make_shared<RegionSnapshot>();
+        snapshot->Regions.reserve(previous->Regions.size() + 1);
+        for (const MemoryRegion& region : previous->Regions) {
+            if (!overlaps(region))
+                snapshot->Regions.push_back(region);
+        }
+        if (added) {
+            const auto it = std::ranges::upper_bound(snapshot->Regions, added->Base, {}, &MemoryRegion::Base);
+            snapshot->Regions.insert(it, *added);
+        }
+        Published.store(std::move(snapshot), std::memory_order_release);
+    }
+
+    // ---- configuration ----
+    void RegionMap::SetEnabled(const bool enabled) {
+        std::lock_guard lock(WriterMutex);
+        Enabled.store(enabled);
+        if (!enabled)
+            Published.store(nullptr, std::memory_order_release);
+    }
+
+    bool RegionMap::IsEnabled() {
+        return Enabled.load();
+    }
+
+    void RegionMap::Refresh() {
+        // Built under the lock so an Invalidate() racing the walk is not overwritten by older state
+        std::lock_guard lock(WriterMutex);
+        if (Enabled.load())
+            Published.store(BuildSnapshot(), std::memory_order_release);
+    }
+
+    void RegionMap::Invalidate(const uintptr_t address, const size_t length) {
+        if (!Enabled.load(std::memory_order_relaxed) || length == 0)
+            return;
+        const uintptr_t end = address + length < address ? UINTPTR_MAX : address + length;
+        Republish(address, end, nullptr);
+    }
+
+    size_t RegionMap::RegionCount() {
+        const auto snapshot = Published.load(std::memory_order_acquire);
+        return snapshot ? snapshot->Regions.size() : 0;
+    }
+
+    // ---- queries ----
+    std::optional<MemoryRegion> RegionMap::Query(const uintptr_t address) {
+        if (!Enabled.load(std::memory_order_relaxed))
+            return QuerySystem(address);
+
+        if (const auto snapshot = CurrentSnapshot()) {
+            if (const MemoryRegion* region = snapshot->Find(address))
+                return *region;
+        }
+
+        // Committed after the snapshot was taken (or dropped by Invalidate): learn it
+        auto region = QuerySystem(address);
+        if (region.has_value())
+            Republish(region->Base, region->End(), &*region);
+        return region;
+    }
+
+    bool RegionMap::IsRangeAccessible(const uintptr_t address, const size_t length, const DWORD protections) {
+        if (length == 0)
+            return true;
+        if (address + length < address)
+            return false;
+
+        const uintptr_t end = address + length;
+        const auto snapshot = Enabled.load(std::memory_order_relaxed) ? CurrentSnapshot() : nullptr;
+        for (uintptr_t current = address; current < end;) {
+            const MemoryRegion* cached = snapshot ? snapshot->Find(current) : nullptr;
+            const std::optional<MemoryRegion> region = cached ? std::optional(*cached) : Query(current);
+            if (!region.has_value() || !(region->Protect & protections))
+                return false;
+            current = region->End();
+        }
+        return true;
+    }
+}
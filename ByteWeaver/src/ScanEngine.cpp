@@ -0,0 +1,479 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include <ScanEngine.h>
+
+#include <intrin.h>
+#include <immintrin.h>
+
+#if defined(__clang__) || defined(__GNUC__)
+    #define BYTEWEAVER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+    #define BYTEWEAVER_TARGET_AVX2
+#endif
+
+namespace ByteWeaver {
+
+    // Bytes ordered from most to least frequent in typical x86/x64 code sections.
+    // Anything not listed is considered rare and makes a good anchor.
+    static constexpr uint8_t CommonCodeBytes[] = {
+        0x00, 0xFF, 0x48, 0x8B, 0x89, 0x24, 0x4C, 0x44, 0xE8, 0x0F, 0x83, 0x45, 0x8D, 0x01,
+        0xCC, 0x85, 0xC0, 0x74, 0x08, 0x10, 0x41, 0x20, 0x75, 0x49, 0xC3, 0x04, 0x28, 0x40,
+        0x02, 0x18, 0x30, 0x90, 0xEB, 0x33, 0xC7, 0x03, 0x4D, 0x38, 0x84, 0x8A, 0x88, 0x50,
+        0xE9, 0xC1, 0x5C, 0x0C, 0x14, 0x55, 0x53, 0x56, 0x57, 0x5B, 0x5D, 0x5E, 0x5F, 0xFE,
+        0x80, 0x63, 0xF8, 0xB8, 0x68, 0x6C, 0xD0, 0xC8, 0x7C, 0x7D, 0x72, 0x73, 0x76, 0x77
+    };
+
+    static constexpr std::array<uint8_t, 256> BuildByteCommonness() {
+        std::array<uint8_t, 256> table{};
+        uint8_t weight = 255;
+        for (const uint8_t b : CommonCodeBytes) {
+            table[b] = weight--;
+        }
+        return table;
+    }
+
+    static constexpr std::array<uint8_t, 256> ByteCommonness = BuildByteCommonness();
+
+    static bool MatchesAt(const uint8_t* p, const uint8_t* values, const uint8_t* masks, const size_t length) {
+        for (size_t j = 0; j < length; ++j) {
+            if ((p[j] & masks[j]) != values[j])
+                return false;
+        }
+        return true;
+    }
+
+    // Visits every start offset in [0, last] whose bytes match; onMatch returns false to stop.
+    template <typename OnMatch>
+    static bool ScanScalar(const uint8_t* base, const size_t begin, const size_t last,
+                           const uint8_t* values, const uint8_t* masks, const size_t length, OnMatch&& onMatch)
+    {
+        for (size_t i = begin; i <= last; ++i) {
+            if (MatchesAt(base + i, values, masks, length) && !onMatch(i))
+                return false;
+        }
+        return true;
+    }
+
+    // Boyer-Moore-Horspool over start offsets [0, last] using the pattern's wildcard-aware skip table.
+    template <typename OnMatch>
+    static bool ScanHorspool(const uint8_t* base, const size_t last, const CompiledPattern& pattern, OnMatch&& onMatch)
+    {
+        const size_t tail = pattern.Length - 1;
+        const uint8_t* values = pattern.Values.data();
+        const uint8_t* masks = pattern.Masks.data();
+
+        for (size_t i = 0; i <= last;) {
+            const uint8_t next = base[i + tail];
+            if ((next & masks[tail]) == values[tail] && MatchesAt(base + i, values, masks, tail) && !onMatch(i))
+                return false;
+            i += pattern.SkipTable[next];
+        }
+        return true;
+    }
+
+    template <typename OnMatch>
+    static bool ScanSse2(const uint8_t* base, const size_t last,
+                         const uint8_t* values, const uint8_t* masks, const size_t length,
+                         const size_t anchor, const size_t confirm, OnMatch&& onMatch)
+    {
+        const __m128i anchorByte = _mm_set1_epi8(static_cast<char>(values[anchor]));
+        const __m128i confirmByte = _mm_set1_epi8(static_cast<char>(values[confirm]));
+
+        size_t i = 0;
+        for (; last >= 15 && i <= last - 15; i += 16) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(base + i + anchor));
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(base + i + confirm));
+            auto hits = static_cast<unsigned long>(_mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(a, anchorByte), _mm_cmpeq_epi8(c, confirmByte))));
+
+            while (hits) {
+                unsigned long bit;
+                _BitScanForward(&bit, hits);
+                hits &= hits - 1;
+
+                if (const size_t pos = i + bit; MatchesAt(base + pos, values, masks, length) && !onMatch(pos))
+                    return false;
+            }
+        }
+        return ScanScalar(base, i, last, values, masks, length, onMatch);
+    }
+
+    template <typename OnMatch>
+    BYTEWEAVER_TARGET_AVX2
+    static bool ScanAvx2(const uint8_t* base, const size_t last,
+                         const uint8_t* values, const uint8_t* masks, const size_t length,
+                         const size_t anchor, const size_t confirm, OnMatch&& onMatch)
+    {
+        const __m256i anchorByte = _mm256_set1_epi8(static_cast<char>(values[anchor]));
+        const __m256i confirmByte = _mm256_set1_epi8(static_cast<char>(values[confirm]));
+
+        size_t i = 0;
+        for (; last >= 31 && i <= last - 31; i += 32) {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(base + i + anchor));
+            const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(base + i + confirm));
+            auto hits = static_cast<unsigned long>(static_cast<uint32_t>(_mm256_movemask_epi8(
+                _mm256_and_si256(_mm256_cmpeq_epi8(a, anchorByte), _mm256_cmpeq_epi8(c, confirmByte)))));
+
+            while (hits) {
+                unsigned long bit;
+                _BitScanForward(&bit, hits);
+                hits &= hits - 1;
+
+                if (const size_t pos = i + bit; MatchesAt(base + pos, values, masks, length) && !onMatch(pos))
+                    return false;
+            }
+        }
+        _mm256_zeroupper();
+        return ScanScalar(base, i, last, values, masks, length, onMatch);
+    }
+
+    // ---- multi-pattern candidate filters ----
+    // Each visits every offset in [begin, size) whose byte may be an anchor value; onCandidate returns false to stop.
+
+    template <typename OnCandidate>
+    static bool ScanAnchorsScalar(const uint8_t* base, const size_t begin, const size_t size,
+                                  const std::array<uint8_t, 256>& isAnchor, OnCandidate&& onCandidate)
+    {
+        for (size_t i = begin; i < size; ++i) {
+            if (isAnchor[base[i]] && !onCandidate(i))
+                return false;
+        }
+        return true;
+    }
+
+    template <typename OnCandidate>
+    static bool ScanAnchorsSse2(const uint8_t* base, const size_t size, const std::vector<uint8_t>& anchorBytes,
+                                const std::array<uint8_t, 256>& isAnchor, OnCandidate&& onCandidate)
+    {
+        __m128i needles[8];
+        const size_t count = anchorBytes.size();
+        for (size_t k = 0; k < count; ++k) {
+            needles[k] = _mm_set1_epi8(static_cast<char>(anchorBytes[k]));
+        }
+
+        size_t i = 0;
+        for (; size >= 16 && i <= size - 16; i += 16) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(base + i));
+            __m128i any = _mm_cmpeq_epi8(v, needles[0]);
+            for (size_t k = 1; k < count; ++k) {
+                any = _mm_or_si128(any, _mm_cmpeq_epi8(v, needles[k]));
+            }
+            auto hits = static_cast<unsigned long>(_mm_movemask_epi8(any));
+
+            while (hits) {
+                unsigned long bit;
+                _BitScanForward(&bit, hits);
+                hits &= hits - 1;
+
+                if (!onCandidate(i + bit))
+                    return false;
+            }
+        }
+        return ScanAnchorsScalar(base, i, size, isAnchor, onCandidate);
+    }
+
+    // Set membership via two 16-entry shuffles: a byte b is a candidate when
+    // LowNibbles[b & 0xF] has bit (b >> 4) & 7 set. Bytes whose high nibbles differ only
+    // in bit 3 alias each other, so this is a superset of the anchor set.
+    template <typename OnCandidate>
+    BYTEWEAVER_TARGET_AVX2
+    static bool ScanAnchorsAvx2(const uint8_t* base, const size_t size, const std::array<uint8_t, 16>& lowNibbles,
+                                const std::array<uint8_t, 256>& isAnchor, OnCandidate&& onCandidate)
+    {
+        const __m256i lowTable = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(lowNibbles.data())));
+        const __m256i highTable = _mm256_setr_epi8(
+            1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+            1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+        const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+        const __m256i zero = _mm256_setzero_si256();
+
+        size_t i = 0;
+        for (; size >= 32 && i <= size - 32; i += 32) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(base + i));
+            const __m256i low = _mm256_shuffle_epi8(lowTable, _mm256_and_si256(v, nibbleMask));
+            const __m256i high = _mm256_shuffle_epi8(highTable, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibbleMask));
+            const __m256i miss = _mm256_cmpeq_epi8(_mm256_and_si256(low, high), zero);
+            auto hits = static_cast<unsigned long>(~static_cast<uint32_t>(_mm256_movemask_epi8(miss)));
+
+            while (hits) {
+                unsigned long bit;
+                _BitScanForward(&bit, hits);
+                hits &= hits - 1;
+
+                if (!onCandidate(i + bit)) {
+                    _mm256_zeroupper();
+                    return false;
+                }
+            }
+        }
+        _mm256_zeroupper();
+        return ScanAnchorsScalar(base, i, size, isAnchor, onCandidate);
+    }
+
+    // ---- backend selection ----
+    static std::atomic<int> ActiveBackend{ -1 };
+
+    ScanBackend ScanEngine::DetectBackend() {
+        if constexpr (!BYTEWEAVER_ENABLE_SIMD_SCAN)
+            return ScanBackend::Scalar;
+
+        int info[4]{};
+        __cpuid(info, 0);
+        const int maxLeaf = info[0];
+
+        __cpuid(info, 1);
+        const bool sse2 = (info[3] & (1 << 26)) != 0;
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+
+        bool avx2 = false;
+        if (maxLeaf >= 7 && osxsave && avx) {
+            // The OS must save YMM state across context switches (XCR0 bits 1 and 2)
+            if ((_xgetbv(0) & 0x6) == 0x6) {
+                __cpuidex(info, 7, 0);
+                avx2 = (info[1] & (1 << 5)) != 0;
+            }
+        }
+
+        if (avx2)
+            return ScanBackend::AVX2;
+        if (sse2)
+            return ScanBackend::SSE2;
+        return ScanBackend::Scalar;
+    }
+
+    ScanBackend ScanEngine::GetBackend() {
+        int backend = ActiveBackend.load(std::memory_order_relaxed);
+        if (backend < 0) {
+            backend = static_cast<int>(DetectBackend());
+            ActiveBackend.store(backend, std::memory_order_relaxed);
+            Debug("[ScanEngine] Using %s scan backend.", BackendName(static_cast<ScanBackend>(backend)));
+        }
+        return static_cast<ScanBackend>(backend);
+    }
+
+    void ScanEngine::SetBackend(const ScanBackend backend) {
+        const ScanBackend best = DetectBackend();
+        const ScanBackend chosen = static_cast<uint8_t>(backend) > static_cast<uint8_t>(best) ? best : backend;
+        ActiveBackend.store(static_cast<int>(chosen), std::memory_order_relaxed);
+    }
+
+    const char* ScanEngine::BackendName(const ScanBackend backend) {
+        switch (backend) {
+        case ScanBackend::Scalar: return "Scalar";
+        case ScanBackend::SSE2:   return "SSE2";
+        case ScanBackend::AVX2:   return "AVX2";
+        }
+        return "Unknown";
+    }
+
+    // ---- analysis ----
+    size_t ScanEngine::SelectAnchor(const uint8_t* values, const uint8_t* masks, const size_t length, const size_t exclude) {
+        size_t best = SIZE_MAX;
+        int bestWeight = 256;
+        for (size_t j = 0; j < length; ++j) {
+            if (masks[j] != 0xFF || j == exclude)
+                continue;
+            if (const int weight = ByteCommonness[values[j]]; weight < bestWeight) {
+                bestWeight = weight;
+                best = j;
+            }
+        }
+        return best;
+    }
+
+    // ---- search ----
+    std::optional<size_t> ScanEngine::Find(const uint8_t* base, const size_t size,
+                                           const CompiledPattern& pattern, const size_t skipCount,
+                                           size_t* skipped)
+    {
+        if (skipped)
+            *skipped = 0;
+        if (!base || pattern.Length > size)
+            return std::nullopt;
+
+        const size_t last = size - pattern.Length;
+        const uint8_t* values = pattern.Values.data();
+        const uint8_t* masks = pattern.Masks.data();
+        size_t remaining = skipCount;
+        std::optional<size_t> found;
+
+        auto onMatch = [&](const size_t pos) -> bool {
+            if (remaining > 0) {
+                --remaining;
+                return true;
+            }
+            found = pos;
+            return false;
+        };
+
+        if (!pattern.HasAnchor()) {
+            // Wildcard-only (or empty) pattern: nothing to filter on
+            ScanScalar(base, 0, last, values, masks, pattern.Length, onMatch);
+        }
+        else {
+            switch (GetBackend()) {
+            case ScanBackend::AVX2:
+                ScanAvx2(base, last, values, masks, pattern.Length, pattern.Anchor, pattern.Confirm, onMatch);
+                break;
+            case ScanBackend::SSE2:
+                ScanSse2(base, last, values, masks, pattern.Length, pattern.Anchor, pattern.Confirm, onMatch);
+                break;
+            default:
+                ScanHorspool(base, last, pattern, onMatch);
+                break;
+            }
+        }
+
+        if (skipped)
+            *skipped = skipCount - remaining;
+        return found;
+    }
+
+    // ---- multi-pattern search ----
+    MultiPatternIndex::MultiPatternIndex(const std::span<ScanJob> jobs, const bool recordMatches)
+        : _Jobs(jobs), _Remaining(jobs.size(), 0)
+    {
+        if (recordMatches) {
+            // Each job consumes at most SkipCount + 1 matches
+            _MatchBase.resize(jobs.size(), 0);
+            _MatchCount.resize(jobs.size(), 0);
+            size_t total = 0;
+            for (size_t i = 0; i < jobs.size(); ++i) {
+                _MatchBase[i] = total;
+                if (jobs[i].Pattern)
+                    total += jobs[i].SkipCount + 1;
+            }
+            _Matches.resize(total);
+        }
+
+        for (uint32_t i = 0; i < jobs.size(); ++i) {
+            ScanJob& job = jobs[i];
+            job.Address.reset();
+            if (!job.Pattern)
+                continue;
+
+            _Remaining[i] = job.SkipCount;
+            ++_Pending;
+            if (!job.Pattern->HasAnchor()) {
+                _Unanchored.push_back(i);
+                continue;
+            }
+            ++_PendingAnchored;
+            ++_BucketStart[job.Pattern->Values[job.Pattern->Anchor] + 1];
+        }
+
+        for (size_t b = 0; b < 256; ++b) {
+            _BucketStart[b + 1] += _BucketStart[b];
+        }
+
+        // Fill the buckets; once done each cursor sits at the end of its bucket
+        std::copy_n(_BucketStart.begin(), 256, _BucketEnd.begin());
+        _BucketJobs.resize(_BucketStart[256]);
+        for (uint32_t i = 0; i < jobs.size(); ++i) {
+            if (const CompiledPattern* pattern = jobs[i].Pattern; pattern && pattern->HasAnchor())
+                _BucketJobs[_BucketEnd[pattern->Values[pattern->Anchor]]++] = i;
+        }
+
+        for (size_t b = 0; b < 256; ++b) {
+            if (_BucketEnd[b] == _BucketStart[b])
+                continue;
+            _AnchorBytes.push_back(static_cast<uint8_t>(b));
+            _IsAnchor[b] = 1;
+            _LowNibbles[b & 0x0F] |= static_cast<uint8_t>(1u << ((b >> 4) & 7));
+        }
+    }
+
+    std::span<const uintptr_t> MultiPatternIndex::Matches(const size_t jobIndex) const noexcept {
+        if (_MatchCount.empty())
+            return {};
+        return { _Matches.data() + _MatchBase[jobIndex], _MatchCount[jobIndex] };
+    }
+
+    bool MultiPatternIndex::Record(const size_t jobIndex, const uintptr_t address) {
+        ScanJob& job = _Jobs[jobIndex];
+        if (job.Address.has_value())
+            return true;
+        if (!job.Pattern)
+            return false;
+
+        if (!_MatchCount.empty())
+            _Matches[_MatchBase[jobIndex] + _MatchCount[jobIndex]++] = address;
+
+        if (_Remaining[jobIndex] > 0) {
+            --_Remaining[jobIndex];
+            return false;
+        }
+
+        job.Address = address;
+        --_Pending;
+        if (job.Pattern->HasAnchor())
+            --_PendingAnchored;
+        return true;
+    }
+
+    size_t ScanEngine::FindMany(const uint8_t* base, const size_t size, MultiPatternIndex& index) {
+        if (!base || index._Pending == 0)
+            return 0;
+
+        const size_t pendingBefore = index._Pending;
+
+        // Wildcard-only patterns have no anchor to bucket on and are scanned on their own
+        for (const uint32_t jobIndex : index._Unanchored) {
+            const ScanJob& job = index._Jobs[jobIndex];
+            const CompiledPattern& pattern = *job.Pattern;
+            if (job.Address.has_value() || pattern.Length > size)
+                continue;
+
+            ScanScalar(base, 0, size - pattern.Length, pattern.Values.data(), pattern.Masks.data(), pattern.Length,
+                [&](const size_t pos) {
+                    return !index.Record(jobIndex, reinterpret_cast<uintptr_t>(base + pos));
+                });
+        }
+
+        if (index._PendingAnchored == 0)
+            return pendingBefore - index._Pending;
+
+        // pos is the offset of a byte that may be an anchor; test every live job in its bucket
+        auto onCandidate = [&](const size_t pos) -> bool {
+            const uint8_t value = base[pos];
+            uint32_t k = index._BucketStart[value];
+
+            while (k < index._BucketEnd[value]) {
+                const uint32_t jobIndex = index._BucketJobs[k];
+                const CompiledPattern& pattern = *index._Jobs[jobIndex].Pattern;
+
+                if (pos < pattern.Anchor || pattern.Length > size || pos - pattern.Anchor > size - pattern.Length ||
+                    !pattern.MatchesAt(base + pos - pattern.Anchor) ||
+                    !index.Record(jobIndex, reinterpret_cast<uintptr_t>(base + pos - pattern.Anchor)))
+                {
+                    ++k;
+                    continue;
+                }
+
+                // Resolved: swap it out of the bucket so later positions skip it
+                index._BucketJobs[k] = index._BucketJobs[--index._BucketEnd[value]];
+                if (index._PendingAnchored == 0)
+                    return false;
+            }
+            return true;
+        };
+
+        switch (GetBackend()) {
+        case ScanBackend::AVX2:
+            ScanAnchorsAvx2(base, size, index._LowNibbles, index._IsAnchor, onCandidate);
+            break;
+        case ScanBackend::SSE2:
+            if (index._AnchorBytes.size() <= 8) {
+                ScanAnchorsSse2(base, size, index._AnchorBytes, index._IsAnchor, onCandidate);
+                break;
+            }
+            [[fallthrough]];
+        default:
+            ScanAnchorsScalar(base, 0, size, index._IsAnchor, onCandidate);
+            break;
+        }
+
+        return pendingBefore - index._Pending;
+    }
+}
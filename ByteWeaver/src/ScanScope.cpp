@@ -0,0 +1,108 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include <ScanScope.h>
+
+namespace ByteWeaver {
+
+    ScanScope ScanScope::WholeImage() {
+        return {};
+    }
+
+    ScanScope ScanScope::ExecutableSections() {
+        ScanScope scope;
+        scope.Kind = ScanScopeKind::Executable;
+        return scope;
+    }
+
+    ScanScope ScanScope::NamedSection(std::string name) {
+        ScanScope scope;
+        scope.Kind = ScanScopeKind::Section;
+        scope.SectionName = std::move(name);
+        return scope;
+    }
+
+    ScanScope ScanScope::Range(const size_t rva, const size_t size) {
+        ScanScope scope;
+        scope.Kind = ScanScopeKind::RvaRange;
+        scope.RvaBegin = rva;
+        scope.RvaSize = size;
+        return scope;
+    }
+
+    std::vector<ScanRange> ScanScope::Resolve(const uint8_t* moduleBase) const {
+        std::vector<ScanRange> ranges;
+        if (!moduleBase)
+            return ranges;
+
+        const auto dos = reinterpret_cast<const IMAGE_DOS_HEADER*>(moduleBase);
+        const auto nt = reinterpret_cast<const IMAGE_NT_HEADERS*>(moduleBase + dos->e_lfanew);
+        const size_t imageSize = nt->OptionalHeader.SizeOfImage;
+
+        switch (Kind) {
+        case ScanScopeKind::Image:
+            ranges.push_back({ 0, imageSize });
+            return ranges;
+
+        case ScanScopeKind::RvaRange:
+            if (RvaBegin < imageSize)
+                ranges.push_back({ RvaBegin, (std::min)(RvaSize, imageSize - RvaBegin) });
+            return ranges;
+
+        default:
+            break;
+        }
+
+        const IMAGE_SECTION_HEADER* section = IMAGE_FIRST_SECTION(nt);
+        for (WORD i = 0; i < nt->FileHeader.NumberOfSections; ++i, ++section) {
+            if (Kind == ScanScopeKind::Executable) {
+                if (!(section->Characteristics & IMAGE_SCN_MEM_EXECUTE))
+                    continue;
+            }
+            else {
+                const auto name = reinterpret_cast<const char*>(section->Name);
+                if (std::string_view(name, strnlen(name, IMAGE_SIZEOF_SHORT_NAME)) != SectionName)
+                    continue;
+            }
+
+            // VirtualSize is the mapped size; some linkers leave it zero and only set SizeOfRawData
+            const size_t begin = section->VirtualAddress;
+            const size_t size = section->Misc.VirtualSize ? section->Misc.VirtualSize : section->SizeOfRawData;
+            if (begin >= imageSize || size == 0)
+                continue;
+
+            ranges.push_back({ begin, (std::min)(size, imageSize - begin) });
+        }
+
+        std::ranges::sort(ranges, {}, &ScanRange::Offset);
+
+        // Merge touching ranges so a pattern spanning two adjacent sections is still found
+        size_t merged = 0;
+        for (size_t i = 1; i < ranges.size(); ++i) {
+            if (ranges[merged].Offset + ranges[merged].Size >= ranges[i].Offset) {
+                const size_t end = (std::max)(ranges[merged].Offset + ranges[merged].Size, ranges[i].Offset + ranges[i].Size);
+                ranges[merged].Size = end - ranges[merged].Offset;
+            }
+            else {
+                ranges[++merged] = ranges[i];
+            }
+        }
+        if (!ranges.empty())
+            ranges.resize(merged + 1);
+
+        return ranges;
+    }
+
+    std::string ScanScope::Describe() const {
+        switch (Kind) {
+        case ScanScopeKind::Image:      return "image";
+        case ScanScopeKind::Executable: return "executable sections";
+        case ScanScopeKind::Section:    return "section " + SectionName;
+        case ScanScopeKind::RvaRange: {
+            char buffer[64];
+            snprintf(buffer, sizeof(buffer), "rva 0x%zx+0x%zx", RvaBegin, RvaSize);
+            return buffer;
+        }
+        }
+        return "unknown";
+    }
+}
@@ -0,0 +1,241 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include <SignatureCache.h>
+
+namespace ByteWeaver {
+
+    // ---- static storage ----
+    std::unordered_map<SignatureCache::Key, SignatureCache::Record, SignatureCache::KeyHash> SignatureCache::_Entries{};
+    fs::path SignatureCache::_Path{};
+    bool SignatureCache::_Enabled = false;
+    bool SignatureCache::_Dirty = false;
+    std::mutex SignatureCache::_Mutex{};
+
+    static constexpr auto CacheHeader = "# ByteWeaver signature cache v1";
+
+    // ---- helpers ----
+    static std::string ToUtf8(const std::wstring& text) {
+        if (text.empty())
+            return {};
+        const int length = WideCharToMultiByte(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), nullptr, 0, nullptr, nullptr);
+        std::string result(length, '\0');
+        WideCharToMultiByte(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), result.data(), length, nullptr, nullptr);
+        return result;
+    }
+
+    static std::wstring FromUtf8(const std::string& text) {
+        if (text.empty())
+            return {};
+        const int length = MultiByteToWideChar(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), nullptr, 0);
+        std::wstring result(length, L'\0');
+        MultiByteToWideChar(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), result.data(), length);
+        return result;
+    }
+
+    static void HashBytes(uint64_t& hash, const void* data, const size_t size) {
+        const auto bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 0x100000001b3ULL;
+        }
+    }
+
+    // ---- identity ----
+    std::optional<ModuleIdentity> ModuleIdentity::FromImage(const uint8_t* imageBase) {
+        if (!imageBase)
+            return std::nullopt;
+
+        const auto dos = reinterpret_cast<const IMAGE_DOS_HEADER*>(imageBase);
+        if (dos->e_magic != IMAGE_DOS_SIGNATURE)
+            return std::nullopt;
+
+        const auto nt = reinterpret_cast<const IMAGE_NT_HEADERS*>(imageBase + dos->e_lfanew);
+        if (nt->Signature != IMAGE_NT_SIGNATURE)
+            return std::nullopt;
+
+        ModuleIdentity identity;
+        identity.TimeDateStamp = nt->FileHeader.TimeDateStamp;
+        identity.CheckSum = nt->OptionalHeader.CheckSum;
+        identity.SizeOfImage = nt->OptionalHeader.SizeOfImage;
+        return identity;
+    }
+
+    // ---- lifetime ----
+    bool SignatureCache::Open(const fs::path& path) {
+        std::lock_guard lock(_Mutex);
+        _Path = path;
+        _Enabled = true;
+        _Dirty = false;
+        _Entries.clear();
+        return LoadFile();
+    }
+
+    void SignatureCache::Close() {
+        Save();
+        std::lock_guard lock(_Mutex);
+        _Enabled = false;
+        _Entries.clear();
+    }
+
+    bool SignatureCache::IsEnabled() {
+        std::lock_guard lock(_Mutex);
+        return _Enabled;
+    }
+
+    void SignatureCache::Clear() {
+        std::lock_guard lock(_Mutex);
+        _Dirty = _Dirty || !_Entries.empty();
+        _Entries.clear();
+    }
+
+    bool SignatureCache::LoadFile() {
+        std::error_code ec;
+        if (!fs::exists(_Path, ec))
+            return true;
+
+        std::ifstream file(_Path, std::ios::in | std::ios::binary);
+        if (!file) {
+            Error("[SignatureCache] Failed to open %s", _Path.string().c_str());
+            return false;
+        }
+
+        std::string line;
+        size_t skipped = 0;
+        while (std::getline(file, line)) {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            if (line.empty() || line.front() == '#')
+                continue;
+
+            std::istringstream fields(line);
+            std::string hash, stamp, checksum, size, offset, module, symbol;
+            if (!std::getline(fields, hash, '\t') || !std::getline(fields, stamp, '\t') ||
+                !std::getline(fields, checksum, '\t') || !std::getline(fields, size, '\t') ||
+                !std::getline(fields, offset, '\t') || !std::getline(fields, module, '\t') ||
+                !std::getline(fields, symbol))
+            {
+                ++skipped;
+                continue;
+            }
+
+            try {
+                Record record;
+                record.Identity.TimeDateStamp = static_cast<uint32_t>(std::stoul(stamp, nullptr, 16));
+                record.Identity.CheckSum = static_cast<uint32_t>(std::stoul(checksum, nullptr, 16));
+                record.Identity.SizeOfImage = static_cast<uint32_t>(std::stoul(size, nullptr, 16));
+                record.Offset = static_cast<uintptr_t>(std::stoull(offset, nullptr, 16));
+                _Entries[Key{ symbol, FromUtf8(module), std::stoull(hash, nullptr, 16) }] = record;
+            }
+            catch (const std::exception&) {
+                ++skipped;
+            }
+        }
+
+        Debug("[SignatureCache] Loaded %zu entries from %s", _Entries.size(), _Path.string().c_str());
+        if (skipped)
+            Warn("[SignatureCache] Skipped %zu malformed lines in %s", skipped, _Path.string().c_str());
+        return true;
+    }
+
+    bool SignatureCache::Save() {
+        std::lock_guard lock(_Mutex);
+        if (!_Enabled || !_Dirty)
+            return true;
+
+        std::ostringstream out;
+        out << CacheHeader << '\n' << std::hex;
+        for (const auto& [key, record] : _Entries) {
+            out << key.PatternHash << '\t'
+                << record.Identity.TimeDateStamp << '\t'
+                << record.Identity.CheckSum << '\t'
+                << record.Identity.SizeOfImage << '\t'
+                << record.Offset << '\t'
+                << ToUtf8(key.Module) << '\t'
+                << key.Symbol << '\n';
+        }
+
+        // Write next to the target and swap it in, so a crash never leaves a truncated cache
+        try {
+            if (_Path.has_parent_path())
+                fs::create_directories(_Path.parent_path());
+
+            fs::path temp = _Path;
+            temp += ".tmp";
+            {
+                std::ofstream file(temp, std::ios::out | std::ios::binary | std::ios::trunc);
+                const std::string data = out.str();
+                file.write(data.data(), static_cast<std::streamsize>(data.size()));
+                if (!file) {
+                    Error("[SignatureCache] Failed to write %s", temp.string().c_str());
+                    return false;
+                }
+            }
+            fs::rename(temp, _Path);
+        }
+        catch (const fs::filesystem_error& e) {
+            Error("[SignatureCache] Filesystem error: %s", e.what());
+            return false;
+        }
+
+        _Dirty = false;
+        return true;
+    }
+
+    // ---- entries ----
+    uint64_t SignatureCache::HashPattern(const CompiledPattern& pattern, const size_t skipCount, const ScanScope& scope) {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        HashBytes(hash, pattern.Values.data(), pattern.Values.size());
+        HashBytes(hash, pattern.Masks.data(), pattern.Masks.size());
+
+        const uint64_t skip = skipCount;
+        HashBytes(hash, &skip, sizeof(skip));
+
+        const uint64_t scopeFields[] = { static_cast<uint64_t>(scope.Kind), scope.RvaBegin, scope.RvaSize };
+        HashBytes(hash, scopeFields, sizeof(scopeFields));
+        HashBytes(hash, scope.SectionName.data(), scope.SectionName.size());
+        return hash;
+    }
+
+    std::optional<uintptr_t> SignatureCache::Lookup(const std::string& symbolName, const std::wstring& moduleName,
+                                                    const uint64_t patternHash, const ModuleIdentity& identity)
+    {
+        std::lock_guard lock(_Mutex);
+        if (!_Enabled)
+            return std::nullopt;
+
+        const auto it = _Entries.find(Key{ symbolName, moduleName, patternHash });
+        if (it == _Entries.end() || it->second.Identity != identity)
+            return std::nullopt;
+        return it->second.Offset;
+    }
+
+    void SignatureCache::Store(const std::string& symbolName, const std::wstring& moduleName,
+                               const uint64_t patternHash, const ModuleIdentity& identity, const uintptr_t offset)
+    {
+        std::lock_guard lock(_Mutex);
+        if (!_Enabled)
+            return;
+
+        Record& record = _Entries[Key{ symbolName, moduleName, patternHash }];
+        if (record.Identity == identity && record.Offset == offset)
+            return;
+
+        record.Identity = identity;
+        record.Offset = offset;
+        _Dirty = true;
+    }
+
+    bool SignatureCache::Verify(const uint8_t* moduleBase, const uintptr_t offset, const CompiledPattern& pattern) {
+        const auto identity = ModuleIdentity::FromImage(moduleBase);
+        if (!identity.has_value() || offset > identity->SizeOfImage || pattern.Length > identity->SizeOfImage - offset)
+            return false;
+
+        __try {
+            return pattern.MatchesAt(moduleBase + offset);
+        }
+        __except (EXCEPTION_EXECUTE_HANDLER)
+        {
+            return false;
+        }
+    }
+}
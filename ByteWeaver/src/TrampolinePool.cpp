@@ -0,0 +1,237 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include <TrampolinePool.h>
+#include <RegionMap.h>
+
+namespace ByteWeaver {
+
+    // One allocation granule of slots; bit i of Used is slot i (in use or retired), of Freed the same
+    // slot once retired
+    struct Arena {
+        uintptr_t Base = 0;
+        size_t Size = 0;
+        std::vector<uint64_t> Used{};
+        std::vector<uint64_t> Freed{};
+        size_t InUse = 0;
+        size_t Retired = 0;
+
+        size_t SlotCount() const { return Size / TrampolinePool::SlotSize; }
+        bool Contains(const uintptr_t address) const { return address >= Base && address - Base < Size; }
+    };
+
+    // ---- static storage ----
+    static std::mutex PoolMutex;         // guards Arenas
+    static std::mutex WriteMutex;        // serializes Writers
+    static std::vector<Arena> Arenas;
+
+    static const SYSTEM_INFO& SystemInfo() {
+        static const SYSTEM_INFO info = [] {
+            SYSTEM_INFO result;
+            GetSystemInfo(&result);
+            return result;
+        }();
+        return info;
+    }
+
+    static uintptr_t AlignDown(const uintptr_t value, const uintptr_t alignment) { return value & ~(alignment - 1); }
+    static uintptr_t AlignUp(const uintptr_t value, const uintptr_t alignment) { return AlignDown(value + alignment - 1, alignment); }
+
+    static bool IsWithinReach(const uintptr_t target, const uintptr_t address) {
+        if constexpr (!WIN64)
+            return true;
+        return (address > target ? address - target : target - address) <= TrampolinePool::MaxDistance;
+    }
+
+    static bool IsReachable(const Arena& arena, const uintptr_t target) {
+        return IsWithinReach(target, arena.Base) && IsWithinReach(target, arena.Base + arena.Size);
+    }
+
+    static uintptr_t TryCommit(const uintptr_t address, const size_t size) {
+        return reinterpret_cast<uintptr_t>(VirtualAlloc(reinterpret_cast<LPVOID>(address), size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+    }
+
+    // Commits size bytes within MaxDistance of target, walking free regions below the target first
+    // (the space under an image is usually unused) and then above it
+    static uintptr_t CommitNear(const uintptr_t target, const size_t size) {
+        if constexpr (!WIN64)
+            return TryCommit(0, size);
+
+        const SYSTEM_INFO& info = SystemInfo();
+        const uintptr_t granularity = info.dwAllocationGranularity;
+        const uintptr_t minimum = reinterpret_cast<uintptr_t>(info.lpMinimumApplicationAddress);
+        const uintptr_t maximum = reinterpret_cast<uintptr_t>(info.lpMaximumApplicationAddress);
+        const uintptr_t low = std::max(AlignUp(minimum, granularity), target > TrampolinePool::MaxDistance ? target - TrampolinePool::MaxDistance : 0);
+        const uintptr_t high = std::min(maximum, target + TrampolinePool::MaxDistance);
+
+        MEMORY_BASIC_INFORMATION mbi;
+        for (uintptr_t query = target; query >= low && VirtualQuery(reinterpret_cast<LPCVOID>(query), &mbi, sizeof(mbi));) {
+            const uintptr_t base = reinterpret_cast<uintptr_t>(mbi.BaseAddress);
+            const uintptr_t end = base + mbi.RegionSize;
+            if (mbi.State == MEM_FREE && end - base >= size) {
+                const uintptr_t candidate = AlignDown(end - size, granularity);
+                if (candidate >= base && candidate >= low) {
+                    if (const uintptr_t committed = TryCommit(candidate, size))
+                        return committed;
+                }
+            }
+            if (base == 0)
+                break;
+            query = base - 1;
+        }
+
+        for (uintptr_t query = target; query < high && VirtualQuery(reinterpret_cast<LPCVOID>(query), &mbi, sizeof(mbi));) {
+            const uintptr_t base = reinterpret_cast<uintptr_t>(mbi.BaseAddress);
+            const uintptr_t end = base + mbi.RegionSize;
+            if (mbi.State == MEM_FREE) {
+                const uintptr_t candidate = AlignUp(base, granularity);
+                if (candidate + size <= end && candidate + size <= high) {
+                    if (const uintptr_t committed = TryCommit(candidate, size))
+                        return committed;
+                }
+            }
+            if (end <= query)
+                break;
+            query = end;
+        }
+        return 0;
+    }
+
+    // Caller holds PoolMutex
+    static Arena* CreateArena(const uintptr_t target) {
+        const size_t size = SystemInfo().dwAllocationGranularity;
+        const uintptr_t base = CommitNear(target, size);
+        if (!base)
+            return nullptr;
+
+        DWORD _;
+        memset(reinterpret_cast<void*>(base), 0xCC, size);
+        VirtualProtect(reinterpret_cast<LPVOID>(base), size, PAGE_EXECUTE_READ, &_);
+        RegionMap::Invalidate(base, size);
+
+        Arena arena{ base, size };
+        arena.Used.assign((arena.SlotCount() + 63) / 64, 0);
+        arena.Freed.assign(arena.Used.size(), 0);
+        Arenas.push_back(std::move(arena));
+
+        Debug("[TrampolinePool] New arena " ADDR_FMT " (%zu KB) for target " ADDR_FMT, base, size / 1024, target);
+        return &Arenas.back();
+    }
+
+    // ---- slots ----
+
+    static void MarkSlots(std::vector<uint64_t>& bits, const size_t first, const size_t count) {
+        for (size_t index = first; index < first + count; ++index)
+            bits[index / 64] |= 1ull << (index % 64);
+    }
+
+    static bool IsMarked(const std::vector<uint64_t>& bits, const size_t index) {
+        return (bits[index / 64] >> (index % 64)) & 1;
+    }
+
+    // Finds count clear bits in a row; caller holds PoolMutex
+    static std::optional<size_t> FindFreeRun(const Arena& arena, const size_t count) {
+        size_t run = 0;
+        for (size_t index = 0; index < arena.SlotCount(); ++index) {
+            run = IsMarked(arena.Used, index) ? 0 : run + 1;
+            if (run == count)
+                return index + 1 - count;
+        }
+        return std::nullopt;
+    }
+
+    uint8_t* TrampolinePool::Allocate(const uintptr_t target, const size_t count) {
+        if (count == 0 || count > SystemInfo().dwAllocationGranularity / SlotSize)
+            return nullptr;
+
+        std::lock_guard lock(PoolMutex);
+        for (Arena& arena : Arenas) {
+            if (arena.SlotCount() - arena.InUse - arena.Retired < count || !IsReachable(arena, target))
+                continue;
+            if (const auto first = FindFreeRun(arena, count)) {
+                MarkSlots(arena.Used, *first, count);
+                arena.InUse += count;
+                return reinterpret_cast<uint8_t*>(arena.Base + *first * SlotSize);
+            }
+        }
+
+        Arena* arena = CreateArena(target);
+        if (!arena)
+            return nullptr;
+        MarkSlots(arena->Used, 0, count);
+        arena->InUse += count;
+        return reinterpret_cast<uint8_t*>(arena->Base);
+    }
+
+    void TrampolinePool::Free(uint8_t* slot, const size_t count) {
+        if (!slot || count == 0)
+            return;
+
+        const auto address = reinterpret_cast<uintptr_t>(slot);
+        std::lock_guard lock(PoolMutex);
+        const auto it = std::ranges::find_if(Arenas, [address](const Arena& arena) { return arena.Contains(address); });
+        if (it == Arenas.end() || (address - it->Base) / SlotSize + count > it->SlotCount()) {
+            Warn("[TrampolinePool] Free of " ADDR_FMT ", which is not a pool slot", address);
+            return;
+        }
+        const size_t first = (address - it->Base) / SlotSize;
+        if (!IsMarked(it->Used, first) || IsMarked(it->Freed, first))
+            return;
+
+        // The code is left as it is and the slots stay marked, so a thread still inside them
+        // finishes the old code rather than running into int3 or another hook's stub
+        MarkSlots(it->Freed, first, count);
+        it->InUse -= count;
+        it->Retired += count;
+    }
+
+    bool TrampolinePool::Contains(const uintptr_t address) {
+        std::lock_guard lock(PoolMutex);
+        return std::ranges::any_of(Arenas, [address](const Arena& arena) { return arena.Contains(address); });
+    }
+
+    size_t TrampolinePool::ArenaCount() {
+        std::lock_guard lock(PoolMutex);
+        return Arenas.size();
+    }
+
+    size_t TrampolinePool::SlotsInUse() {
+        std::lock_guard lock(PoolMutex);
+        size_t total = 0;
+        for (const Arena& arena : Arenas)
+            total += arena.InUse;
+        return total;
+    }
+
+    size_t TrampolinePool::SlotsRetired() {
+        std::lock_guard lock(PoolMutex);
+        size_t total = 0;
+        for (const Arena& arena : Arenas)
+            total += arena.Retired;
+        return total;
+    }
+
+    // ---- writer ----
+    TrampolinePool::Writer::Writer(uint8_t* slot, const size_t count) : _Slot(slot), _Size(count * SlotSize) {
+        if (!_Slot)
+            return;
+
+        WriteMutex.lock();
+        DWORD _;
+        if (!VirtualProtect(_Slot, _Size, PAGE_EXECUTE_READWRITE, &_)) {
+            Error("[TrampolinePool] Failed to unprotect slot " ADDR_FMT ". Error %lu", _Slot, GetLastError());
+            WriteMutex.unlock();
+            return;
+        }
+        _Open = true;
+    }
+
+    TrampolinePool::Writer::~Writer() {
+        if (!_Open)
+            return;
+
+        DWORD _;
+        VirtualProtect(_Slot, _Size, PAGE_EXECUTE_READ, &_);
+        FlushInstructionCache(GetCurrentProcess(), _Slot, _Size);
+        WriteMutex.unlock();
+    }
+}
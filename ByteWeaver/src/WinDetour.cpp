@@ -1,7 +1,9 @@
 // Copyright(C) 2025 0xKate - MIT License
 
 #include <WinDetour.h>
+#include <RegionMap.h>
 #include <detours.h>
+#include <tlhelp32.h>
 
 namespace ByteWeaver
 {
@@ -57,14 +59,15 @@ namespace ByteWeaver
         }
 
         // Verify memory is executable
-        MEMORY_BASIC_INFORMATION mbi;
-        if (VirtualQuery(reinterpret_cast<void*>(TargetAddress), &mbi, sizeof(mbi)) == 0 ||
-            !(mbi.Protect & (PAGE_EXECUTE | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE))) {
+        if (!RegionMap::IsRangeAccessible(TargetAddress, 1, RegionMap::ExecutableProtections)) {
             Error("[Detour] Target memory is not executable: " ADDR_FMT, TargetAddress);
             return false;
-            }
+        }
 
-        DetourTransactionBegin();
+        if (const LONG begun = DetourTransactionBegin(); begun != NO_ERROR) {
+            Error("[Detour] Failed to begin apply transaction: " ADDR_FMT ", Error code: 0x%08X", TargetAddress, begun);
+            return false;
+        }
 
         __try {
             this->OriginalBytes.clear();
@@ -78,6 +81,7 @@ namespace ByteWeaver
             const LONG result = DetourTransactionCommitEx(&failedPointer);
             if (result == NO_ERROR) {
                 IsModified = true;
+                RegionMap::Invalidate(TargetAddress, Size);
 
                 if constexpr (BYTEWEAVER_ENABLE_LOGGING) {
                     if (!this->Key.empty()) {
@@ -120,7 +124,10 @@ namespace ByteWeaver
             return false;
         }
 
-        DetourTransactionBegin();
+        if (const LONG begun = DetourTransactionBegin(); begun != NO_ERROR) {
+            Error("[Detour] Failed to begin restore transaction: " ADDR_FMT ", Error code: 0x%08X", TargetAddress, begun);
+            return false;
+        }
 
         __try {
             DetourUpdateThread(GetCurrentThread());
@@ -130,6 +137,7 @@ namespace ByteWeaver
             const LONG result = DetourTransactionCommitEx(&failedPointer);
             if (result == NO_ERROR) {
                 IsModified = false;
+                RegionMap::Invalidate(TargetAddress, Size);
 
                 if constexpr (BYTEWEAVER_ENABLE_LOGGING) {
                     if (!this->Key.empty()) {
@@ -158,4 +166,181 @@ namespace ByteWeaver
         DetourTransactionAbort();
         return false;
     }
-}
\ No newline at end of file
+
+    // ---- batches ----
+
+    // Opens the other threads of the process. Runs before the transaction is opened, so the
+    // allocation and any logging happen while no thread is suspended.
+    static std::vector<HANDLE> OpenOtherThreads()
+    {
+        std::vector<HANDLE> threads;
+        const HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+        if (snapshot == INVALID_HANDLE_VALUE) {
+            Warn("[Detour] Thread snapshot failed (0x%08X); only the calling thread is updated", GetLastError());
+            return threads;
+        }
+
+        const DWORD processId = GetCurrentProcessId();
+        const DWORD currentThreadId = GetCurrentThreadId();
+
+        THREADENTRY32 entry{};
+        entry.dwSize = sizeof(entry);
+        for (BOOL more = Thread32First(snapshot, &entry); more; more = Thread32Next(snapshot, &entry)) {
+            if (entry.th32OwnerProcessID != processId || entry.th32ThreadID == currentThreadId)
+                continue;
+            if (const HANDLE thread = OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | THREAD_SET_CONTEXT, FALSE, entry.th32ThreadID))
+                threads.push_back(thread);  // Missing threads exited since the snapshot
+        }
+
+        CloseHandle(snapshot);
+        return threads;
+    }
+
+    // Enlists the opened threads in the open transaction. Detours suspends each one and moves its
+    // instruction pointer out of any code being rewritten. Called after every attach/detach is
+    // queued, so their operations and trampolines are allocated before any thread is suspended.
+    // Detours still allocates one small record per thread with new after suspending the earlier
+    // ones; that window is left, and nothing of ours allocates or logs in it. Handles Detours
+    // refused are closed and set to nullptr; the rest must stay open until the transaction ends.
+    static size_t UpdateOtherThreads(std::vector<HANDLE>& threads)
+    {
+        size_t updated = 0;
+        for (HANDLE& thread : threads) {
+            if (DetourUpdateThread(thread) == NO_ERROR) {
+                ++updated;
+                continue;
+            }
+            CloseHandle(thread);
+            thread = nullptr;
+        }
+        return updated;
+    }
+
+    // Queues every attach (or detach) of a batch. Returns the Detours error and, on failure, the
+    // index of the detour that was rejected (count after an exception, whose code is recorded in
+    // `exceptionCode` for the caller to log once the transaction is over).
+    static LONG GuardedQueueBatch(Detour* const* detours, const size_t count, const bool attach, size_t* failedIndex, DWORD* exceptionCode)
+    {
+        __try {
+            for (size_t i = 0; i < count; ++i) {
+                Detour* detour = detours[i];
+                if (attach)
+                    memcpy(detour->OriginalBytes.data(), reinterpret_cast<void*>(detour->TargetAddress), detour->Size);
+
+                const LONG result = attach
+                    ? DetourAttach(detour->OriginalFunction, detour->DetourFunction)
+                    : DetourDetach(detour->OriginalFunction, detour->DetourFunction);
+                if (result != NO_ERROR) {
+                    *failedIndex = i;
+                    return result;
+                }
+            }
+            *failedIndex = count;
+            return NO_ERROR;
+        }
+        __except (EXCEPTION_EXECUTE_HANDLER) {
+            *failedIndex = count;
+            *exceptionCode = GetExceptionCode();
+        }
+        return ERROR_INVALID_OPERATION;
+    }
+
+    // Commits the open transaction. Other threads are suspended, so an exception is only recorded.
+    static LONG GuardedCommit(DWORD* exceptionCode)
+    {
+        __try {
+            PVOID* failedPointer = nullptr;
+            return DetourTransactionCommitEx(&failedPointer);
+        }
+        __except (EXCEPTION_EXECUTE_HANDLER) {
+            *exceptionCode = GetExceptionCode();
+        }
+        return ERROR_INVALID_OPERATION;
+    }
+
+    static bool CommitBatch(const std::span<Detour* const> detours, const bool attach)
+    {
+        // Only detours that change state take part; applying an applied detour is a no-op as with Apply()
+        std::vector<Detour*> pending;
+        pending.reserve(detours.size());
+        for (Detour* detour : detours) {
+            if (!detour || detour->IsModified == attach)
+                continue;
+            if (!detour->OriginalFunction || !detour->DetourFunction || detour->TargetAddress == 0) {
+                Error("[Detour] Invalid parameters in batch: " ADDR_FMT "%s%s", detour->TargetAddress,
+                    detour->Key.empty() ? "" : " Key: ", detour->Key.c_str());
+                return false;
+            }
+            if (attach) {
+                if (!RegionMap::IsRangeAccessible(detour->TargetAddress, 1, RegionMap::ExecutableProtections)) {
+                    Error("[Detour] Target memory is not executable: " ADDR_FMT, detour->TargetAddress);
+                    return false;
+                }
+                detour->OriginalBytes.assign(detour->Size, 0);
+            }
+            pending.push_back(detour);
+        }
+        if (pending.empty())
+            return true;
+
+        // Everything of ours that allocates is done before the first thread is suspended
+        std::vector<HANDLE> threads = OpenOtherThreads();
+
+        if (const LONG begun = DetourTransactionBegin(); begun != NO_ERROR) {
+            for (const HANDLE thread : threads)
+                CloseHandle(thread);
+            Error("[Detour] Failed to begin batch %s transaction, Error code: 0x%08X", attach ? "apply" : "restore", begun);
+            return false;
+        }
+        DetourUpdateThread(GetCurrentThread());
+
+        size_t failedIndex = 0;
+        size_t updated = 0;
+        DWORD exceptionCode = 0;
+        LONG result = GuardedQueueBatch(pending.data(), pending.size(), attach, &failedIndex, &exceptionCode);
+        if (result == NO_ERROR) {
+            updated = UpdateOtherThreads(threads);
+            result = GuardedCommit(&exceptionCode);
+        }
+        if (result != NO_ERROR) {
+            // Nothing was written: queued operations only take effect on commit
+            DetourTransactionAbort();
+        }
+
+        for (const HANDLE thread : threads) {
+            if (thread)
+                CloseHandle(thread);
+        }
+
+        if (result != NO_ERROR) {
+            if (exceptionCode)
+                Error("[Detour] Exception occurred during batch %s. Code: 0x%08X", attach ? "apply" : "restore", exceptionCode);
+            if (failedIndex < pending.size())
+                Error("[Detour] Batch %s rolled back: " ADDR_FMT " rejected (Key: %s), Error code: 0x%08X",
+                    attach ? "apply" : "restore", pending[failedIndex]->TargetAddress, pending[failedIndex]->Key.c_str(), result);
+            else if (!exceptionCode)
+                Error("[Detour] Batch %s rolled back: commit failed, Error code: 0x%08X", attach ? "apply" : "restore", result);
+            return false;
+        }
+
+        for (Detour* detour : pending) {
+            detour->IsModified = attach;
+            RegionMap::Invalidate(detour->TargetAddress, detour->Size);
+        }
+
+        if constexpr (BYTEWEAVER_ENABLE_LOGGING)
+            Debug("[Detour] (%s) Committed %zu detours in one transaction, %zu threads updated",
+                attach ? "ApplyBatch" : "RestoreBatch", pending.size(), updated);
+        return true;
+    }
+
+    bool Detour::ApplyBatch(const std::span<Detour* const> detours)
+    {
+        return CommitBatch(detours, true);
+    }
+
+    bool Detour::RestoreBatch(const std::span<Detour* const> detours)
+    {
+        return CommitBatch(detours, false);
+    }
+}
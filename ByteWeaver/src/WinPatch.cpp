@@ -1,10 +1,15 @@
 // Copyright(C) 2025 0xKate - MIT License
 
 #include <WinPatch.h>
+#include <RegionMap.h>
 
 namespace ByteWeaver
 {
-    Patch::Patch(const uintptr_t patchAddress, std::vector<uint8_t> patchBytes) : PatchBytes(std::move(patchBytes))
+    Patch::Patch(const uintptr_t patchAddress, const std::vector<uint8_t>& patchBytes) : Patch(patchAddress, std::span<const uint8_t>(patchBytes))
+    {
+    }
+
+    Patch::Patch(const uintptr_t patchAddress, const std::span<const uint8_t> patchBytes) : PatchBytes(patchBytes)
     {
         this->IsModified = false;
         this->TargetAddress = patchAddress;
@@ -47,6 +52,7 @@ namespace ByteWeaver
             memcpy(OriginalBytes.data(), targetPointer, Size);         // Save original bytes
             memcpy(targetPointer, PatchBytes.data(), Size);            // Apply patch
             VirtualProtect(targetPointer, Size, oldProtection, &_);    // Restore old protection
+            RegionMap::Invalidate(TargetAddress, Size);                // Protection may have split the region
 
             if constexpr (BYTEWEAVER_ENABLE_LOGGING) {
                 if (!this->Key.empty()) {
@@ -100,6 +106,7 @@ namespace ByteWeaver
         __try {
             memcpy(targetPointer, OriginalBytes.data(), Size);            // Restore original bytes
             VirtualProtect(targetPointer, Size, oldProtection, &_);       // Restore old protection
+            RegionMap::Invalidate(TargetAddress, Size);
 
             if constexpr (BYTEWEAVER_ENABLE_LOGGING) {
                 if (!this->Key.empty()) {
@@ -124,4 +131,162 @@ namespace ByteWeaver
             return false;
         }        
     }
-}
\ No newline at end of file
+
+    // ---- batches ----
+
+    // Returns 0 or the exception code; kept free of destructible locals for __try
+    static DWORD GuardedSwapBytes(void* target, const void* source, void* save, const size_t size) {
+        __try {
+            if (save)
+                memcpy(save, target, size);
+            memcpy(target, source, size);
+            return 0;
+        }
+        __except (EXCEPTION_EXECUTE_HANDLER) {
+            return GetExceptionCode();
+        }
+    }
+
+    static size_t PageSize() {
+        static const size_t pageSize = [] {
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            return static_cast<size_t>(info.dwPageSize);
+        }();
+        return pageSize;
+    }
+
+    static void ReportFailure(const Patch& patch, std::vector<std::string>* failedKeys) {
+        if (!failedKeys)
+            return;
+        if (!patch.Key.empty()) {
+            failedKeys->push_back(patch.Key);
+        } else {
+            char address[32];
+            snprintf(address, sizeof(address), ADDR_FMT, patch.TargetAddress);
+            failedKeys->emplace_back(address);
+        }
+    }
+
+    static bool CommitBatch(std::span<Patch* const> patches, const bool apply, std::vector<std::string>* failedKeys) {
+        const char* action = apply ? "Apply" : "Restore";
+
+        std::vector<Patch*> pending;
+        pending.reserve(patches.size());
+        bool result = true;
+        for (Patch* patch : patches) {
+            if (!patch || patch->IsModified == apply)
+                continue;
+            if (patch->TargetAddress == 0x0 || patch->Size == 0 || patch->PatchBytes.size() != patch->Size) {
+                Error("[Patch] (%sBatch) Invalid patch%s%s at " ADDR_FMT, action,
+                    !patch->Key.empty() ? " " : "", patch->Key.c_str(), patch->TargetAddress);
+                ReportFailure(*patch, failedKeys);
+                result = false;
+                continue;
+            }
+            pending.push_back(patch);
+        }
+        if (pending.empty())
+            return result;
+
+        std::ranges::sort(pending, {}, &Patch::TargetAddress);
+        // Overlapping patches must come off in the reverse order they went on
+        if (!apply)
+            std::ranges::reverse(pending);
+
+        const size_t pageSize = PageSize();
+        size_t runs = 0;
+        for (size_t first = 0; first < pending.size();) {
+            // A run is the following patches that lie in the same region and within a page of each
+            // other, so one protection fits all of it without unprotecting unrelated pages
+            MEMORY_BASIC_INFORMATION mbi{};
+            if (!VirtualQuery(reinterpret_cast<LPCVOID>(pending[first]->TargetAddress), &mbi, sizeof(mbi))) {
+                Error("[Patch] (%sBatch) Cannot query memory at " ADDR_FMT " for %s", action,
+                    pending[first]->TargetAddress, pending[first]->Key.c_str());
+                ReportFailure(*pending[first], failedKeys);
+                result = false;
+                ++first;
+                continue;
+            }
+
+            const uintptr_t regionBegin = reinterpret_cast<uintptr_t>(mbi.BaseAddress);
+            const uintptr_t regionEnd = regionBegin + mbi.RegionSize;
+            uintptr_t runBegin = pending[first]->TargetAddress;
+            uintptr_t runEnd = runBegin + pending[first]->Size;
+            size_t last = first + 1;
+            for (; last < pending.size(); ++last) {
+                const Patch* next = pending[last];
+                const uintptr_t nextEnd = next->TargetAddress + next->Size;
+                if (next->TargetAddress < regionBegin || nextEnd > regionEnd)
+                    break;
+                // Sorted up for apply and down for restore: the gap is on one side or the other
+                const uintptr_t gap = next->TargetAddress >= runEnd ? next->TargetAddress - runEnd
+                                    : nextEnd <= runBegin ? runBegin - nextEnd : 0;
+                if (gap > pageSize)
+                    break;
+                runBegin = (std::min)(runBegin, next->TargetAddress);
+                runEnd = (std::max)(runEnd, next->TargetAddress + next->Size);
+            }
+
+            runBegin &= ~(pageSize - 1);
+            runEnd = (runEnd + pageSize - 1) & ~(pageSize - 1);
+            const auto runPointer = reinterpret_cast<void*>(runBegin);
+            const size_t runSize = runEnd - runBegin;
+
+            DWORD oldProtection;
+            if (!VirtualProtect(runPointer, runSize, PAGE_EXECUTE_READWRITE, &oldProtection)) {
+                const DWORD errCode = GetLastError();
+                for (size_t i = first; i < last; ++i) {
+                    Error("[Patch] (%sBatch) Failed to set permissions for %s at " ADDR_FMT ". Error %lu",
+                        action, pending[i]->Key.c_str(), pending[i]->TargetAddress, errCode);
+                    ReportFailure(*pending[i], failedKeys);
+                }
+                result = false;
+                first = last;
+                continue;
+            }
+
+            for (size_t i = first; i < last; ++i) {
+                Patch* patch = pending[i];
+                const auto target = reinterpret_cast<void*>(patch->TargetAddress);
+                const DWORD code = apply
+                    ? GuardedSwapBytes(target, patch->PatchBytes.data(), patch->OriginalBytes.data(), patch->Size)
+                    : GuardedSwapBytes(target, patch->OriginalBytes.data(), nullptr, patch->Size);
+                if (code != 0) {
+                    Error("[Patch] (%sBatch) Exception writing %s at " ADDR_FMT " (Size: %zu): 0x%08X",
+                        action, patch->Key.c_str(), patch->TargetAddress, patch->Size, code);
+                    ReportFailure(*patch, failedKeys);
+                    result = false;
+                    continue;
+                }
+                patch->IsModified = apply;
+            }
+
+            DWORD _;
+            VirtualProtect(runPointer, runSize, oldProtection, &_);
+            RegionMap::Invalidate(runBegin, runSize);
+            FlushInstructionCache(GetCurrentProcess(), runPointer, runSize);
+
+            if constexpr (BYTEWEAVER_ENABLE_LOGGING) {
+                Debug("[Patch] (%sBatch) [Run: " ADDR_FMT ", Pages: %zu, Patches: %zu]",
+                    action, runBegin, runSize / pageSize, last - first);
+            }
+
+            ++runs;
+            first = last;
+        }
+
+        if constexpr (BYTEWEAVER_ENABLE_LOGGING) {
+            Debug("[Patch] (%sBatch) %zu patches in %zu page runs", action, pending.size(), runs);
+        }
+        return result;
+    }
+
+    bool Patch::ApplyBatch(const std::span<Patch* const> patches, std::vector<std::string>* failedKeys) {
+        return CommitBatch(patches, true, failedKeys);
+    }
+
+    bool Patch::RestoreBatch(const std::span<Patch* const> patches, std::vector<std::string>* failedKeys) {
+        return CommitBatch(patches, false, failedKeys);
+    }
+}
@@ -0,0 +1,81 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include "Bench.h"
+
+namespace ByteWeaverBench {
+
+    using namespace ByteWeaver;
+
+    static constexpr size_t LookupCount = 4096;
+
+    // Fills the database with count ntdll offset entries (cheap to resolve, so UpdateAll measures the database itself)
+    static std::vector<AddressDB::Key> Populate(const size_t count) {
+        AddressDB::Clear();
+        std::vector<AddressDB::Key> keys;
+        keys.reserve(count);
+        char name[32];
+        for (size_t i = 0; i < count; ++i) {
+            snprintf(name, sizeof(name), "BenchSymbol_%05zu", i);
+            AddressDB::AddWithKnownOffset(name, L"ntdll.dll", 0x1000 + i * 16);
+            keys.emplace_back(name, L"ntdll.dll");
+        }
+        return keys;
+    }
+
+    void RunAddressDBBenchmarks(Runner& runner) {
+        if (!runner.Selected("AddressDB"))
+            return;
+
+        for (const size_t count : { 10, 100, 1000, 10000 }) {
+            const std::vector<AddressDB::Key> keys = Populate(count);
+            const Params params = { { "entries", static_cast<int64_t>(count) } };
+
+            // Same pseudo-random lookup order on every run
+            auto random = runner.Random(10 + count);
+            std::vector<const AddressDB::Key*> order(LookupCount);
+            for (auto& key : order)
+                key = &keys[random() % keys.size()];
+
+            std::vector<AddressDB::Key> missing;
+            missing.reserve(LookupCount);
+            for (size_t i = 0; i < LookupCount; ++i)
+                missing.emplace_back("BenchMissing_" + std::to_string(i), L"ntdll.dll");
+
+            runner.Run("AddressDB::Find/hit", params, [&](const size_t iterations) {
+                for (size_t i = 0; i < iterations; ++i)
+                    Consume(reinterpret_cast<uintptr_t>(AddressDB::Find(*order[i % LookupCount])));
+            });
+            runner.Run("AddressDB::Find/miss", params, [&](const size_t iterations) {
+                for (size_t i = 0; i < iterations; ++i)
+                    Consume(reinterpret_cast<uintptr_t>(AddressDB::Find(missing[i % LookupCount])));
+            });
+            runner.Run("AddressDB::Find/by_name", params, [&](const size_t iterations) {
+                for (size_t i = 0; i < iterations; ++i) {
+                    const auto& [symbol, module] = *order[i % LookupCount];
+                    Consume(reinterpret_cast<uintptr_t>(AddressDB::Find(symbol, module)));
+                }
+            });
+            std::vector<PreparedAddressKey> prepared;
+            std::vector<AddressHandle> handles;
+            prepared.reserve(LookupCount);
+            handles.reserve(LookupCount);
+            for (const AddressDB::Key* key : order) {
+                prepared.push_back(AddressDB::Prepare(key->first, key->second));
+                handles.push_back(AddressDB::GetHandle(key->first, key->second));
+            }
+            runner.Run("AddressDB::Find/prepared", params, [&](const size_t iterations) {
+                for (size_t i = 0; i < iterations; ++i)
+                    Consume(reinterpret_cast<uintptr_t>(AddressDB::Find(prepared[i % LookupCount])));
+            });
+            runner.Run("AddressDB::Find/handle", params, [&](const size_t iterations) {
+                for (size_t i = 0; i < iterations; ++i)
+                    Consume(reinterpret_cast<uintptr_t>(AddressDB::Find(handles[i % LookupCount])));
+            });
+            runner.Run("AddressDB::UpdateAll", params, [&](const size_t iterations) {
+                for (size_t i = 0; i < iterations; ++i)
+                    Consume(AddressDB::UpdateAll());
+            });
+        }
+        AddressDB::Clear();
+    }
+}
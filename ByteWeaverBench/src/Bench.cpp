@@ -0,0 +1,117 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include "Bench.h"
+
+namespace ByteWeaverBench {
+
+    using Clock = std::chrono::steady_clock;
+
+    static std::string JsonString(const std::string& text) {
+        std::string out = "\"";
+        for (const char c : text) {
+            switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                }
+                else {
+                    out.push_back(c);
+                }
+            }
+        }
+        return out + "\"";
+    }
+
+    static std::string JsonNumber(const double value) {
+        char text[32];
+        snprintf(text, sizeof(text), "%.3f", value);
+        return text;
+    }
+
+    static std::string JsonValue(const ParamValue& value) {
+        if (const auto* integer = std::get_if<int64_t>(&value))
+            return std::to_string(*integer);
+        if (const auto* number = std::get_if<double>(&value))
+            return JsonNumber(*number);
+        return JsonString(std::get<std::string>(value));
+    }
+
+    static double TimeNs(const Runner::Body& body, const size_t iterations) {
+        const auto start = Clock::now();
+        body(iterations);
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+
+    bool Runner::Selected(const std::string& name) const {
+        return _Options.Filter.empty() || name.find(_Options.Filter) != std::string::npos;
+    }
+
+    void Runner::Run(const std::string& name, const Params& params, const Body& body, const uint64_t bytesPerOp) {
+        if (!Selected(name))
+            return;
+
+        // Warm caches and lazy state, then scale the sample until it is long enough to time
+        const double minSampleNs = _Options.MinSampleMs * 1e6;
+        size_t iterations = 1;
+        double elapsed = TimeNs(body, iterations);
+        while (elapsed < minSampleNs && iterations < (size_t{ 1 } << 40)) {
+            const double scale = elapsed > 0 ? minSampleNs / elapsed * 1.2 : 10.0;
+            iterations = static_cast<size_t>(static_cast<double>(iterations) * std::clamp(scale, 1.5, 10.0));
+            elapsed = TimeNs(body, iterations);
+        }
+
+        std::vector<double> samples;
+        samples.reserve(_Options.Samples);
+        for (size_t i = 0; i < _Options.Samples; ++i)
+            samples.push_back(TimeNs(body, iterations) / static_cast<double>(iterations));
+        std::ranges::sort(samples);
+        const double median = samples[samples.size() / 2];
+
+        std::string line = "{\"type\":\"result\",\"name\":" + JsonString(name) + ",\"params\":{";
+        for (size_t i = 0; i < params.size(); ++i) {
+            if (i)
+                line += ",";
+            line += JsonString(params[i].first) + ":" + JsonValue(params[i].second);
+        }
+        line += "},\"iterations\":" + std::to_string(iterations);
+        line += ",\"samples\":" + std::to_string(samples.size());
+        line += ",\"ns_per_op\":" + JsonNumber(median);
+        line += ",\"ns_per_op_min\":" + JsonNumber(samples.front());
+        line += ",\"ns_per_op_max\":" + JsonNumber(samples.back());
+        if (bytesPerOp && median > 0)
+            line += ",\"mb_per_s\":" + JsonNumber(static_cast<double>(bytesPerOp) / median * 1e9 / (1024.0 * 1024.0));
+        line += "}\n";
+
+        fputs(line.c_str(), stdout);
+        fflush(stdout);
+    }
+
+    void Runner::PrintContext() const {
+        SYSTEM_INFO info{};
+        GetSystemInfo(&info);
+
+        std::string line = "{\"type\":\"context\",\"arch\":";
+        line += JsonString(ByteWeaver::WIN64 ? "x64" : "x86");
+        line += ",\"cpus\":" + std::to_string(info.dwNumberOfProcessors);
+        line += ",\"scan_backend\":" + JsonString(ByteWeaver::ScanEngine::BackendName(ByteWeaver::ScanEngine::DetectBackend()));
+#if defined(NDEBUG)
+        line += ",\"build\":\"release\"";
+#else
+        line += ",\"build\":\"debug\"";
+#endif
+        line += ",\"samples\":" + std::to_string(_Options.Samples);
+        line += ",\"min_sample_ms\":" + JsonNumber(_Options.MinSampleMs);
+        line += ",\"seed\":" + std::to_string(_Options.Seed);
+        line += ",\"unix_time\":" + std::to_string(std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        line += "}\n";
+
+        fputs(line.c_str(), stdout);
+        fflush(stdout);
+    }
+}
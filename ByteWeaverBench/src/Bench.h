@@ -0,0 +1,70 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include <ByteWeaver.h>
+
+#include <chrono>
+#include <random>
+#include <variant>
+
+namespace ByteWeaverBench {
+
+    using ParamValue = std::variant<int64_t, double, std::string>;
+    using Params = std::vector<std::pair<std::string, ParamValue>>;
+
+    struct Options {
+        /// @brief Only benchmarks whose name contains this run (empty = all)
+        std::string Filter;
+
+        /// @brief Timed samples per benchmark; the median is the headline number
+        size_t Samples = 7;
+
+        /// @brief Minimum duration of one sample; iterations are scaled until it is reached
+        double MinSampleMs = 25.0;
+
+        /// @brief Seed of every generated data set, so runs compare like for like
+        uint64_t Seed = 0x42574542454E4348ULL; // "BWEBENCH"
+    };
+
+    /**
+     * @brief Times benchmark bodies and prints one JSON object per result to stdout.
+     *
+     * A body receives an iteration count and performs that many operations. The runner grows the
+     * count until one call takes at least MinSampleMs, then times Samples calls of that size and
+     * reports nanoseconds per operation (median, min, max). With bytesPerOp set, the median is
+     * also reported as throughput.
+     */
+    class Runner {
+    public:
+        using Body = std::function<void(size_t iterations)>;
+
+        explicit Runner(Options options) : _Options(std::move(options)) {}
+
+        /// @brief Returns false if the filter excludes the benchmark (skip its setup too)
+        bool Selected(const std::string& name) const;
+
+        void Run(const std::string& name, const Params& params, const Body& body, uint64_t bytesPerOp = 0);
+
+        /// @brief Prints the {"type":"context",...} line describing the machine and settings
+        void PrintContext() const;
+
+        const Options& GetOptions() const noexcept { return _Options; }
+
+        /// @brief Fresh generator for a data set; same sequence on every run
+        std::mt19937_64 Random(const uint64_t stream) const { return std::mt19937_64(_Options.Seed ^ stream * 0x9E3779B97F4A7C15ULL); }
+
+    private:
+        Options _Options;
+    };
+
+    /// @brief Keeps a result alive so the optimizer can't drop the work that produced it
+    inline void Consume(const uintptr_t value) {
+        static volatile uintptr_t sink = 0;
+        sink = value;
+    }
+
+    void RunScannerBenchmarks(Runner& runner);
+    void RunAddressDBBenchmarks(Runner& runner);
+    void RunMemoryManagerBenchmarks(Runner& runner);
+}
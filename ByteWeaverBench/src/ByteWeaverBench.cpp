@@ -0,0 +1,46 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include "Bench.h"
+
+using namespace ByteWeaverBench;
+
+static void PrintUsage() {
+    fputs("Usage: ByteWeaverBench [--filter <text>] [--samples <n>] [--min-ms <ms>] [--seed <n>]\n"
+          "  Prints one JSON object per line: a \"context\" record, then one \"result\" per benchmark.\n", stderr);
+}
+
+int main(const int argc, char** argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--filter") == 0 && hasValue) {
+            options.Filter = argv[++i];
+        }
+        else if (strcmp(argv[i], "--samples") == 0 && hasValue) {
+            options.Samples = (std::max)(static_cast<size_t>(strtoull(argv[++i], nullptr, 10)), size_t{ 1 });
+        }
+        else if (strcmp(argv[i], "--min-ms") == 0 && hasValue) {
+            options.MinSampleMs = strtod(argv[++i], nullptr);
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+            options.Seed = strtoull(argv[++i], nullptr, 0);
+        }
+        else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    // Keep the library's own logging out of the timings and out of the JSON stream
+    ByteWeaver::SetLogLevel(ByteWeaver::LogLevel::LOG_ERROR);
+
+    Runner runner(std::move(options));
+    runner.PrintContext();
+    RunScannerBenchmarks(runner);
+    RunAddressDBBenchmarks(runner);
+    RunMemoryManagerBenchmarks(runner);
+
+    ByteWeaver::ParallelScan::Shutdown();
+    return 0;
+}
@@ -0,0 +1,368 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include "Bench.h"
+
+namespace ByteWeaverBench {
+
+    using namespace ByteWeaver;
+
+    static constexpr uint16_t QueryGroup = 0xBE01;
+    static constexpr uint16_t PatchGroup = 0xBE02;
+    static constexpr uint16_t DetourGroup = 0xBE03;
+    static constexpr uint16_t NearHookGroup = 0xBE04;
+    static constexpr uint16_t MidHookGroup = 0xBE05;
+
+    static constexpr size_t PatchStride = 16;   // Bytes between patched locations
+    static constexpr size_t StubStride = 32;    // Bytes per detour target stub
+
+    /**
+     * Executable scratch memory owned by one benchmark; patches and detours only ever touch this.
+     */
+    class Arena {
+    public:
+        explicit Arena(const size_t size) : _Size(size) {
+            _Base = static_cast<uint8_t*>(VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE));
+            if (_Base)
+                memset(_Base, 0xCC, size);
+        }
+        ~Arena() {
+            if (_Base)
+                VirtualFree(_Base, 0, MEM_RELEASE);
+        }
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        uintptr_t Address(const size_t offset) const { return reinterpret_cast<uintptr_t>(_Base) + offset; }
+        uint8_t* Data() const noexcept { return _Base; }
+        size_t Size() const noexcept { return _Size; }
+        explicit operator bool() const noexcept { return _Base != nullptr; }
+
+    private:
+        uint8_t* _Base = nullptr;
+        size_t _Size = 0;
+    };
+
+    static std::string ModKey(const char* prefix, const size_t index) {
+        char key[48];
+        snprintf(key, sizeof(key), "Bench/%s/%05zu", prefix, index);
+        return key;
+    }
+
+    static int DetourTarget() {
+        return 0;
+    }
+
+    // mov eax, index / ret: five bytes Detours can relocate, padded with int3
+    static void WriteStub(uint8_t* stub, const uint32_t index) {
+        stub[0] = 0xB8;
+        memcpy(stub + 1, &index, sizeof(index));
+        stub[5] = 0xC3;
+    }
+
+    static void RunLocationQueries(Runner& runner) {
+        if (!runner.Selected("IsLocationModified"))
+            return;
+
+        for (const size_t count : { 10, 100, 1000, 10000 }) {
+            Arena arena(count * PatchStride);
+            if (!arena)
+                return;
+
+            for (size_t i = 0; i < count; ++i)
+                MemoryManager::CreatePatch(ModKey("Query", i), arena.Address(i * PatchStride), { 0x90, 0x90, 0x90, 0x90 }, QueryGroup);
+            MemoryManager::ApplyByGroupID(QueryGroup);
+
+            // Half the probes start on a patch, half in the untouched gap between two
+            auto random = runner.Random(20 + count);
+            std::vector<uintptr_t> probes(4096);
+            for (size_t i = 0; i < probes.size(); ++i)
+                probes[i] = arena.Address((random() % count) * PatchStride + (i % 2 ? 8 : 0));
+
+            const Params params = { { "mods", static_cast<int64_t>(count) }, { "probe_length", int64_t{ 4 } } };
+            runner.Run("IsLocationModified", params, [&](const size_t iterations) {
+                for (size_t i = 0; i < iterations; ++i)
+                    Consume(MemoryManager::IsLocationModified(probes[i % probes.size()], 4, nullptr));
+            });
+
+            std::vector<std::string> keys;
+            runner.Run("IsLocationModified/keys", params, [&](const size_t iterations) {
+                for (size_t i = 0; i < iterations; ++i) {
+                    keys.clear();
+                    Consume(MemoryManager::IsLocationModified(probes[i % probes.size()], 4, &keys));
+                }
+            });
+
+            std::vector<const char*> fastKeys;
+            runner.Run("IsLocationModifiedFast", params, [&](const size_t iterations) {
+                for (size_t i = 0; i < iterations; ++i) {
+                    fastKeys.clear();
+                    Consume(MemoryManager::IsLocationModifiedFast(probes[i % probes.size()], 4, fastKeys));
+                }
+            });
+
+            MemoryManager::RestoreAndEraseByGroupID(QueryGroup);
+        }
+    }
+
+    static void RunPatchCycles(Runner& runner) {
+        if (!runner.Selected("Patch"))
+            return;
+
+        {
+            Arena arena(4096);
+            if (!arena)
+                return;
+            const auto patch = MemoryManager::CreatePatch(ModKey("Patch", 0), arena.Address(0), { 0x90, 0x90, 0x90, 0x90, 0x90 });
+            runner.Run("Patch/cycle", { { "mods", int64_t{ 1 } } }, [&](const size_t iterations) {
+                for (size_t i = 0; i < iterations; ++i) {
+                    patch->Apply();
+                    patch->Restore();
+                }
+            });
+            MemoryManager::RestoreAndEraseMod(ModKey("Patch", 0));
+        }
+
+        for (const size_t count : { 16, 256, 4096 }) {
+            Arena arena(count * PatchStride);
+            if (!arena)
+                return;
+            for (size_t i = 0; i < count; ++i)
+                MemoryManager::CreatePatch(ModKey("Patch", i), arena.Address(i * PatchStride), { 0x90, 0x90, 0x90, 0x90, 0x90 }, PatchGroup);
+
+            runner.Run("Patch/group_cycle", { { "mods", static_cast<int64_t>(count) } }, [&](const size_t iterations) {
+                for (size_t i = 0; i < iterations; ++i) {
+                    MemoryManager::ApplyByGroupID(PatchGroup);
+                    MemoryManager::RestoreByGroupID(PatchGroup);
+                }
+            });
+            MemoryManager::RestoreAndEraseByGroupID(PatchGroup);
+        }
+    }
+
+    // Registration and teardown of a group, shared_ptr API against arena handles
+    static void RunPatchRegistration(Runner& runner) {
+        if (!runner.Selected("Patch/register"))
+            return;
+
+        for (const size_t count : { 256, 4096 }) {
+            Arena arena(count * PatchStride);
+            if (!arena)
+                return;
+            std::vector<std::string> keys(count);
+            for (size_t i = 0; i < count; ++i)
+                keys[i] = ModKey("Register", i);
+            const std::vector<uint8_t> nops = { 0x90, 0x90, 0x90, 0x90, 0x90 };
+
+            const Params params = { { "mods", static_cast<int64_t>(count) } };
+            runner.Run("Patch/register/shared_ptr", params, [&](const size_t iterations) {
+                for (size_t i = 0; i < iterations; ++i) {
+                    for (size_t j = 0; j < count; ++j)
+                        Consume(MemoryManager::CreatePatch(keys[j], arena.Address(j * PatchStride), nops, PatchGroup) != nullptr);
+                    MemoryManager::RestoreAndEraseByGroupID(PatchGroup);
+                }
+            });
+            runner.Run("Patch/register/handle", params, [&](const size_t iterations) {
+                for (size_t i = 0; i < iterations; ++i) {
+                    for (size_t j = 0; j < count; ++j)
+                        Consume(MemoryManager::RegisterPatch(keys[j], arena.Address(j * PatchStride), nops, PatchGroup).IsValid());
+                    MemoryManager::RestoreAndEraseByGroupID(PatchGroup);
+                }
+            });
+        }
+    }
+
+    static void RunDetourCycles(Runner& runner) {
+        if (!runner.Selected("Detour"))
+            return;
+
+        for (const size_t count : { 1, 16, 256 }) {
+            Arena arena(count * StubStride);
+            if (!arena)
+                return;
+
+            std::vector<PVOID> originals(count);
+            for (size_t i = 0; i < count; ++i) {
+                WriteStub(arena.Data() + i * StubStride, static_cast<uint32_t>(i));
+                originals[i] = arena.Data() + i * StubStride;
+                MemoryManager::CreateDetour(ModKey("Detour", i), arena.Address(i * StubStride), &originals[i],
+                                            reinterpret_cast<PVOID>(&DetourTarget), DetourGroup);
+            }
+            FlushInstructionCache(GetCurrentProcess(), arena.Data(), arena.Size());
+
+            if (count == 1) {
+                const auto detour = MemoryManager::GetMod(ModKey("Detour", 0));
+                runner.Run("Detour/cycle", { { "mods", int64_t{ 1 } } }, [&](const size_t iterations) {
+                    for (size_t i = 0; i < iterations; ++i) {
+                        detour->Apply();
+                        detour->Restore();
+                    }
+                });
+            }
+            else {
+                runner.Run("Detour/group_cycle", { { "mods", static_cast<int64_t>(count) } }, [&](const size_t iterations) {
+                    for (size_t i = 0; i < iterations; ++i) {
+                        MemoryManager::ApplyByGroupID(DetourGroup);
+                        MemoryManager::RestoreByGroupID(DetourGroup);
+                    }
+                });
+            }
+            MemoryManager::RestoreAndEraseByGroupID(DetourGroup);
+        }
+    }
+
+    // Same stubs as RunDetourCycles, plus the cost of calling through the hooked function
+    static void RunNearHookCycles(Runner& runner) {
+        if (!runner.Selected("NearHook"))
+            return;
+
+        for (const size_t count : { 1, 256 }) {
+            Arena arena(count * StubStride);
+            if (!arena)
+                return;
+
+            std::vector<PVOID> originals(count);
+            for (size_t i = 0; i < count; ++i) {
+                WriteStub(arena.Data() + i * StubStride, static_cast<uint32_t>(i));
+                originals[i] = arena.Data() + i * StubStride;
+                MemoryManager::CreateNearHook(ModKey("NearHook", i), arena.Address(i * StubStride), &originals[i],
+                                              reinterpret_cast<PVOID>(&DetourTarget), NearHookGroup);
+            }
+            FlushInstructionCache(GetCurrentProcess(), arena.Data(), arena.Size());
+
+            if (count == 1) {
+                const auto hook = MemoryManager::GetMod(ModKey("NearHook", 0));
+                runner.Run("NearHook/cycle", { { "mods", int64_t{ 1 } } }, [&](const size_t iterations) {
+                    for (size_t i = 0; i < iterations; ++i) {
+                        hook->Apply();
+                        hook->Restore();
+                    }
+                });
+
+                hook->Apply();
+                const auto hooked = reinterpret_cast<int (*)()>(arena.Data());
+                runner.Run("NearHook/call", { { "mods", int64_t{ 1 } } }, [&](const size_t iterations) {
+                    for (size_t i = 0; i < iterations; ++i)
+                        Consume(hooked());
+                });
+            }
+            else {
+                runner.Run("NearHook/group_cycle", { { "mods", static_cast<int64_t>(count) } }, [&](const size_t iterations) {
+                    for (size_t i = 0; i < iterations; ++i) {
+                        MemoryManager::ApplyByGroupID(NearHookGroup);
+                        MemoryManager::RestoreByGroupID(NearHookGroup);
+                    }
+                });
+            }
+            MemoryManager::RestoreAndEraseByGroupID(NearHookGroup);
+        }
+    }
+
+    static void EmptyMidHook(MidHookContext&) {}
+
+    // Cost of one pass through a mid hook: the stub, an empty callback and the relocated mov
+    static void RunMidHookCalls(Runner& runner) {
+        if (!runner.Selected("MidHook"))
+            return;
+
+        Arena arena(StubStride);
+        if (!arena)
+            return;
+        WriteStub(arena.Data(), 7);
+        FlushInstructionCache(GetCurrentProcess(), arena.Data(), arena.Size());
+
+        const auto stub = reinterpret_cast<int (*)()>(arena.Data());
+        for (const auto& [name, live] : { std::pair{ "MidHook/call_volatile", Registers::Volatile }, std::pair{ "MidHook/call_all", Registers::All } }) {
+            const auto hook = MemoryManager::CreateMidHook(ModKey("MidHook", 0), arena.Address(0), &EmptyMidHook, live, MidHookGroup);
+            if (!hook || !hook->Apply())
+                break;
+            runner.Run(name, { { "stub_bytes", static_cast<int64_t>(MidHook::StubSize(live)) } }, [&](const size_t iterations) {
+                for (size_t i = 0; i < iterations; ++i)
+                    Consume(stub());
+            });
+            MemoryManager::RestoreAndEraseMod(ModKey("MidHook", 0));
+        }
+    }
+
+    static void RunRangeValidation(Runner& runner) {
+        if (!runner.Selected("IsMemoryRangeValid") && !runner.Selected("ReadSpanSafe"))
+            return;
+
+        Arena arena(64 * 1024);
+        if (!arena)
+            return;
+
+        auto random = runner.Random(30);
+        std::vector<uintptr_t> probes(4096);
+        for (auto& probe : probes)
+            probe = arena.Address(random() % (arena.Size() - 64));
+
+        const bool wasEnabled = RegionMap::IsEnabled();
+        for (const bool cached : { false, true }) {
+            RegionMap::SetEnabled(cached);
+            const Params params = { { "region_map", int64_t{ cached } }, { "length", int64_t{ 64 } } };
+            runner.Run("IsMemoryRangeValid", params, [&](const size_t iterations) {
+                for (size_t i = 0; i < iterations; ++i)
+                    Consume(MemoryManager::IsMemoryRangeValid(probes[i % probes.size()], 64));
+            });
+            runner.Run("ReadSpanSafe", params, [&](const size_t iterations) {
+                for (size_t i = 0; i < iterations; ++i)
+                    Consume(MemoryManager::ReadSpanSafe(probes[i % probes.size()], 64).size());
+            }, 64);
+        }
+        RegionMap::SetEnabled(wasEnabled);
+    }
+
+    // An entity-list walk: one small read per entity, per-call copies against one batch
+    static void RunBatchedReads(Runner& runner) {
+        if (!runner.Selected("ReadBatch") && !runner.Selected("ReadBytesSafe"))
+            return;
+
+        static constexpr size_t EntitySize = 64;
+        static constexpr size_t ReadSize = 16;
+        for (const size_t count : { 16, 256, 4096 }) {
+            Arena arena(count * EntitySize);
+            if (!arena)
+                return;
+
+            const Params params = { { "reads", static_cast<int64_t>(count) }, { "length", int64_t{ ReadSize } } };
+            runner.Run("ReadBytesSafe/loop", params, [&](const size_t iterations) {
+                for (size_t i = 0; i < iterations; ++i) {
+                    for (size_t entity = 0; entity < count; ++entity)
+                        Consume(MemoryManager::ReadBytesSafe(arena.Address(entity * EntitySize), ReadSize).size());
+                }
+            }, count * ReadSize);
+
+            std::vector<uint8_t> destination(count * ReadSize);
+            std::vector<ReadRequest> requests(count);
+            runner.Run("ReadBatch", params, [&](const size_t iterations) {
+                for (size_t i = 0; i < iterations; ++i) {
+                    for (size_t entity = 0; entity < count; ++entity)
+                        requests[entity] = { arena.Address(entity * EntitySize), ReadSize, &destination[entity * ReadSize] };
+                    Consume(MemoryManager::ReadBatch(requests));
+                }
+            }, count * ReadSize);
+
+            ReadArena readArena;
+            runner.Run("ReadBatch/arena", params, [&](const size_t iterations) {
+                for (size_t i = 0; i < iterations; ++i) {
+                    readArena.Reset();
+                    for (size_t entity = 0; entity < count; ++entity)
+                        requests[entity] = { arena.Address(entity * EntitySize), ReadSize };
+                    Consume(MemoryManager::ReadBatch(requests, readArena));
+                }
+            }, count * ReadSize);
+        }
+    }
+
+    void RunMemoryManagerBenchmarks(Runner& runner) {
+        RunRangeValidation(runner);
+        RunBatchedReads(runner);
+        RunLocationQueries(runner);
+        RunPatchCycles(runner);
+        RunPatchRegistration(runner);
+        RunDetourCycles(runner);
+        RunNearHookCycles(runner);
+        RunMidHookCalls(runner);
+    }
+}
@@ -0,0 +1,192 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include "Bench.h"
+
+namespace ByteWeaverBench {
+
+    using namespace ByteWeaver;
+
+    using Pattern = std::vector<std::optional<uint8_t>>;
+
+    static constexpr size_t SyntheticSize = 16 * 1024 * 1024;
+
+    // Random pattern; every wildcardPercent-th byte on average is a wildcard, the first byte never is
+    static Pattern MakePattern(std::mt19937_64& random, const size_t length, const int wildcardPercent) {
+        Pattern pattern(length);
+        for (size_t i = 0; i < length; ++i) {
+            if (i != 0 && static_cast<int>(random() % 100) < wildcardPercent)
+                pattern[i] = std::nullopt;
+            else
+                pattern[i] = static_cast<uint8_t>(random());
+        }
+        return pattern;
+    }
+
+    static std::string PatternString(const Pattern& pattern) {
+        std::string text;
+        char hex[4];
+        for (const auto& byte : pattern) {
+            if (!text.empty())
+                text += ",";
+            if (byte) {
+                snprintf(hex, sizeof(hex), "%02X", *byte);
+                text += hex;
+            }
+            else {
+                text += "?";
+            }
+        }
+        return text;
+    }
+
+    static void RunSynthetic(Runner& runner, std::vector<uint8_t>& image, const ScanBackend backend,
+                             const size_t length, const int wildcardPercent, const int positionPercent) {
+        auto random = runner.Random(length * 1000 + static_cast<size_t>(wildcardPercent));
+        const Pattern pattern = MakePattern(random, length, wildcardPercent);
+        const CompiledPattern compiled = CompiledPattern::FromBytes(pattern);
+
+        // Positions < 0 leave the pattern out: the scan covers the whole image and finds nothing
+        std::vector<uint8_t> saved;
+        size_t scanned = image.size();
+        size_t offset = 0;
+        if (positionPercent >= 0) {
+            offset = (image.size() - pattern.size()) / 100 * static_cast<size_t>(positionPercent);
+            saved.assign(image.begin() + static_cast<ptrdiff_t>(offset), image.begin() + static_cast<ptrdiff_t>(offset + length));
+            for (size_t i = 0; i < length; ++i) {
+                if (pattern[i])
+                    image[offset + i] = *pattern[i];
+            }
+            scanned = offset + length;
+        }
+
+        const Params params = {
+            { "backend", std::string(ScanEngine::BackendName(backend)) },
+            { "image", std::string("synthetic") },
+            { "image_bytes", static_cast<int64_t>(image.size()) },
+            { "pattern_length", static_cast<int64_t>(length) },
+            { "wildcard_percent", static_cast<int64_t>(wildcardPercent) },
+            { "match_percent", static_cast<int64_t>(positionPercent) }
+        };
+        runner.Run("FindSignature/compiled", params, [&](const size_t iterations) {
+            for (size_t i = 0; i < iterations; ++i)
+                Consume(AddressScanner::FindSignature(image.data(), image.size(), compiled).value_or(0));
+        }, scanned);
+
+        if (!saved.empty())
+            std::ranges::copy(saved, image.begin() + static_cast<ptrdiff_t>(offset));
+    }
+
+    static void RunSyntheticScans(Runner& runner) {
+        if (!runner.Selected("FindSignature"))
+            return;
+
+        auto random = runner.Random(1);
+        std::vector<uint8_t> image(SyntheticSize);
+        for (auto& byte : image)
+            byte = static_cast<uint8_t>(random());
+
+        const auto best = ScanEngine::DetectBackend();
+        for (auto backend = ScanBackend::Scalar; backend <= best; backend = static_cast<ScanBackend>(static_cast<int>(backend) + 1)) {
+            ScanEngine::SetBackend(backend);
+
+            // One axis at a time around a 16-byte, 25% wildcard, not-found baseline
+            for (const size_t length : { 4, 8, 16, 32, 64 })
+                RunSynthetic(runner, image, backend, length, 25, -1);
+            for (const int wildcards : { 0, 50, 75 })
+                RunSynthetic(runner, image, backend, 16, wildcards, -1);
+            for (const int position : { 0, 10, 50, 90 })
+                RunSynthetic(runner, image, backend, 16, 25, position);
+        }
+        ScanEngine::SetBackend(best);
+
+        // The vector overload compiles the pattern on every call
+        auto patternRandom = runner.Random(2);
+        const Pattern pattern = MakePattern(patternRandom, 16, 25);
+        runner.Run("FindSignature/vector", {
+            { "backend", std::string(ScanEngine::BackendName(best)) },
+            { "image", std::string("synthetic") },
+            { "image_bytes", static_cast<int64_t>(image.size()) },
+            { "pattern_length", int64_t{ 16 } },
+            { "wildcard_percent", int64_t{ 25 } },
+            { "match_percent", int64_t{ -1 } }
+        }, [&](const size_t iterations) {
+            for (size_t i = 0; i < iterations; ++i)
+                Consume(AddressScanner::FindSignature(image.data(), image.size(), pattern).value_or(0));
+        }, image.size());
+    }
+
+    // Patterns lifted from the executable sections of loaded modules, every fourth byte masked like a relocation
+    static void RunModuleScans(Runner& runner) {
+        if (!runner.Selected("FindSignature"))
+            return;
+
+        for (const wchar_t* name : { L"ntdll.dll", L"kernel32.dll", static_cast<const wchar_t*>(nullptr) }) {
+            const auto module = ModuleRegistry::Find(name);
+            if (!module)
+                continue;
+
+            const std::vector<ScanRange> ranges = ScanScope::ExecutableSections().Resolve(module->Base);
+            if (ranges.empty())
+                continue;
+            const ScanRange& text = *std::ranges::max_element(ranges, {}, &ScanRange::Size);
+            if (text.Size < 4096)
+                continue;
+
+            char moduleName[MAX_PATH];
+            snprintf(moduleName, sizeof(moduleName), "%ls", module->Name.c_str());
+            size_t totalSize = 0;
+            for (const ScanRange& range : ranges)
+                totalSize += range.Size;
+
+            for (const int position : { 50, 90 }) {
+                const uint8_t* source = module->Base + text.Offset + (text.Size - 64) / 100 * static_cast<size_t>(position);
+                Pattern pattern(16);
+                for (size_t i = 0; i < pattern.size(); ++i) {
+                    if (i % 4 != 3)
+                        pattern[i] = source[i];
+                }
+                const CompiledPattern compiled = CompiledPattern::FromBytes(pattern);
+
+                runner.Run("FindSignature/module", {
+                    { "backend", std::string(ScanEngine::BackendName(ScanEngine::GetBackend())) },
+                    { "image", std::string(moduleName) },
+                    { "image_bytes", static_cast<int64_t>(totalSize) },
+                    { "pattern_length", static_cast<int64_t>(pattern.size()) },
+                    { "wildcard_percent", int64_t{ 25 } },
+                    { "match_percent", static_cast<int64_t>(position) }
+                }, [&](const size_t iterations) {
+                    for (size_t i = 0; i < iterations; ++i)
+                        Consume(AddressScanner::FindSignature(module->Base, ranges, compiled).value_or(0));
+                });
+            }
+        }
+    }
+
+    static void RunParsing(Runner& runner) {
+        for (const size_t length : { 8, 32, 128 }) {
+            for (const int wildcards : { 0, 50 }) {
+                auto random = runner.Random(3 + length * 100 + static_cast<size_t>(wildcards));
+                const std::string text = PatternString(MakePattern(random, length, wildcards));
+                const Params params = {
+                    { "pattern_length", static_cast<int64_t>(length) },
+                    { "wildcard_percent", static_cast<int64_t>(wildcards) }
+                };
+
+                runner.Run("ParsePattern", params, [&](const size_t iterations) {
+                    for (size_t i = 0; i < iterations; ++i)
+                        Consume(AddressScanner::ParsePattern(text).size());
+                });
+                runner.Run("CompiledPattern::Parse", params, [&](const size_t iterations) {
+                    for (size_t i = 0; i < iterations; ++i)
+                        Consume(CompiledPattern::Parse(text).Length);
+                });
+            }
+        }
+    }
+
+    void RunScannerBenchmarks(Runner& runner) {
+        RunParsing(runner);
+        RunSyntheticScans(runner);
+        RunModuleScans(runner);
+    }
+}
@@ -0,0 +1,148 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include "OfflineScan.h"
+
+using namespace ByteWeaverScan;
+
+static void PrintUsage() {
+    fputs("Usage: ByteWeaverScan --patterns <file> [--cache <file>] [--fresh] [--max-matches <n>] [--module <name>] <image>...\n"
+          "  <image> is a PE file or a .bwdump written by ModuleDumper.\n"
+          "  Lists every match of each pattern whose module is the image, flags patterns that are missing or not unique,\n"
+          "  and with --cache stores the resolved offsets in a SignatureCache file (--fresh drops its old entries).\n"
+          "  Exit code: 0 if every pattern resolves uniquely, 1 if any is missing or ambiguous, 2 on errors.\n", stderr);
+}
+
+static const char* Verdict(const PatternReport& report) {
+    if (report.Count == 0)
+        return "MISSING";
+    if (!report.Resolved.has_value())
+        return "SHORT";     // fewer matches than the skip count
+    return report.IsUnique() ? "OK" : "AMBIGUOUS";
+}
+
+static void PrintReport(const PatternReport& report) {
+    const PatternSpec& spec = *report.Spec;
+    printf("%-9s %-32s %zu match%s", Verdict(report), spec.Symbol.c_str(), report.Count, report.Count == 1 ? "" : "es");
+    if (report.Resolved.has_value())
+        printf(", resolves to +0x%llX", static_cast<unsigned long long>(report.Resolved.value()));
+    if (spec.SkipCount)
+        printf(" (skip %zu)", spec.SkipCount);
+    putchar('\n');
+
+    if (report.Count > 1) {
+        for (const uintptr_t offset : report.Offsets)
+            printf("          +0x%llX\n", static_cast<unsigned long long>(offset));
+        if (report.Count > report.Offsets.size())
+            printf("          ... %zu more\n", report.Count - report.Offsets.size());
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    fs::path patternsPath;
+    fs::path cachePath;
+    bool fresh = false;
+    size_t maxMatches = 16;
+    std::wstring moduleName;
+    std::vector<fs::path> images;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--patterns") == 0 && hasValue) {
+            patternsPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--cache") == 0 && hasValue) {
+            cachePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--fresh") == 0) {
+            fresh = true;
+        }
+        else if (strcmp(argv[i], "--max-matches") == 0 && hasValue) {
+            maxMatches = static_cast<size_t>(strtoull(argv[++i], nullptr, 10));
+        }
+        else if (strcmp(argv[i], "--module") == 0 && hasValue) {
+            moduleName = fs::path(argv[++i]).wstring();
+        }
+        else if (argv[i][0] != '-') {
+            images.emplace_back(argv[i]);
+        }
+        else {
+            PrintUsage();
+            return 2;
+        }
+    }
+    if (patternsPath.empty() || images.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    // Only real failures are worth printing next to the report
+    ByteWeaver::SetLogLevel(ByteWeaver::LogLevel::LOG_ERROR);
+
+    std::vector<std::string> errors;
+    const std::vector<PatternSpec> patterns = LoadPatterns(patternsPath, errors);
+    for (const std::string& error : errors)
+        fprintf(stderr, "%s\n", error.c_str());
+    if (!errors.empty())
+        return 2;
+
+    if (!cachePath.empty()) {
+        if (!SignatureCache::Open(cachePath)) {
+            fprintf(stderr, "%s: cannot read cache\n", cachePath.string().c_str());
+            return 2;
+        }
+        if (fresh)
+            SignatureCache::Clear();
+    }
+
+    int exitCode = 0;
+    std::vector<bool> scanned(patterns.size(), false);
+    for (const fs::path& path : images) {
+        std::string error;
+        const auto image = LoadImage(path, moduleName, error);
+        if (!image.has_value()) {
+            fprintf(stderr, "%s: %s\n", path.string().c_str(), error.c_str());
+            exitCode = 2;
+            continue;
+        }
+
+        std::vector<const PatternSpec*> selected;
+        for (size_t i = 0; i < patterns.size(); ++i) {
+            if (NameMatches(patterns[i].Module, image->Name)) {
+                selected.push_back(&patterns[i]);
+                scanned[i] = true;
+            }
+        }
+
+        printf("%ls (%s, %zu bytes, timestamp %08lX, checksum %08lX): %zu pattern%s\n",
+            image->Name.c_str(), path.filename().string().c_str(), image->Bytes.size(),
+            static_cast<unsigned long>(image->Identity.TimeDateStamp), static_cast<unsigned long>(image->Identity.CheckSum),
+            selected.size(), selected.size() == 1 ? "" : "s");
+
+        for (const PatternReport& report : ScanImage(image.value(), selected, maxMatches)) {
+            PrintReport(report);
+            if (!report.IsUnique())
+                exitCode = (std::max)(exitCode, 1);
+
+            // Keyed exactly as AddressDB::UpdateEntries() stores a scan result
+            if (!cachePath.empty() && report.IsUnique()) {
+                const PatternSpec& spec = *report.Spec;
+                SignatureCache::Store(spec.Symbol, spec.Module,
+                    SignatureCache::HashPattern(spec.Pattern, spec.SkipCount, spec.Scope),
+                    image->Identity, report.Resolved.value());
+            }
+        }
+        putchar('\n');
+    }
+
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        if (!scanned[i])
+            fprintf(stderr, "warning: line %zu (%s) matches none of the images\n", patterns[i].Line, patterns[i].Symbol.c_str());
+    }
+
+    if (!cachePath.empty() && !SignatureCache::Save()) {
+        fprintf(stderr, "%s: cannot write cache\n", cachePath.string().c_str());
+        exitCode = 2;
+    }
+    return exitCode;
+}
@@ -0,0 +1,254 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include "OfflineScan.h"
+
+namespace ByteWeaverScan {
+
+    static std::wstring Widen(const std::string& text) {
+        if (text.empty())
+            return {};
+        const int length = MultiByteToWideChar(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), nullptr, 0);
+        std::wstring wide(static_cast<size_t>(length), L'\0');
+        MultiByteToWideChar(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), wide.data(), length);
+        return wide;
+    }
+
+    static std::optional<ScanScope> ParseScope(const std::string& text) {
+        if (text.empty() || text == "image")
+            return ScanScope::WholeImage();
+        if (text == "exec")
+            return ScanScope::ExecutableSections();
+        if (text.starts_with('.'))
+            return ScanScope::NamedSection(text);
+        if (text.starts_with("rva:")) {
+            const size_t plus = text.find('+');
+            if (plus == std::string::npos)
+                return std::nullopt;
+            return ScanScope::Range(std::stoull(text.substr(4, plus - 4), nullptr, 0), std::stoull(text.substr(plus + 1), nullptr, 0));
+        }
+        return std::nullopt;
+    }
+
+    std::vector<PatternSpec> LoadPatterns(const fs::path& path, std::vector<std::string>& errors) {
+        std::vector<PatternSpec> patterns;
+        std::ifstream in(path);
+        if (!in) {
+            errors.push_back("cannot open " + path.string());
+            return patterns;
+        }
+
+        std::string line;
+        for (size_t lineNumber = 1; std::getline(in, line); ++lineNumber) {
+            std::istringstream fields(line);
+            std::string module, symbol, pattern, skip, scope;
+            if (!(fields >> module) || module.starts_with('#'))
+                continue;
+            fields >> symbol >> pattern >> skip >> scope;
+
+            auto reject = [&](const char* reason) {
+                errors.push_back(path.filename().string() + ":" + std::to_string(lineNumber) + ": " + reason);
+            };
+            if (pattern.empty()) {
+                reject("expected <module> <symbol> <pattern> [skip] [scope]");
+                continue;
+            }
+
+            PatternSpec spec;
+            spec.Module = Widen(module);
+            spec.Symbol = symbol;
+            spec.PatternText = pattern;
+            spec.Line = lineNumber;
+            try {
+                spec.Pattern = CompiledPattern::Parse(pattern);
+                spec.SkipCount = skip.empty() ? 0 : std::stoull(skip, nullptr, 0);
+                const auto parsedScope = ParseScope(scope);
+                if (!parsedScope.has_value()) {
+                    reject("unknown scope (image, exec, .section or rva:<begin>+<size>)");
+                    continue;
+                }
+                spec.Scope = parsedScope.value();
+            }
+            catch (const std::exception&) {
+                reject("malformed pattern or number");
+                continue;
+            }
+            if (spec.Pattern.Length == 0) {
+                reject("empty pattern");
+                continue;
+            }
+            patterns.push_back(std::move(spec));
+        }
+        return patterns;
+    }
+
+    // ---- images ----
+
+    // Lays a PE file out at its section RVAs, as the loader maps it
+    static std::optional<std::vector<uint8_t>> MapFile(const std::vector<uint8_t>& file, std::string& error) {
+        if (file.size() < sizeof(IMAGE_DOS_HEADER)) {
+            error = "file too small";
+            return std::nullopt;
+        }
+        const auto dos = reinterpret_cast<const IMAGE_DOS_HEADER*>(file.data());
+        if (dos->e_magic != IMAGE_DOS_SIGNATURE || dos->e_lfanew < 0 ||
+            static_cast<size_t>(dos->e_lfanew) + sizeof(IMAGE_NT_HEADERS) > file.size()) {
+            error = "not a PE file";
+            return std::nullopt;
+        }
+
+        // ScanScope reads the headers with this build's IMAGE_NT_HEADERS, so the image must match it
+        const auto nt = reinterpret_cast<const IMAGE_NT_HEADERS*>(file.data() + dos->e_lfanew);
+        if (nt->Signature != IMAGE_NT_SIGNATURE || nt->OptionalHeader.Magic != IMAGE_NT_OPTIONAL_HDR_MAGIC) {
+            error = WIN64 ? "not a 64-bit PE (use the x86 build of the scanner)" : "not a 32-bit PE (use the x64 build of the scanner)";
+            return std::nullopt;
+        }
+
+        const size_t imageSize = nt->OptionalHeader.SizeOfImage;
+        const size_t headersSize = (std::min)(static_cast<size_t>(nt->OptionalHeader.SizeOfHeaders), (std::min)(file.size(), imageSize));
+        std::vector<uint8_t> image(imageSize, 0);
+        memcpy(image.data(), file.data(), headersSize);
+
+        const IMAGE_SECTION_HEADER* section = IMAGE_FIRST_SECTION(nt);
+        if (reinterpret_cast<const uint8_t*>(section + nt->FileHeader.NumberOfSections) > file.data() + file.size()) {
+            error = "truncated section table";
+            return std::nullopt;
+        }
+        for (WORD i = 0; i < nt->FileHeader.NumberOfSections; ++i, ++section) {
+            const size_t rva = section->VirtualAddress;
+            const size_t raw = section->PointerToRawData;
+            size_t size = section->SizeOfRawData;
+            if (section->Misc.VirtualSize)
+                size = (std::min)(size, static_cast<size_t>(section->Misc.VirtualSize));
+            if (rva >= imageSize || raw >= file.size())
+                continue;
+            size = (std::min)({ size, imageSize - rva, file.size() - raw });
+            memcpy(image.data() + rva, file.data() + raw, size);
+        }
+        return image;
+    }
+
+    std::optional<OfflineImage> LoadImage(const fs::path& path, const std::wstring& moduleName, std::string& error) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            error = "cannot open file";
+            return std::nullopt;
+        }
+
+        char magic[sizeof(ModuleDumpFormat::Magic)] = {};
+        in.read(magic, sizeof(magic));
+        const bool isDump = in.gcount() == sizeof(magic) && memcmp(magic, ModuleDumpFormat::Magic, sizeof(magic)) == 0;
+
+        OfflineImage image;
+        if (isDump) {
+            in.close();
+            auto dump = ModuleDump::Load(path, &error);
+            if (!dump.has_value())
+                return std::nullopt;
+            image.Name = dump->Name;
+            image.Identity = dump->Identity;
+            image.Bytes = std::move(dump->Image);
+        }
+        else {
+            in.seekg(0, std::ios::end);
+            std::vector<uint8_t> file(static_cast<size_t>(in.tellg()));
+            in.seekg(0);
+            if (!in.read(reinterpret_cast<char*>(file.data()), static_cast<std::streamsize>(file.size()))) {
+                error = "read failed";
+                return std::nullopt;
+            }
+            auto mapped = MapFile(file, error);
+            if (!mapped.has_value())
+                return std::nullopt;
+            image.Name = path.filename().wstring();
+            image.Bytes = std::move(mapped.value());
+            image.Identity = ModuleIdentity::FromImage(image.Bytes.data()).value_or(ModuleIdentity{});
+        }
+
+        if (!moduleName.empty())
+            image.Name = moduleName;
+        return image;
+    }
+
+    bool NameMatches(const std::wstring_view moduleName, const std::wstring_view imageName) {
+        // Same rule as ModuleRegistry::NameMatches: case-insensitive, ".dll" when no extension is given
+        auto key = [](const std::wstring_view name) {
+            std::wstring lowered(name.substr(name.find_last_of(L"\\/") + 1));
+            for (auto& c : lowered)
+                c = towlower(c);
+            if (lowered.find(L'.') == std::wstring::npos)
+                lowered += L".dll";
+            return lowered;
+        };
+        return key(moduleName) == key(imageName);
+    }
+
+    // ---- scanning ----
+
+    // Counts the matches in the ranges after offset `after` (which is itself a match)
+    static size_t CountAfter(const uint8_t* image, const std::vector<ScanRange>& ranges, const CompiledPattern& pattern, const uintptr_t after) {
+        size_t count = 0;
+        for (const ScanRange& range : ranges) {
+            if (range.Offset + range.Size <= after)
+                continue;
+            const size_t from = (std::max)(range.Offset, static_cast<size_t>(after + 1));
+            size_t skipped = 0;
+            ScanEngine::Find(image + from, range.Offset + range.Size - from, pattern, SIZE_MAX, &skipped);
+            count += skipped;
+        }
+        return count;
+    }
+
+    std::vector<PatternReport> ScanImage(const OfflineImage& image, const std::span<const PatternSpec* const> patterns, const size_t listLimit) {
+        std::vector<PatternReport> reports(patterns.size());
+        if (image.Bytes.empty())
+            return reports;
+
+        // The scanner API takes mutable pointers; nothing is written through them
+        auto* base = const_cast<uint8_t*>(image.Bytes.data());
+
+        std::vector<bool> done(patterns.size(), false);
+        for (size_t first = 0; first < patterns.size(); ++first) {
+            if (done[first])
+                continue;
+
+            // Every pattern sharing this scope goes into one multi-pattern pass
+            const ScanScope& scope = patterns[first]->Scope;
+            std::vector<size_t> group;
+            std::vector<ScanJob> jobs;
+            for (size_t i = first; i < patterns.size(); ++i) {
+                if (done[i] || patterns[i]->Scope != scope)
+                    continue;
+                done[i] = true;
+                group.push_back(i);
+                // Skipping listLimit matches records up to listLimit + 1 of them
+                jobs.push_back({ &patterns[i]->Pattern, (std::max)(listLimit, patterns[i]->SkipCount) });
+            }
+
+            const std::vector<ScanRange> ranges = scope.Resolve(base);
+            MultiPatternIndex index(jobs, true);
+            for (const ScanRange& range : ranges) {
+                if (index.Pending() == 0)
+                    break;
+                AddressScanner::FindSignatures(base + range.Offset, range.Size, index);
+            }
+
+            for (size_t j = 0; j < group.size(); ++j) {
+                PatternReport& report = reports[group[j]];
+                report.Spec = patterns[group[j]];
+
+                const std::span<const uintptr_t> matches = index.Matches(j);
+                for (const uintptr_t match : matches)
+                    report.Offsets.push_back(match - reinterpret_cast<uintptr_t>(base));
+                report.Count = report.Offsets.size();
+                if (index.IsResolved(j))
+                    report.Count += CountAfter(base, ranges, report.Spec->Pattern, report.Offsets.back());
+
+                if (report.Spec->SkipCount < report.Offsets.size())
+                    report.Resolved = report.Offsets[report.Spec->SkipCount];
+                if (report.Offsets.size() > listLimit)
+                    report.Offsets.resize(listLimit);
+            }
+        }
+        return reports;
+    }
+}
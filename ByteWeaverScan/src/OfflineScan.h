@@ -0,0 +1,79 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include <ByteWeaver.h>
+
+namespace ByteWeaverScan {
+
+    using namespace ByteWeaver;
+
+    /**
+     * @brief One line of a pattern list: the arguments of an AddressDB::AddWithScanPattern() call.
+     *
+     * Lines are whitespace separated: `<module> <symbol> <pattern> [skip] [scope]`, where scope is
+     * `image` (default), `exec`, a section name such as `.text`, or `rva:<begin>+<size>`. Blank lines
+     * and lines starting with '#' are ignored.
+     */
+    struct PatternSpec {
+        std::wstring Module;
+        std::string Symbol;
+        std::string PatternText;
+        CompiledPattern Pattern;
+        size_t SkipCount = 0;
+        ScanScope Scope{};
+        size_t Line = 0;
+    };
+
+    /**
+     * @brief A module image laid out at its RVAs, as the loader would map it (without relocations).
+     */
+    struct OfflineImage {
+        std::wstring Name;
+        ModuleIdentity Identity{};
+        std::vector<uint8_t> Bytes;
+    };
+
+    /// @brief Outcome of one pattern against one image
+    struct PatternReport {
+        const PatternSpec* Spec = nullptr;
+
+        /// @brief Offsets of the first matches, in address order (at most the listing limit)
+        std::vector<uintptr_t> Offsets;
+
+        /// @brief Total number of matches in the pattern's scope
+        size_t Count = 0;
+
+        /// @brief Offset the pattern resolves to at runtime (match SkipCount), if it does
+        std::optional<uintptr_t> Resolved;
+
+        /// @brief Resolves to the same match in every build it matches the same way
+        bool IsUnique() const noexcept { return Resolved.has_value() && (Count == 1 || Spec->SkipCount > 0); }
+    };
+
+    /**
+     * @brief Reads a pattern list (see PatternSpec).
+     * @param errors Receives one message per rejected line
+     */
+    std::vector<PatternSpec> LoadPatterns(const fs::path& path, std::vector<std::string>& errors);
+
+    /**
+     * @brief Loads a PE file from disk, or a module dump written by ModuleDumper.
+     * @param moduleName Name recorded for the image; empty to use the dump's name or the file name
+     */
+    std::optional<OfflineImage> LoadImage(const fs::path& path, const std::wstring& moduleName, std::string& error);
+
+    /// @brief Returns true if a pattern list module name refers to the image (same rule as ModuleRegistry)
+    bool NameMatches(std::wstring_view moduleName, std::wstring_view imageName);
+
+    /**
+     * @brief Finds every match of the patterns in an image.
+     *
+     * Patterns sharing a scope are resolved together with one multi-pattern pass per range
+     * (AddressScanner::FindSignatures); only patterns with more than listLimit matches are
+     * scanned again on their own to finish the count.
+     *
+     * @param listLimit Number of offsets listed per pattern
+     */
+    std::vector<PatternReport> ScanImage(const OfflineImage& image, std::span<const PatternSpec* const> patterns, size_t listLimit);
+}
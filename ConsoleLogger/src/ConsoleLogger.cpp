@@ -1,57 +1,266 @@
 #include <Windows.h>
+#include <fstream>
 #include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <BinaryLogFormat.hpp>
 
 constexpr auto PIPE_NAME = R"(\\.\pipe\ConsoleLoggerPipe)";
+constexpr DWORD PIPE_BUFFER_SIZE = 64 * 1024;
+constexpr size_t LISTENING_INSTANCES = 4;   // Idle instances kept open so clients never find the pipe busy
+
+// One pipe instance. The OVERLAPPED comes first: completions hand back its address.
+struct PipeClient
+{
+    OVERLAPPED Overlapped{};
+    HANDLE Pipe = INVALID_HANDLE_VALUE;
+    bool Connected = false;
+    ULONG ProcessId = 0;
+    std::string Partial;    // Text after the last newline, kept until the line completes
+    char Buffer[PIPE_BUFFER_SIZE];
+};
+
+static size_t ListeningCount = 0;
+static size_t ConnectedCount = 0;
+
+// Creates an instance bound to the port and starts waiting for a client on it
+bool Listen(const HANDLE port)
+{
+    auto* client = new PipeClient();
+    client->Pipe = CreateNamedPipeA(
+        PIPE_NAME,
+        PIPE_ACCESS_DUPLEX | FILE_FLAG_OVERLAPPED,
+        PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT,
+        PIPE_UNLIMITED_INSTANCES,
+        PIPE_BUFFER_SIZE, PIPE_BUFFER_SIZE,
+        0,
+        nullptr);
+
+    if (client->Pipe == INVALID_HANDLE_VALUE)
+    {
+        std::cerr << "Failed to create named pipe. Error: " << GetLastError() << "\n";
+        delete client;
+        return false;
+    }
+
+    if (!CreateIoCompletionPort(client->Pipe, port, 0, 0))
+    {
+        std::cerr << "Failed to bind named pipe. Error: " << GetLastError() << "\n";
+        CloseHandle(client->Pipe);
+        delete client;
+        return false;
+    }
+
+    if (!ConnectNamedPipe(client->Pipe, &client->Overlapped))
+    {
+        const DWORD error = GetLastError();
+        if (error == ERROR_PIPE_CONNECTED)
+        {
+            // The client beat us to it; no completion is queued for this case
+            PostQueuedCompletionStatus(port, 0, 0, &client->Overlapped);
+        }
+        else if (error != ERROR_IO_PENDING)
+        {
+            std::cerr << "Failed to connect named pipe. Error: " << error << "\n";
+            CloseHandle(client->Pipe);
+            delete client;
+            return false;
+        }
+    }
+
+    ++ListeningCount;
+    return true;
+}
+
+bool BeginRead(PipeClient* client)
+{
+    // Completes through the port even when the data is already there
+    return ReadFile(client->Pipe, client->Buffer, sizeof(client->Buffer), nullptr, &client->Overlapped)
+        || GetLastError() == ERROR_IO_PENDING;
+}
+
+// Prints the complete lines of a read; lines are prefixed with the writer's pid while several are connected
+void Output(PipeClient* client, const char* data, const size_t size, const bool final)
+{
+    client->Partial.append(data, size);
+
+    size_t end = client->Partial.rfind('\n');
+    const bool unterminated = end != client->Partial.size() - 1 && !client->Partial.empty();
+    if (unterminated && (final || client->Partial.size() - (end + 1) >= PIPE_BUFFER_SIZE))
+    {
+        // Last words of a client, or a line longer than the pipe buffer: print it rather than wait
+        client->Partial.push_back('\n');
+        end = client->Partial.size() - 1;
+    }
+    if (end == std::string::npos)
+        return;
+
+    if (ConnectedCount <= 1)
+    {
+        std::cout.write(client->Partial.data(), static_cast<std::streamsize>(end + 1));
+    }
+    else
+    {
+        const std::string prefix = "[" + std::to_string(client->ProcessId) + "] ";
+        std::string out;
+        out.reserve(end + 1 + prefix.size() * 16);
+        for (size_t line = 0; line <= end;)
+        {
+            const size_t next = client->Partial.find('\n', line);
+            out += prefix;
+            out.append(client->Partial, line, next - line + 1);
+            line = next + 1;
+        }
+        std::cout << out;
+    }
+    std::cout << std::flush;
+    client->Partial.erase(0, end + 1);
+}
+
+void Disconnect(PipeClient* client)
+{
+    Output(client, nullptr, 0, true);
+    --ConnectedCount;
+    std::cout << "[Logger] Client " << client->ProcessId << " disconnected.\n";
+    CloseHandle(client->Pipe);
+    delete client;
+}
 
+// Serves any number of clients from one thread: every instance is overlapped and completes on one port
 [[noreturn]] void RunLogger()
 {
+    const HANDLE port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1);
+    if (!port)
+    {
+        std::cerr << "Failed to create completion port. Error: " << GetLastError() << "\n";
+        ExitProcess(1);
+    }
+
+    std::cout << "[Logger] Waiting for client connection...\n";
+
     while (true)
     {
-        const HANDLE hPipe = CreateNamedPipeA(
-            PIPE_NAME,
-            PIPE_ACCESS_DUPLEX,
-            PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT,
-            1,              // Max instances
-            4096, 4096,     // Buffers
-            0,
-            nullptr);
+        while (ListeningCount < LISTENING_INSTANCES)
+        {
+            if (!Listen(port))
+            {
+                Sleep(1000); // Wait before retrying
+                break;
+            }
+        }
 
-        if (hPipe == INVALID_HANDLE_VALUE)
+        DWORD bytes = 0;
+        ULONG_PTR key = 0;
+        OVERLAPPED* overlapped = nullptr;
+        const BOOL ok = GetQueuedCompletionStatus(port, &bytes, &key, &overlapped, INFINITE);
+        if (!overlapped)
+            continue;
+
+        auto* client = reinterpret_cast<PipeClient*>(overlapped);
+        if (!client->Connected)
+        {
+            --ListeningCount;
+            if (!ok)
+            {
+                CloseHandle(client->Pipe);
+                delete client;
+                continue;
+            }
+
+            client->Connected = true;
+            ++ConnectedCount;
+            GetNamedPipeClientProcessId(client->Pipe, &client->ProcessId);
+            std::cout << "[Logger] Client " << client->ProcessId << " connected!\n";
+        }
+        else if (ok)
+        {
+            Output(client, client->Buffer, bytes, false);
+        }
+        else
         {
-            std::cerr << "Failed to create named pipe. Error: " << GetLastError() << "\n";
-            Sleep(1000); // Wait before retrying
+            // ERROR_BROKEN_PIPE: the client closed its end
+            Disconnect(client);
             continue;
         }
 
-        std::cout << "[Logger] Waiting for client connection...\n";
+        if (!BeginRead(client))
+            Disconnect(client);
+    }
+}
+
+
+// Renders a BinaryLog stream as "[seconds][thread][LEVEL]message" lines
+int DecodeBinaryLog(const char* path)
+{
+    using namespace ByteWeaver::BinaryLogFormat;
 
-        if (!ConnectNamedPipe(hPipe, nullptr) && GetLastError() != ERROR_PIPE_CONNECTED)
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        std::cerr << "Unable to open " << path << "\n";
+        return 1;
+    }
+    const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    FileHeader fileHeader{};
+    if (data.size() < sizeof(fileHeader) || memcmp(data.data(), Magic, sizeof(Magic)) != 0)
+    {
+        std::cerr << path << " is not a binary log\n";
+        return 1;
+    }
+    memcpy(&fileHeader, data.data(), sizeof(fileHeader));
+    if (fileHeader.Version != Version)
+    {
+        std::cerr << "Unsupported binary log version " << fileHeader.Version << "\n";
+        return 1;
+    }
+
+    constexpr const char* levels[] = { "DEBUG", "INFO", "WARN", "ERROR" };
+    std::unordered_map<uint32_t, std::string> formats;
+    size_t offset = sizeof(fileHeader);
+    while (offset + sizeof(RecordHeader) <= data.size())
+    {
+        RecordHeader header{};
+        memcpy(&header, data.data() + offset, sizeof(header));
+        if (header.Size < sizeof(header) || offset + header.Size > data.size())
         {
-            std::cerr << "Failed to connect named pipe. Error: " << GetLastError() << "\n";
-            CloseHandle(hPipe);
-            continue;
+            std::cerr << "Truncated record at offset " << offset << "\n";
+            break;
         }
 
-        std::cout << "[Logger] Client connected!\n";
+        const uint8_t* payload = data.data() + offset + sizeof(header);
+        const size_t payloadSize = header.Size - sizeof(header);
+        offset += header.Size;
 
-        // Block this thread for this pipe instance
-        char buffer[512];
-        DWORD bytesRead;
-        while (ReadFile(hPipe, buffer, sizeof(buffer) - 1, &bytesRead, nullptr))
+        if (header.Kind == RecordKind::Format)
         {
-            buffer[bytesRead] = '\0';
-            std::cout << buffer << std::flush;
+            formats[header.FormatId].assign(reinterpret_cast<const char*>(payload), payloadSize);
+            continue;
         }
 
-        std::cout << "[Logger] Client disconnected.\n";
-        CloseHandle(hPipe);
+        const auto format = formats.find(header.FormatId);
+        const std::string text = format != formats.end()
+            ? Render(format->second, payload, payloadSize)
+            : "<unknown format " + std::to_string(header.FormatId) + ">";
 
-        // Now loop and create new pipe
+        const double seconds = fileHeader.TimestampFrequency
+            ? static_cast<double>(static_cast<int64_t>(header.Timestamp - fileHeader.TimestampBase)) / static_cast<double>(fileHeader.TimestampFrequency)
+            : 0.0;
+        char prefix[64];
+        snprintf(prefix, sizeof(prefix), "[%12.6f][%5lu][%s]", seconds, static_cast<unsigned long>(header.ThreadId),
+            header.Level < std::size(levels) ? levels[header.Level] : "?");
+        std::cout << prefix << text << "\n";
     }
+    return 0;
 }
 
 
-int main()
+int main(const int argc, char** argv)
 {
+    if (argc == 3 && strcmp(argv[1], "--decode") == 0)
+        return DecodeBinaryLog(argv[2]);
+
     RunLogger();
 }
\ No newline at end of file
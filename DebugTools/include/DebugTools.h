@@ -28,6 +28,30 @@ namespace ByteWeaver::DebugTools
         static bool InitSymbols();
     };
 
+    // Address -> symbol LRU shared by every traceback; DbgHelp is only asked about misses.
+    // Addresses DbgHelp could not resolve are asked again once a module loads or unloads.
+    class SymbolCache {
+    public:
+        struct Symbol {
+            std::string Name{};
+            uint64_t Displacement = 0;
+            std::string File{};
+            uint32_t Line = 0;
+        };
+        using SymbolPtr = std::shared_ptr<const Symbol>;
+
+        // nullptr if symbols are not loaded or DbgHelp knows nothing about the address
+        static SymbolPtr Resolve(uintptr_t address);
+
+        // One result per address; every miss is resolved under a single SymMutex hold
+        static std::vector<SymbolPtr> ResolveAll(std::span<void* const> addresses);
+
+        static void SetCapacity(size_t capacity);
+        static void Clear();
+        static uint64_t Hits();
+        static uint64_t Misses();
+    };
+
     class Inspection {
     public:
         struct ModuleInfo {
@@ -79,52 +103,18 @@ namespace ByteWeaver::DebugTools
         struct FrameInfo {
             uintptr_t CallAddress{};
             USHORT    StackIndex{};
-            void Dump() const
-            {
-                char msg[1024];
-                int len = _snprintf_s(msg, sizeof(msg), _TRUNCATE,
-                    "[FrameInfo] %-2u) - " ADDR_FMT,
-                    StackIndex, CallAddress);
-                if (len < 0) len = static_cast<int>(strlen(msg)); // handle truncation semantics
-
-                if (SymbolLoader::SymLoaded) {
-                    DWORD64 displacement = 0;
-                    DWORD displacement32 = 0;
-
-                    // SYMBOL_INFO
-                    // ReSharper disable once CppLocalVariableMayBeConst
-                    char buffer[sizeof(SYMBOL_INFO) + 512]{};
-                    auto* symbol = reinterpret_cast<SYMBOL_INFO*>(buffer);
-                    symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
-                    symbol->MaxNameLen = 512;
-
-                    IMAGEHLP_LINE64 line{};
-                    line.SizeOfStruct = sizeof(line);
-
-                    std::lock_guard lock(SymbolLoader::SymMutex);
-
-                    if (SymFromAddr(GetCurrentProcess(), CallAddress, &displacement, symbol)) {
-                        const int n = _snprintf_s(msg + len, sizeof(msg) - len, _TRUNCATE,
-                            "  %s+0x%llx",
-                            symbol->Name,
-                            static_cast<unsigned long long>(displacement));
-                        // ReSharper disable once CppDFAUnusedValue
-                        if (n > 0) len += n;
-                    }
-
-                    if constexpr (WIN64) {
-                        if (SymGetLineFromAddr64(GetCurrentProcess(), CallAddress, &displacement32, &line)) {
-                            _snprintf_s(msg + len, sizeof(msg) - len, _TRUNCATE,
-                                "  [%s:%lu]",
-                                line.FileName,
-                                static_cast<unsigned long>(line.LineNumber));
-                        }
-                    }
-                }
+            void Dump() const;
+        };
 
-                Debug("%s", msg);
-            }
+        // Return addresses only: no symbols and no allocation, cheap enough for hot hooks.
+        // Symbolize later, in bulk, with Dump() or SymbolCache::ResolveAll().
+        struct RawTrace {
+            uint64_t Hash{};                // equal stacks hash equal (StackCounter keys on it)
+            USHORT StackSize{};
+            std::array<void*, 62> Stack{};
 
+            std::span<void* const> Frames() const { return { Stack.data(), StackSize }; }
+            void Dump() const;
         };
 
         struct TraceInfo {
@@ -139,7 +129,26 @@ namespace ByteWeaver::DebugTools
         };
 
 
+        static uint64_t HashStack(const void* const* stack, const USHORT count) {
+            uint64_t hash = 0xcbf29ce484222325ULL;
+            for (USHORT i = 0; i < count; ++i) {
+                hash ^= reinterpret_cast<uintptr_t>(stack[i]);
+                hash *= 0x100000001b3ULL;
+            }
+            return hash;
+        }
+
 #ifdef _WIN64
+        // Same frames as Capture(), without building FrameInfo entries
+        static RawTrace CaptureRaw(const USHORT skip = 1, USHORT maxFrames = 62) {
+            if (maxFrames > 62) maxFrames = 62;
+
+            RawTrace trace;
+            trace.StackSize = RtlCaptureStackBackTrace(skip, maxFrames, trace.Stack.data(), nullptr);
+            trace.Hash = HashStack(trace.Stack.data(), trace.StackSize);
+            return trace;
+        }
+
         // skip: frames to skip from the top (this function, its caller, etc.)
         // maxFrames: how many frames to capture (capped at 62 by the API)
         static TraceInfo Capture(const USHORT skip = 1, USHORT maxFrames = 62) {
@@ -191,6 +200,15 @@ namespace ByteWeaver::DebugTools
             return count;
         }
 
+        static RawTrace CaptureRaw(const USHORT skip = 1, USHORT maxFrames = 62) {
+            if (maxFrames > 62) maxFrames = 62;
+
+            RawTrace trace;
+            trace.StackSize = ScanStackMemory(skip, maxFrames, trace.Stack.data());
+            trace.Hash = HashStack(trace.Stack.data(), trace.StackSize);
+            return trace;
+        }
+
         static TraceInfo Capture(const USHORT skip = 1, USHORT maxFrames = 62) {
             if (maxFrames > 62) maxFrames = 62;
 
@@ -212,4 +230,54 @@ namespace ByteWeaver::DebugTools
         }
 #endif
     };
+
+    // Preallocated pool of raw traces filled from hot paths and drained in bulk.
+    // Push() never allocates, but it is not lock-free: it copies the trace under a mutex that
+    // Drain() and Size() also take briefly, so do not push where blocking is unsafe (e.g. while
+    // other threads are suspended).
+    class TracePool {
+    public:
+        explicit TracePool(size_t capacity = 1024);
+
+        // Copies the trace into the pool; false (and counted as dropped) when the pool is full
+        bool Push(const Traceback::RawTrace& trace);
+
+        // Hands over every pooled trace; the pool gets a fresh buffer of the same capacity
+        std::vector<Traceback::RawTrace> Drain();
+
+        size_t Size() const;
+        uint64_t Dropped() const { return _Dropped.load(std::memory_order_relaxed); }
+
+    private:
+        mutable std::mutex _Mutex;
+        std::vector<Traceback::RawTrace> _Traces;
+        size_t _Capacity;
+        std::atomic<uint64_t> _Dropped{ 0 };
+    };
+
+    // Counts traces by stack hash, keeping one sample per distinct stack, for "top N call sites"
+    class StackCounter {
+    public:
+        struct Site {
+            Traceback::RawTrace Trace{};
+            uint64_t Count = 0;
+        };
+
+        void Add(const Traceback::RawTrace& trace, uint64_t count = 1);
+
+        // The n most frequent stacks, most frequent first
+        std::vector<Site> Top(size_t n) const;
+
+        // Logs Top(n), symbolized through SymbolCache
+        void DumpTop(size_t n) const;
+
+        size_t Distinct() const;
+        uint64_t Total() const;
+        void Clear();
+
+    private:
+        mutable std::mutex _Mutex;
+        std::unordered_map<uint64_t, Site> _Sites;
+        uint64_t _Total = 0;
+    };
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ByteWeaverPCH.h"
+#include <ModuleRegistry.h>
 
 #include <winternl.h>
 
@@ -57,84 +58,34 @@ namespace ByteWeaver::DebugTools {
 
     // ------------------------------------------------------------
     // Find loaded module base by DLL name (e.g. L"kernel32.dll")
-    // Uses BaseDllName (not FullDllName) for cleaner exact matching.
+    // Served from ModuleRegistry, which is seeded from the same PEB loader
+    // list (BaseDllName matching, case-insensitive) and kept current by
+    // loader notifications.
     // ------------------------------------------------------------
     static BYTE* FindLoadedModuleBase(const wchar_t* dllName)
     {
         if (!dllName) return nullptr;
 
-        PEB* peb = GetPeb();
-        if (!peb || !peb->Ldr) return nullptr;
-
-        PPEB_LDR_DATA ldr = peb->Ldr;
-        LIST_ENTRY* listHead = &ldr->InMemoryOrderModuleList;
-
-        for (LIST_ENTRY* curr = listHead->Flink; curr != listHead; curr = curr->Flink)
-        {
-            auto* entry = CONTAINING_RECORD(curr, LDR_DATA_TABLE_ENTRY, InMemoryOrderLinks);
-
-            // Prefer BaseDllName (e.g. "kernel32.dll") instead of FullDllName path
-            if (!entry->BaseDllName.Buffer)
-                continue;
-
-            if (StrEqIW(entry->BaseDllName.Buffer, dllName))
-                return reinterpret_cast<BYTE*>(entry->DllBase);
-        }
-
-        return nullptr;
+        const auto module = ModuleRegistry::Find(dllName);
+        return module ? module->Base : nullptr;
     }
 
     // ------------------------------------------------------------
     // Resolve an export by name from a loaded module base
-    // (manual GetProcAddress)
+    // (manual GetProcAddress, backed by the shared per-module ExportIndex;
+    // forwarded exports such as "KERNELBASE.SleepEx" are followed)
     // ------------------------------------------------------------
     static void* ResolveExportByName(BYTE* moduleBase, const char* funcName)
     {
         if (!moduleBase || !funcName)
             return nullptr;
 
-        // Validate DOS header
-        auto* dos = reinterpret_cast<IMAGE_DOS_HEADER*>(moduleBase);
-        if (dos->e_magic != IMAGE_DOS_SIGNATURE) // "MZ"
-            return nullptr;
-
-        // Validate NT headers
-        auto* nt = reinterpret_cast<IMAGE_NT_HEADERS*>(moduleBase + dos->e_lfanew);
-        if (nt->Signature != IMAGE_NT_SIGNATURE) // "PE\0\0"
+        const auto exports = ExportIndex::Get(moduleBase);
+        if (!exports)
             return nullptr;
 
-        // Export directory
-        const IMAGE_DATA_DIRECTORY& exportDirData =
-            nt->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT];
-
-        if (exportDirData.VirtualAddress == 0 || exportDirData.Size == 0)
-            return nullptr;
-
-        auto* exportDir = reinterpret_cast<IMAGE_EXPORT_DIRECTORY*>(
-            moduleBase + exportDirData.VirtualAddress);
-
-        auto* nameRVAs = reinterpret_cast<DWORD*>(moduleBase + exportDir->AddressOfNames);
-        auto* funcRVAs = reinterpret_cast<DWORD*>(moduleBase + exportDir->AddressOfFunctions);
-        auto* ordinals = reinterpret_cast<WORD*>(moduleBase + exportDir->AddressOfNameOrdinals);
-
-        // Search by exported name
-        for (DWORD i = 0; i < exportDir->NumberOfNames; ++i)
-        {
-            const char* exportName = reinterpret_cast<const char*>(moduleBase + nameRVAs[i]);
-            if (!StrEqA(exportName, funcName))
-                continue;
-
-            WORD ordinalIndex = ordinals[i];
-            DWORD funcRva = funcRVAs[ordinalIndex];
-
-            // NOTE:
-            // If funcRva points inside the export directory range, it's a forwarded export.
-            // This function does NOT resolve forwarders (e.g., "KERNELBASE.SleepEx").
-            // You can add forwarder handling if needed.
-            return reinterpret_cast<void*>(moduleBase + funcRva);
-        }
-
-        return nullptr;
+        const auto address = exports->FindByName(funcName);
+        return address ? reinterpret_cast<void*>(*address) : nullptr;
     }
 
     // ------------------------------------------------------------
@@ -0,0 +1,106 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#pragma once
+
+#include "DebugTools.h"
+
+#include <chrono>
+
+namespace ByteWeaver::DebugTools
+{
+    // In-process sampling profiler. A background thread wakes every Interval, suspends each
+    // target thread just long enough to copy its context and the top of its stack into a fixed
+    // buffer, resumes it, and only then unwinds the copy and counts the stack (StackCounter).
+    // Symbols are resolved when a report is asked for, through SymbolCache, so sampling never
+    // touches DbgHelp.
+    //
+    // Nothing allocates or locks while a thread is suspended. Unwinding (x64) takes the loader's
+    // function table locks, which the suspended thread may hold, so it only runs on the copy once
+    // the thread is running again. Frames deeper than StackBytes are cut off.
+    class SamplingProfiler {
+    public:
+        struct Options {
+            std::chrono::milliseconds Interval{ 10 };           // between sampling passes
+            USHORT MaxFrames = 62;                              // per stack, capped at 62
+            std::vector<DWORD> ThreadIds{};                     // empty: every thread but the sampler
+            std::chrono::milliseconds ThreadRefresh{ 1000 };    // how often new threads are picked up
+            size_t StackBytes = 64 * 1024;                      // stack copied per sample, from the stack pointer up
+        };
+
+        struct Stats {
+            uint64_t Passes = 0;            // sampling passes over the thread list
+            uint64_t Samples = 0;           // stacks recorded
+            uint64_t Failed = 0;            // threads that could not be suspended or read
+            uint64_t SuspendedNs = 0;       // total time target threads spent suspended
+        };
+
+        struct FunctionStat {
+            uintptr_t Function = 0;         // start of the function (or the address when unknown)
+            std::string Name{};             // module!symbol, or module!+0xRVA
+            uint64_t Self = 0;              // samples with the function on top
+            uint64_t Total = 0;             // samples with the function anywhere in the stack
+        };
+
+        struct ModuleStat {
+            std::string Name{};
+            uint64_t Self = 0;
+            uint64_t Total = 0;
+        };
+
+        SamplingProfiler();
+        explicit SamplingProfiler(Options options);
+        ~SamplingProfiler();
+
+        SamplingProfiler(const SamplingProfiler&) = delete;
+        SamplingProfiler& operator=(const SamplingProfiler&) = delete;
+
+        bool Start();
+        void Stop();
+        bool IsRunning() const { return _Running.load(); }
+
+        // Drops every sample and zeroes the stats (the profiler keeps running)
+        void Reset();
+
+        Stats GetStats() const;
+
+        // By Self, then Total; n = 0 returns every function
+        std::vector<FunctionStat> TopFunctions(size_t n) const;
+
+        // By Self, then Total
+        std::vector<ModuleStat> Modules() const;
+
+        // Collapsed stacks ("root;caller;leaf count" per line), as read by flamegraph.pl and speedscope
+        std::string Collapsed() const;
+        bool SaveCollapsed(const std::filesystem::path& path) const;
+
+        // Logs the stats, the top n functions and every module
+        void DumpTop(size_t n) const;
+
+    private:
+        struct Report;
+
+        void Run();
+        void RefreshThreads();
+        void SampleThreads();
+        void CloseThreads();
+        Report BuildReport() const;
+
+        Options _Options;
+        StackCounter _Stacks;
+
+        std::thread _Thread;
+        std::atomic<bool> _Running{ false };
+        std::mutex _StopMutex;
+        std::condition_variable _StopSignal;
+        bool _StopRequested = false;
+
+        // Touched by the sampler thread only
+        std::vector<std::pair<DWORD, HANDLE>> _Threads;
+        std::unique_ptr<uint8_t[]> _StackCopy;
+
+        std::atomic<uint64_t> _Passes{ 0 };
+        std::atomic<uint64_t> _Samples{ 0 };
+        std::atomic<uint64_t> _Failed{ 0 };
+        std::atomic<uint64_t> _SuspendedNs{ 0 };
+    };
+}
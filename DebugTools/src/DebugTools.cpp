@@ -2,7 +2,9 @@
 
 #include <DebugTools.h>
 #include <MemoryManager.h>
+#include <ModuleRegistry.h>
 
+#include <list>
 #include <utility>
 #include <psapi.h>
 
@@ -92,6 +94,7 @@ namespace ByteWeaver::DebugTools {
         if (const int prev = SymRefCount.fetch_sub(1, std::memory_order_acq_rel); prev == 1 && SymLoaded) {
             SymCleanup(GetCurrentProcess());
             SymLoaded = false;
+            SymbolCache::Clear();
         }
     }
 
@@ -102,9 +105,274 @@ namespace ByteWeaver::DebugTools {
             SymRefCount.store(0, std::memory_order_release);
             SymCleanup(GetCurrentProcess());
             SymLoaded = false;
+            SymbolCache::Clear();
         }
     }
 
+    // ---- SymbolCache ----
+    // Most recently used first; a null Symbol records that DbgHelp had nothing for the address
+    // while ModuleRegistry was at Generation, and is only trusted until a module loads or unloads
+    struct CachedSymbol {
+        uintptr_t Address;
+        SymbolCache::SymbolPtr Symbol;
+        uint64_t Generation;
+    };
+
+    static std::mutex CacheMutex;
+    static std::list<CachedSymbol> CacheOrder;
+    static std::unordered_map<uintptr_t, std::list<CachedSymbol>::iterator> CacheIndex;
+    static size_t CacheCapacity = 4096;
+    static std::atomic<uint64_t> CacheHits{ 0 };
+    static std::atomic<uint64_t> CacheMisses{ 0 };
+
+    // CacheMutex must be held
+    static bool FindCached(const uintptr_t address, const uint64_t generation, SymbolCache::SymbolPtr& symbol) {
+        const auto it = CacheIndex.find(address);
+        if (it == CacheIndex.end() || (!it->second->Symbol && it->second->Generation != generation))
+            return false;
+        CacheOrder.splice(CacheOrder.begin(), CacheOrder, it->second);
+        symbol = it->second->Symbol;
+        return true;
+    }
+
+    // CacheMutex must be held
+    static void InsertCached(const uintptr_t address, SymbolCache::SymbolPtr symbol, const uint64_t generation) {
+        if (const auto it = CacheIndex.find(address); it != CacheIndex.end()) {
+            it->second->Symbol = std::move(symbol);
+            it->second->Generation = generation;
+            return;
+        }
+        CacheOrder.push_front({ address, std::move(symbol), generation });
+        CacheIndex.emplace(address, CacheOrder.begin());
+        while (CacheOrder.size() > CacheCapacity) {
+            CacheIndex.erase(CacheOrder.back().Address);
+            CacheOrder.pop_back();
+        }
+    }
+
+    // SymbolLoader::SymMutex must be held
+    static SymbolCache::SymbolPtr LookupSymbol(const uintptr_t address) {
+        char buffer[sizeof(SYMBOL_INFO) + 512]{};
+        auto* info = reinterpret_cast<SYMBOL_INFO*>(buffer);
+        info->SizeOfStruct = sizeof(SYMBOL_INFO);
+        info->MaxNameLen = 512;
+
+        SymbolCache::Symbol symbol{};
+        bool found = false;
+        DWORD64 displacement = 0;
+        if (SymFromAddr(GetCurrentProcess(), address, &displacement, info)) {
+            symbol.Name = info->Name;
+            symbol.Displacement = displacement;
+            found = true;
+        }
+
+        if constexpr (WIN64) {
+            IMAGEHLP_LINE64 line{};
+            line.SizeOfStruct = sizeof(line);
+            DWORD displacement32 = 0;
+            if (SymGetLineFromAddr64(GetCurrentProcess(), address, &displacement32, &line)) {
+                symbol.File = line.FileName;
+                symbol.Line = static_cast<uint32_t>(line.LineNumber);
+                found = true;
+            }
+        }
+
+        return found ? std::make_shared<const SymbolCache::Symbol>(std::move(symbol)) : nullptr;
+    }
+
+    SymbolCache::SymbolPtr SymbolCache::Resolve(const uintptr_t address) {
+        void* const frame = reinterpret_cast<void*>(address);
+        return ResolveAll({ &frame, 1 }).front();
+    }
+
+    std::vector<SymbolCache::SymbolPtr> SymbolCache::ResolveAll(const std::span<void* const> addresses) {
+        std::vector<SymbolPtr> symbols(addresses.size());
+        std::vector<size_t> misses;
+
+        // Read before the lookups, so a module that loads meanwhile invalidates what they miss
+        const uint64_t generation = ModuleRegistry::Generation();
+        {
+            std::lock_guard lock(CacheMutex);
+            for (size_t i = 0; i < addresses.size(); ++i) {
+                if (!FindCached(reinterpret_cast<uintptr_t>(addresses[i]), generation, symbols[i]))
+                    misses.push_back(i);
+            }
+        }
+        CacheHits.fetch_add(addresses.size() - misses.size(), std::memory_order_relaxed);
+        CacheMisses.fetch_add(misses.size(), std::memory_order_relaxed);
+
+        // Nothing is cached while symbols are unloaded; they may be loaded later
+        if (misses.empty() || !SymbolLoader::SymLoaded)
+            return symbols;
+
+        {
+            // Recursion repeats addresses within one trace; look each one up once
+            std::unordered_map<uintptr_t, SymbolPtr> resolved;
+            std::lock_guard lock(SymbolLoader::SymMutex);
+            for (const size_t i : misses) {
+                const auto address = reinterpret_cast<uintptr_t>(addresses[i]);
+                auto [it, inserted] = resolved.try_emplace(address);
+                if (inserted)
+                    it->second = LookupSymbol(address);
+                symbols[i] = it->second;
+            }
+        }
+
+        std::lock_guard lock(CacheMutex);
+        for (const size_t i : misses) {
+            InsertCached(reinterpret_cast<uintptr_t>(addresses[i]), symbols[i], generation);
+        }
+        return symbols;
+    }
+
+    void SymbolCache::SetCapacity(const size_t capacity) {
+        std::lock_guard lock(CacheMutex);
+        CacheCapacity = (std::max)(capacity, size_t{ 1 });
+        while (CacheOrder.size() > CacheCapacity) {
+            CacheIndex.erase(CacheOrder.back().Address);
+            CacheOrder.pop_back();
+        }
+    }
+
+    void SymbolCache::Clear() {
+        std::lock_guard lock(CacheMutex);
+        CacheIndex.clear();
+        CacheOrder.clear();
+    }
+
+    uint64_t SymbolCache::Hits() {
+        return CacheHits.load(std::memory_order_relaxed);
+    }
+
+    uint64_t SymbolCache::Misses() {
+        return CacheMisses.load(std::memory_order_relaxed);
+    }
+
+    // ---- Traceback ----
+    static void DumpFrame(const USHORT index, const uintptr_t address, const SymbolCache::Symbol* symbol) {
+        char msg[1024];
+        int len = _snprintf_s(msg, sizeof(msg), _TRUNCATE,
+            "[FrameInfo] %-2u) - " ADDR_FMT,
+            index, address);
+        if (len < 0) len = static_cast<int>(strlen(msg)); // handle truncation semantics
+
+        if (symbol) {
+            if (!symbol->Name.empty()) {
+                const int n = _snprintf_s(msg + len, sizeof(msg) - len, _TRUNCATE,
+                    "  %s+0x%llx",
+                    symbol->Name.c_str(),
+                    static_cast<unsigned long long>(symbol->Displacement));
+                if (n > 0) len += n;
+            }
+            if (!symbol->File.empty()) {
+                _snprintf_s(msg + len, sizeof(msg) - len, _TRUNCATE,
+                    "  [%s:%lu]",
+                    symbol->File.c_str(),
+                    static_cast<unsigned long>(symbol->Line));
+            }
+        }
+
+        Debug("%s", msg);
+    }
+
+    void Traceback::FrameInfo::Dump() const {
+        const auto symbol = SymbolCache::Resolve(CallAddress);
+        DumpFrame(StackIndex, CallAddress, symbol.get());
+    }
+
+    void Traceback::RawTrace::Dump() const {
+        const auto symbols = SymbolCache::ResolveAll(Frames());
+        for (USHORT i = 0; i < StackSize; ++i) {
+            DumpFrame(i, reinterpret_cast<uintptr_t>(Stack[i]), symbols[i].get());
+        }
+    }
+
+    // ---- TracePool ----
+    TracePool::TracePool(const size_t capacity) : _Capacity(capacity) {
+        _Traces.reserve(capacity);
+    }
+
+    bool TracePool::Push(const Traceback::RawTrace& trace) {
+        std::lock_guard lock(_Mutex);
+        if (_Traces.size() >= _Capacity) {
+            _Dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        _Traces.push_back(trace);
+        return true;
+    }
+
+    std::vector<Traceback::RawTrace> TracePool::Drain() {
+        // Allocated before taking the lock so Push() never waits on the heap
+        std::vector<Traceback::RawTrace> traces;
+        traces.reserve(_Capacity);
+        std::lock_guard lock(_Mutex);
+        _Traces.swap(traces);
+        return traces;
+    }
+
+    size_t TracePool::Size() const {
+        std::lock_guard lock(_Mutex);
+        return _Traces.size();
+    }
+
+    // ---- StackCounter ----
+    void StackCounter::Add(const Traceback::RawTrace& trace, const uint64_t count) {
+        std::lock_guard lock(_Mutex);
+        auto [it, inserted] = _Sites.try_emplace(trace.Hash);
+        if (inserted)
+            it->second.Trace = trace;
+        it->second.Count += count;
+        _Total += count;
+    }
+
+    std::vector<StackCounter::Site> StackCounter::Top(const size_t n) const {
+        std::lock_guard lock(_Mutex);
+        std::vector<const Site*> sites;
+        sites.reserve(_Sites.size());
+        for (const Site& site : _Sites | std::views::values) {
+            sites.push_back(&site);
+        }
+
+        const size_t count = (std::min)(n, sites.size());
+        std::ranges::partial_sort(sites, sites.begin() + static_cast<ptrdiff_t>(count), std::ranges::greater{}, &Site::Count);
+
+        std::vector<Site> top;
+        top.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            top.push_back(*sites[i]);
+        }
+        return top;
+    }
+
+    void StackCounter::DumpTop(const size_t n) const {
+        const auto top = Top(n);
+        const uint64_t total = Total();
+        for (size_t i = 0; i < top.size(); ++i) {
+            Debug("[StackCounter] #%zu: %llu of %llu traces (%.1f%%), hash %016llx", i + 1,
+                static_cast<unsigned long long>(top[i].Count), static_cast<unsigned long long>(total),
+                total ? 100.0 * static_cast<double>(top[i].Count) / static_cast<double>(total) : 0.0,
+                static_cast<unsigned long long>(top[i].Trace.Hash));
+            top[i].Trace.Dump();
+        }
+    }
+
+    size_t StackCounter::Distinct() const {
+        std::lock_guard lock(_Mutex);
+        return _Sites.size();
+    }
+
+    uint64_t StackCounter::Total() const {
+        std::lock_guard lock(_Mutex);
+        return _Total;
+    }
+
+    void StackCounter::Clear() {
+        std::lock_guard lock(_Mutex);
+        _Sites.clear();
+        _Total = 0;
+    }
+
     // ---- Inspection ----
     Inspection::ModuleInfo Inspection::GetModuleInfo(const std::wstring& moduleName)
     {
@@ -0,0 +1,481 @@
+// Copyright(C) 2025 0xKate - MIT License
+
+#include <SamplingProfiler.h>
+#include <MemoryManager.h>
+#include <ModuleRegistry.h>
+
+#include <tlhelp32.h>
+
+namespace ByteWeaver::DebugTools {
+
+    // What one distinct frame address is charged to
+    struct FrameLabel {
+        uintptr_t Function = 0;
+        std::string Name{};
+        std::string Module{};
+    };
+
+    struct SamplingProfiler::Report {
+        std::vector<StackCounter::Site> Sites{};
+        std::unordered_map<uintptr_t, FrameLabel> Labels{};   // by AttributionAddress()
+    };
+
+    // ---- helpers ----
+    static std::string ToUtf8(const std::wstring& text) {
+        if (text.empty())
+            return {};
+        const int length = WideCharToMultiByte(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), nullptr, 0, nullptr, nullptr);
+        std::string result(length, '\0');
+        WideCharToMultiByte(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), result.data(), length, nullptr, nullptr);
+        return result;
+    }
+
+    // Return addresses point past the call; step back into it so the frame lands in the caller
+    static uintptr_t AttributionAddress(const Traceback::RawTrace& trace, const USHORT index) {
+        const auto address = reinterpret_cast<uintptr_t>(trace.Stack[index]);
+        return index > 0 && address ? address - 1 : address;
+    }
+
+    static uintptr_t FunctionStart(const uintptr_t address, const SymbolCache::Symbol* symbol) {
+#ifdef _WIN64
+        if (const auto [start, end] = MemoryManager::GetFunctionBounds(address); start)
+            return start;
+#endif
+        if (symbol && !symbol->Name.empty())
+            return address - static_cast<uintptr_t>(symbol->Displacement);
+        return address;
+    }
+
+    // Top of a thread's stack, copied while it was suspended
+    struct StackCopy {
+        const uint8_t* Data = nullptr;
+        uintptr_t Low = 0;      // address Data[0] was copied from (the stack pointer)
+        size_t Size = 0;
+
+        // Returns true if [copied, copied + bytes) lies inside the copy
+        bool Contains(const uintptr_t copied, const size_t bytes) const {
+            const uintptr_t offset = copied - reinterpret_cast<uintptr_t>(Data);
+            return offset < Size && Size - offset >= bytes;
+        }
+
+        // Maps an address of the thread's stack into the copy; 0 if it was not copied
+        uintptr_t Map(const uintptr_t address, const size_t bytes = 1) const {
+            const uintptr_t copied = reinterpret_cast<uintptr_t>(Data) + (address - Low);
+            return Contains(copied, bytes) ? copied : 0;
+        }
+    };
+
+    // Copies up to capacity bytes from the stack pointer towards the stack base. Runs while the
+    // thread is suspended: one syscall and a guarded copy, no locks and no heap.
+    static size_t GuardedCopyStack(const uintptr_t stackPointer, uint8_t* buffer, const size_t capacity) {
+        MEMORY_BASIC_INFORMATION info;
+        if (!VirtualQuery(reinterpret_cast<LPCVOID>(stackPointer), &info, sizeof(info)) || info.State != MEM_COMMIT)
+            return 0;
+
+        // The committed part of a stack is one region ending at the stack base
+        const uintptr_t regionEnd = reinterpret_cast<uintptr_t>(info.BaseAddress) + info.RegionSize;
+        const size_t size = (std::min)(capacity, static_cast<size_t>(regionEnd - stackPointer));
+        __try {
+            memcpy(buffer, reinterpret_cast<const void*>(stackPointer), size);
+            return size;
+        }
+        __except (EXCEPTION_EXECUTE_HANDLER) {
+            return 0;
+        }
+    }
+
+    // Unwinds a thread from its captured context and stack copy into trace, after the thread was
+    // resumed. Kept free of destructible locals for __try.
+    static bool GuardedWalk(CONTEXT* context, const StackCopy* stack, Traceback::RawTrace* trace, const USHORT maxFrames) {
+        __try {
+#ifdef _WIN64
+            // Point the context at the copy; frames restored from it hold addresses of the real stack
+            context->Rsp = stack->Map(context->Rsp);
+            if (const uintptr_t frame = stack->Map(context->Rbp))
+                context->Rbp = frame;
+
+            while (trace->StackSize < maxFrames && context->Rip) {
+                trace->Stack[trace->StackSize++] = reinterpret_cast<void*>(context->Rip);
+                if (!stack->Contains(context->Rsp, sizeof(DWORD64)))
+                    break; // Past the end of the copy
+
+                DWORD64 imageBase = 0;
+                if (const PRUNTIME_FUNCTION function = RtlLookupFunctionEntry(context->Rip, &imageBase, nullptr)) {
+                    PVOID handlerData = nullptr;
+                    DWORD64 establisherFrame = 0;
+                    RtlVirtualUnwind(UNW_FLAG_NHANDLER, imageBase, context->Rip, function, context,
+                        &handlerData, &establisherFrame, nullptr);
+                }
+                else {
+                    // Leaf function without unwind data: the return address is on top of the stack
+                    context->Rip = *reinterpret_cast<const DWORD64*>(context->Rsp);
+                    context->Rsp += sizeof(DWORD64);
+                }
+                if (const uintptr_t frame = stack->Map(context->Rbp))
+                    context->Rbp = frame;
+            }
+#else
+            trace->Stack[trace->StackSize++] = reinterpret_cast<void*>(context->Eip);
+
+            // Frame-pointer chain: [ebp] is the caller's ebp, [ebp + 4] the return address
+            uintptr_t frame = context->Ebp;
+            while (trace->StackSize < maxFrames && frame && !(frame & 3)) {
+                const uintptr_t copied = stack->Map(frame, 2 * sizeof(uintptr_t));
+                if (!copied)
+                    break; // Outside the copy
+                const auto* slots = reinterpret_cast<const uintptr_t*>(copied);
+                const uintptr_t next = slots[0];
+                const uintptr_t returnAddress = slots[1];
+                if (!returnAddress)
+                    break;
+                trace->Stack[trace->StackSize++] = reinterpret_cast<void*>(returnAddress);
+                if (next <= frame)
+                    break; // Callers live higher up the stack; anything else is not a frame
+                frame = next;
+            }
+#endif
+            return trace->StackSize > 0;
+        }
+        __except (EXCEPTION_EXECUTE_HANDLER) {
+            // Keep the frames walked before the bad one
+            return trace->StackSize > 0;
+        }
+    }
+
+    // ---- lifetime ----
+    SamplingProfiler::SamplingProfiler() : SamplingProfiler(Options{}) {}
+
+    SamplingProfiler::SamplingProfiler(Options options) : _Options(std::move(options)) {
+        _Options.MaxFrames = (std::clamp)(_Options.MaxFrames, USHORT{ 1 }, USHORT{ 62 });
+        if (_Options.Interval.count() <= 0)
+            _Options.Interval = std::chrono::milliseconds{ 1 };
+        _Options.StackBytes = (std::max)(_Options.StackBytes, size_t{ 4096 });
+        _StackCopy = std::make_unique<uint8_t[]>(_Options.StackBytes);
+    }
+
+    SamplingProfiler::~SamplingProfiler() {
+        Stop();
+    }
+
+    bool SamplingProfiler::Start() {
+        if (_Running.exchange(true))
+            return true;
+
+        {
+            std::lock_guard lock(_StopMutex);
+            _StopRequested = false;
+        }
+
+        try {
+            _Thread = std::thread(&SamplingProfiler::Run, this);
+        }
+        catch (const std::system_error& e) {
+            Error("[SamplingProfiler] Failed to start the sampler thread: %s", e.what());
+            _Running.store(false);
+            return false;
+        }
+        Debug("[SamplingProfiler] Sampling every %lld ms", static_cast<long long>(_Options.Interval.count()));
+        return true;
+    }
+
+    void SamplingProfiler::Stop() {
+        if (!_Running.load())
+            return;
+
+        {
+            std::lock_guard lock(_StopMutex);
+            _StopRequested = true;
+        }
+        _StopSignal.notify_all();
+        if (_Thread.joinable())
+            _Thread.join();
+        _Running.store(false);
+    }
+
+    void SamplingProfiler::Reset() {
+        _Stacks.Clear();
+        _Passes.store(0);
+        _Samples.store(0);
+        _Failed.store(0);
+        _SuspendedNs.store(0);
+    }
+
+    SamplingProfiler::Stats SamplingProfiler::GetStats() const {
+        return { _Passes.load(), _Samples.load(), _Failed.load(), _SuspendedNs.load() };
+    }
+
+    // ---- sampler thread ----
+    void SamplingProfiler::Run() {
+        // Wake on time without competing with the threads being measured for long
+        SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_ABOVE_NORMAL);
+
+        auto nextRefresh = std::chrono::steady_clock::now();
+        std::unique_lock lock(_StopMutex);
+        while (!_StopRequested) {
+            lock.unlock();
+
+            if (const auto now = std::chrono::steady_clock::now(); now >= nextRefresh) {
+                RefreshThreads();
+                nextRefresh = now + _Options.ThreadRefresh;
+            }
+            SampleThreads();
+            _Passes.fetch_add(1, std::memory_order_relaxed);
+
+            lock.lock();
+            _StopSignal.wait_for(lock, _Options.Interval, [this] { return _StopRequested; });
+        }
+        lock.unlock();
+
+        CloseThreads();
+    }
+
+    void SamplingProfiler::RefreshThreads() {
+        std::erase_if(_Threads, [](const std::pair<DWORD, HANDLE>& entry) {
+            if (WaitForSingleObject(entry.second, 0) != WAIT_OBJECT_0)
+                return false;
+            CloseHandle(entry.second); // Exited
+            return true;
+        });
+
+        const HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+        if (snapshot == INVALID_HANDLE_VALUE) {
+            Warn("[SamplingProfiler] Thread snapshot failed (0x%08X)", GetLastError());
+            return;
+        }
+
+        const DWORD processId = GetCurrentProcessId();
+        const DWORD samplerId = GetCurrentThreadId();
+
+        THREADENTRY32 entry{};
+        entry.dwSize = sizeof(entry);
+        for (BOOL more = Thread32First(snapshot, &entry); more; more = Thread32Next(snapshot, &entry)) {
+            const DWORD threadId = entry.th32ThreadID;
+            if (entry.th32OwnerProcessID != processId || threadId == samplerId)
+                continue;
+            if (!_Options.ThreadIds.empty() && std::ranges::find(_Options.ThreadIds, threadId) == _Options.ThreadIds.end())
+                continue;
+            if (std::ranges::any_of(_Threads, [threadId](const auto& known) { return known.first == threadId; }))
+                continue;
+
+            if (const HANDLE thread = OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | SYNCHRONIZE, FALSE, threadId))
+                _Threads.emplace_back(threadId, thread);
+        }
+
+        CloseHandle(snapshot);
+    }
+
+    void SamplingProfiler::SampleThreads() {
+        static const double nsPerTick = [] {
+            LARGE_INTEGER frequency;
+            QueryPerformanceFrequency(&frequency);
+            return 1e9 / static_cast<double>(frequency.QuadPart);
+        }();
+
+        uint64_t samples = 0;
+        uint64_t failed = 0;
+        int64_t suspendedTicks = 0;
+        for (const auto& [threadId, thread] : _Threads) {
+            Traceback::RawTrace trace;
+            CONTEXT context{};
+            context.ContextFlags = CONTEXT_FULL;
+
+            LARGE_INTEGER begin, end;
+            QueryPerformanceCounter(&begin);
+            if (SuspendThread(thread) == static_cast<DWORD>(-1)) {
+                ++failed;
+                continue;
+            }
+            StackCopy stack{ _StackCopy.get() };
+            bool captured = GetThreadContext(thread, &context);
+            if (captured) {
+#ifdef _WIN64
+                stack.Low = context.Rsp;
+#else
+                stack.Low = context.Esp;
+#endif
+                stack.Size = GuardedCopyStack(stack.Low, _StackCopy.get(), _Options.StackBytes);
+            }
+            ResumeThread(thread);
+            QueryPerformanceCounter(&end);
+            suspendedTicks += end.QuadPart - begin.QuadPart;
+
+            // Unwound and counted only once the thread runs again: this takes locks and allocates
+            captured = captured && GuardedWalk(&context, &stack, &trace, _Options.MaxFrames);
+            if (!captured) {
+                ++failed;
+                continue;
+            }
+            trace.Hash = Traceback::HashStack(trace.Stack.data(), trace.StackSize);
+            _Stacks.Add(trace);
+            ++samples;
+        }
+
+        _Samples.fetch_add(samples, std::memory_order_relaxed);
+        _Failed.fetch_add(failed, std::memory_order_relaxed);
+        _SuspendedNs.fetch_add(static_cast<uint64_t>(static_cast<double>(suspendedTicks) * nsPerTick), std::memory_order_relaxed);
+    }
+
+    void SamplingProfiler::CloseThreads() {
+        for (const HANDLE thread : _Threads | std::views::values) {
+            CloseHandle(thread);
+        }
+        _Threads.clear();
+    }
+
+    // ---- reports ----
+    SamplingProfiler::Report SamplingProfiler::BuildReport() const {
+        Report report;
+        report.Sites = _Stacks.Top(SIZE_MAX);
+
+        std::vector<void*> addresses;
+        for (const StackCounter::Site& site : report.Sites) {
+            for (USHORT i = 0; i < site.Trace.StackSize; ++i) {
+                const uintptr_t address = AttributionAddress(site.Trace, i);
+                if (report.Labels.try_emplace(address).second)
+                    addresses.push_back(reinterpret_cast<void*>(address));
+            }
+        }
+
+        // One pass through the symbol cache for every distinct frame
+        const auto symbols = SymbolCache::ResolveAll(addresses);
+        for (size_t i = 0; i < addresses.size(); ++i) {
+            const auto address = reinterpret_cast<uintptr_t>(addresses[i]);
+            const SymbolCache::Symbol* symbol = symbols[i].get();
+            const auto module = ModuleRegistry::FindByAddress(address);
+
+            FrameLabel& label = report.Labels[address];
+            label.Function = FunctionStart(address, symbol);
+            label.Module = module ? ToUtf8(module->Name) : "?";
+
+            char name[640];
+            if (symbol && !symbol->Name.empty())
+                snprintf(name, sizeof(name), "%s!%s", label.Module.c_str(), symbol->Name.c_str());
+            else if (module)
+                snprintf(name, sizeof(name), "%s!+0x%llx", label.Module.c_str(),
+                    static_cast<unsigned long long>(label.Function - reinterpret_cast<uintptr_t>(module->Base)));
+            else
+                snprintf(name, sizeof(name), "?!" ADDR_FMT, label.Function);
+            label.Name = name;
+        }
+        return report;
+    }
+
+    std::vector<SamplingProfiler::FunctionStat> SamplingProfiler::TopFunctions(const size_t n) const {
+        const Report report = BuildReport();
+
+        std::unordered_map<uintptr_t, FunctionStat> functions;
+        std::vector<uintptr_t> counted; // functions already charged for this stack (recursion)
+        for (const StackCounter::Site& site : report.Sites) {
+            counted.clear();
+            for (USHORT i = 0; i < site.Trace.StackSize; ++i) {
+                const FrameLabel& label = report.Labels.at(AttributionAddress(site.Trace, i));
+                FunctionStat& stat = functions[label.Function];
+                if (stat.Name.empty()) {
+                    stat.Function = label.Function;
+                    stat.Name = label.Name;
+                }
+                if (i == 0)
+                    stat.Self += site.Count;
+                if (std::ranges::find(counted, label.Function) == counted.end()) {
+                    counted.push_back(label.Function);
+                    stat.Total += site.Count;
+                }
+            }
+        }
+
+        std::vector<FunctionStat> result;
+        result.reserve(functions.size());
+        for (FunctionStat& stat : functions | std::views::values) {
+            result.push_back(std::move(stat));
+        }
+        std::ranges::sort(result, [](const FunctionStat& a, const FunctionStat& b) {
+            return a.Self != b.Self ? a.Self > b.Self : a.Total > b.Total;
+        });
+        if (n && result.size() > n)
+            result.resize(n);
+        return result;
+    }
+
+    std::vector<SamplingProfiler::ModuleStat> SamplingProfiler::Modules() const {
+        const Report report = BuildReport();
+
+        std::unordered_map<std::string, ModuleStat> modules;
+        std::vector<const std::string*> counted;
+        for (const StackCounter::Site& site : report.Sites) {
+            counted.clear();
+            for (USHORT i = 0; i < site.Trace.StackSize; ++i) {
+                const std::string& name = report.Labels.at(AttributionAddress(site.Trace, i)).Module;
+                ModuleStat& stat = modules[name];
+                if (stat.Name.empty())
+                    stat.Name = name;
+                if (i == 0)
+                    stat.Self += site.Count;
+                if (std::ranges::none_of(counted, [&name](const std::string* seen) { return *seen == name; })) {
+                    counted.push_back(&name);
+                    stat.Total += site.Count;
+                }
+            }
+        }
+
+        std::vector<ModuleStat> result;
+        result.reserve(modules.size());
+        for (ModuleStat& stat : modules | std::views::values) {
+            result.push_back(std::move(stat));
+        }
+        std::ranges::sort(result, [](const ModuleStat& a, const ModuleStat& b) {
+            return a.Self != b.Self ? a.Self > b.Self : a.Total > b.Total;
+        });
+        return result;
+    }
+
+    std::string SamplingProfiler::Collapsed() const {
+        const Report report = BuildReport();
+
+        std::string collapsed;
+        for (const StackCounter::Site& site : report.Sites) {
+            if (!site.Trace.StackSize)
+                continue;
+            // Root first; ';' separates frames, so it may not appear inside one
+            for (USHORT i = site.Trace.StackSize; i-- > 0;) {
+                for (const char c : report.Labels.at(AttributionAddress(site.Trace, i)).Name) {
+                    collapsed += c == ';' ? ':' : c;
+                }
+                collapsed += i ? ';' : ' ';
+            }
+            collapsed += std::to_string(site.Count);
+            collapsed += '\n';
+        }
+        return collapsed;
+    }
+
+    bool SamplingProfiler::SaveCollapsed(const std::filesystem::path& path) const {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            Error("[SamplingProfiler] Failed to open %s", path.string().c_str());
+            return false;
+        }
+        const std::string collapsed = Collapsed();
+        file.write(collapsed.data(), static_cast<std::streamsize>(collapsed.size()));
+        return static_cast<bool>(file);
+    }
+
+    void SamplingProfiler::DumpTop(const size_t n) const {
+        const Stats stats = GetStats();
+        Debug("[SamplingProfiler] %llu samples in %llu passes (%llu failed), %.1f us suspended per sample",
+            static_cast<unsigned long long>(stats.Samples), static_cast<unsigned long long>(stats.Passes),
+            static_cast<unsigned long long>(stats.Failed),
+            stats.Samples ? static_cast<double>(stats.SuspendedNs) / 1000.0 / static_cast<double>(stats.Samples) : 0.0);
+
+        const uint64_t total = _Stacks.Total();
+        if (!total)
+            return;
+        const auto percent = [total](const uint64_t count) { return 100.0 * static_cast<double>(count) / static_cast<double>(total); };
+
+        for (const FunctionStat& function : TopFunctions(n)) {
+            Debug("[SamplingProfiler] %6.2f%% self %6.2f%% total  %s", percent(function.Self), percent(function.Total), function.Name.c_str());
+        }
+        for (const ModuleStat& module : Modules()) {
+            Debug("[SamplingProfiler] %6.2f%% self %6.2f%% total  [%s]", percent(module.Self), percent(module.Total), module.Name.c_str());
+        }
+    }
+}
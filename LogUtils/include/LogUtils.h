@@ -21,6 +21,7 @@
 #include <unordered_map>
 #include <utility> 
 #include <array>
+#include <atomic>
 
 #if defined(HAVE_BYTEWEAVER)
     #include <ByteWeaver.h>   // ← add this block
@@ -13,6 +13,13 @@ namespace LogUtils
     using LogFunction = void(*)(LogLevel, const std::string&);
 #endif
 
+    // What an async log call does when the ring buffer is full
+    enum class LogOverflowPolicy : int {
+        Drop,       // discard the message
+        Block,      // wait for the writer thread to make room
+        CountDrops  // discard it and report how many were lost once there is room again
+    };
+
     class Logger {
     public:
         static void Initialize(const std::filesystem::path& logPath, LogLevel level);
@@ -24,6 +31,14 @@ namespace LogUtils
         static void Log(const std::string& message);
         static void Log(LogLevel level, const std::string& message);
 
+        // Async mode: callers format and enqueue into a lock-free MPSC ring; a writer thread
+        // batches the file, console and pipe writes. Capacity is rounded up to a power of two.
+        static void EnableAsync(size_t capacity = 4096, LogOverflowPolicy policy = LogOverflowPolicy::CountDrops);
+        static void DisableAsync();
+        static bool IsAsync();
+        static void Flush();
+        static void FlushOnCrash();
+        static uint64_t DroppedCount();
 
     private:
         static LogLevel _LogLevel;
@@ -31,5 +46,11 @@ namespace LogUtils
         static std::mutex _Mutex;
         static std::string FormatArgs(const char* format, va_list args);
         static std::string FormatLogMessage(LogLevel level, const std::string& message);
+        static std::string DecorateMessage(LogLevel level, const std::string& message);
+        static void LogArgs(LogLevel level, const char* format, va_list args);
+        static bool TryEnqueue(LogLevel level, bool raw, const std::string& msg);
+        static bool Enqueue(LogLevel level, bool raw, const std::string& msg);
+        static size_t DrainAsync(size_t maxRecords);
+        static void AsyncWorker();
     };
 }
\ No newline at end of file
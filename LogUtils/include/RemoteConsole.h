@@ -2,18 +2,40 @@
 
 namespace LogUtils
 {
+    // Writes never block: messages are appended to a bounded backlog and sent as coalesced
+    // overlapped frames, completed on the thread pool. When the backlog is full they are dropped.
     class RemoteConsole
     {
         static std::atomic_bool _AutoReconnect;
         static std::atomic_bool _Enabled;
         static HANDLE _Pipe;
         static const char* _PipeName;
+
+        static std::mutex _Mutex;
+        static PTP_IO _Io;
+        static OVERLAPPED _Overlapped;
+        static std::string _Backlog;
+        static std::string _InFlight;
+        static bool _Writing;
+        static uint64_t _Dropped;
+        static uint64_t _DropsReported;
+
+        static std::string StartWriteLocked();
+        static void CloseLocked();
+        static void ReleaseIo();
+        static void CALLBACK OnWriteComplete(PTP_CALLBACK_INSTANCE instance, PVOID context, PVOID overlapped,
+                                             ULONG result, ULONG_PTR bytesTransferred, PTP_IO io);
     public:
+        static constexpr size_t MaxBacklog = 1024 * 1024;   // bytes queued before messages are dropped
+        static constexpr size_t MaxFrame = 64 * 1024;       // bytes per WriteFile
+
         static bool Connect();
         static bool Reconnect();
         static bool IsConnected();
         static void Disconnect();
         static void Write(const std::string& msg);
+        static bool Flush(DWORD timeoutMs = 1000);
+        static uint64_t DroppedCount();
         static void SetAutoReconnect(bool enabled = true);
         static void SetEnabled(bool enabled = true);
         static bool IsEnabled();
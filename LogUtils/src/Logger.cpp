@@ -4,6 +4,8 @@
 #include "Logger.h"
 #include "RemoteConsole.h"
 
+#include <new>
+
 //#define LOGGER_ENABLE_TIMESTAMP
 //#define LOGGER_ENABLE_THREAD_DEBUG
 
@@ -14,6 +16,49 @@ namespace LogUtils
     std::ofstream Logger::_FileStream;
     std::mutex Logger::_Mutex;
 
+    // ---- async ring ----
+    // Bounded MPSC queue (Vyukov): a cell is free for position p when Sequence == p and holds a
+    // record for p when Sequence == p + 1. Short records live inline, long ones on the heap.
+    struct alignas(64) LogRecord {
+        std::atomic<size_t> Sequence{ 0 };
+        LogLevel Level = LogLevel::LOG_INFO;
+        bool Raw = false;
+        uint32_t Length = 0;
+        char* Heap = nullptr;
+        char Inline[224]{};
+    };
+
+    struct AsyncLogState {
+        std::unique_ptr<LogRecord[]> Ring;
+        size_t Mask = 0;
+        LogOverflowPolicy Policy = LogOverflowPolicy::CountDrops;
+
+        alignas(64) std::atomic<size_t> EnqueuePos{ 0 };
+        alignas(64) std::atomic<size_t> DequeuePos{ 0 };
+        std::atomic<uint64_t> Published{ 0 };
+        std::atomic<bool> WorkerSleeping{ false };
+        std::atomic_flag ConsumerBusy;
+
+        // Calls between their async check and the end of their enqueue; DisableAsync waits for zero
+        std::atomic<uint32_t> Producers{ 0 };
+
+        std::atomic<uint64_t> Dropped{ 0 };
+        uint64_t DropsReported = 0;
+
+        std::atomic<bool> Stopping{ false };
+        std::thread Worker;
+        LPTOP_LEVEL_EXCEPTION_FILTER PreviousFilter = nullptr;
+    };
+
+    // Never destroyed: a static destructor would join the writer under the loader lock
+    static AsyncLogState& AsyncState() {
+        static auto* state = new AsyncLogState();
+        return *state;
+    }
+
+    static std::atomic<bool> AsyncEnabled{ false };
+    static thread_local bool IsLogWorker = false;
+
     void Logger::Initialize(const std::filesystem::path& logPath, const LogLevel level) {
         std::lock_guard lock(_Mutex);
         LogLocation = logPath;
@@ -30,39 +75,39 @@ namespace LogUtils
     }
 
     void Logger::Debug(const char* format, ...) {
-        std::lock_guard lock(_Mutex);
         va_list args;
         va_start(args, format);
-        const std::string message = FormatArgs(format, args);
+        LogArgs(LogLevel::LOG_DEBUG, format, args);
         va_end(args);
-        Log(LogLevel::LOG_DEBUG, message);
     }
 
     void Logger::Info(const char* format, ...) {
-        std::lock_guard lock(_Mutex);
         va_list args;
         va_start(args, format);
-        const std::string message = FormatArgs(format, args);
+        LogArgs(LogLevel::LOG_INFO, format, args);
         va_end(args);
-        Log(LogLevel::LOG_INFO, message);
     }
 
     void Logger::Warn(const char* format, ...) {
-        std::lock_guard lock(_Mutex);
         va_list args;
         va_start(args, format);
-        const std::string message = FormatArgs(format, args);
+        LogArgs(LogLevel::LOG_WARN, format, args);
         va_end(args);
-        Log(LogLevel::LOG_WARN, message);
     }
 
     void Logger::Error(const char* format, ...) {
-        std::lock_guard lock(_Mutex);
         va_list args;
         va_start(args, format);
-        const std::string message = FormatArgs(format, args);
+        LogArgs(LogLevel::LOG_ERROR, format, args);
         va_end(args);
-        Log(LogLevel::LOG_ERROR, message);
+    }
+
+    void Logger::LogArgs(const LogLevel level, const char* format, const va_list args) {
+        // The file takes every level; without one a filtered message has nowhere to go
+        if (level < _LogLevel && !_FileStream.is_open())
+            return;
+
+        Log(level, FormatArgs(format, args));
     }
 
     std::string Logger::FormatArgs(const char* format, const va_list args) {
@@ -73,6 +118,9 @@ namespace LogUtils
 
     void Logger::Log(const std::string& message)
     {
+        if (TryEnqueue(LogLevel::LOG_INFO, true, message))
+            return;
+
         std::lock_guard lock(_Mutex);
 
         if (RemoteConsole::IsEnabled())
@@ -85,6 +133,35 @@ namespace LogUtils
     }
 
     void Logger::Log(const LogLevel level, const std::string& message) {
+        const std::string msg = DecorateMessage(level, message);
+        if (TryEnqueue(level, false, msg))
+            return;
+
+        std::lock_guard lock(_Mutex);
+        if (_FileStream.is_open()) {
+            _FileStream << msg << std::endl;
+        }
+
+        if (RemoteConsole::IsEnabled())
+        {
+            if (_LogLevel <= level) {
+                RemoteConsole::Write(msg + "\n");
+            }
+        }
+        else
+        {
+            if (_LogLevel <= level) {
+                if (level > LogLevel::LOG_INFO) {
+                        std::cerr << msg << std::endl;
+                }
+                else {
+                        std::cout << msg << std::endl;
+                }
+            }
+        }
+    }
+
+    std::string Logger::DecorateMessage(const LogLevel level, const std::string& message) {
         auto msg = FormatLogMessage(level, message);
 
     #ifdef LOGGER_ENABLE_THREAD_DEBUG
@@ -123,37 +200,290 @@ namespace LogUtils
         msg.insert(0, timestampStr);
     #endif
 
-        if (_FileStream.is_open()) {
-            _FileStream << msg << std::endl;
+        return msg;
+    }
+
+    std::string Logger::FormatLogMessage(const LogLevel level, const std::string& message) {
+        std::string levelStr;
+        switch (level) {
+        case LogLevel::LOG_DEBUG: levelStr = "DEBUG"; break;
+        case LogLevel::LOG_INFO:  levelStr = "INFO"; break;
+        case LogLevel::LOG_WARN:  levelStr = "WARN"; break;
+        case LogLevel::LOG_ERROR: levelStr = "ERROR"; break;
         }
+        return "[" + levelStr + "]" + message;
+    }
 
-        if (RemoteConsole::IsEnabled())
+    // ---- async mode ----
+    static LONG WINAPI FlushOnCrashFilter(EXCEPTION_POINTERS* info) {
+        Logger::FlushOnCrash();
+        const auto previous = AsyncState().PreviousFilter;
+        return previous ? previous(info) : EXCEPTION_CONTINUE_SEARCH;
+    }
+
+    void Logger::EnableAsync(const size_t capacity, const LogOverflowPolicy policy) {
+        std::lock_guard lock(_Mutex);
+        if (AsyncEnabled)
+            return;
+
+        AsyncLogState& state = AsyncState();
+        size_t size = 64;
+        while (size < capacity)
+            size *= 2;
+
+        // No producer is inside the ring while async mode is off (see DisableAsync), so it can be replaced
+        state.Ring = std::make_unique<LogRecord[]>(size);
+        for (size_t i = 0; i < size; ++i) {
+            state.Ring[i].Sequence.store(i, std::memory_order_relaxed);
+        }
+        state.Mask = size - 1;
+        state.Policy = policy;
+        state.EnqueuePos = 0;
+        state.DequeuePos = 0;
+        state.Stopping = false;
+        state.Worker = std::thread(AsyncWorker);
+        state.PreviousFilter = SetUnhandledExceptionFilter(FlushOnCrashFilter);
+        AsyncEnabled = true;
+    }
+
+    void Logger::DisableAsync() {
+        AsyncLogState& state = AsyncState();
         {
-            if (_LogLevel <= level) {
-                RemoteConsole::Write(msg + "\n");
-            }
+            std::lock_guard lock(_Mutex);
+            if (!AsyncEnabled)
+                return;
+            AsyncEnabled = false; // new calls go synchronous; the writer drains what is queued
         }
-        else
+
+        // Calls that saw async mode just before it was switched off finish their enqueue first
+        while (state.Producers.load() != 0)
+            std::this_thread::yield();
+
+        state.Stopping = true;
+        state.Published.fetch_add(1);
+        state.Published.notify_one();
+        state.Worker.join();
+
+        while (state.ConsumerBusy.test_and_set(std::memory_order_acquire))
+            std::this_thread::yield();
         {
-            if (_LogLevel <= level) {
-                if (level > LogLevel::LOG_INFO) {
-                        std::cerr << msg << std::endl;
+            std::lock_guard lock(_Mutex);
+            while (DrainAsync(SIZE_MAX) != 0) {}
+        }
+        state.ConsumerBusy.clear(std::memory_order_release);
+
+        // Put the previous filter back unless someone replaced ours in the meantime
+        if (const auto current = SetUnhandledExceptionFilter(state.PreviousFilter); current != FlushOnCrashFilter)
+            SetUnhandledExceptionFilter(current);
+        state.PreviousFilter = nullptr;
+    }
+
+    bool Logger::IsAsync() {
+        return AsyncEnabled.load(std::memory_order_acquire);
+    }
+
+    uint64_t Logger::DroppedCount() {
+        return AsyncState().Dropped.load(std::memory_order_relaxed);
+    }
+
+    bool Logger::TryEnqueue(const LogLevel level, const bool raw, const std::string& msg) {
+        AsyncLogState& state = AsyncState();
+
+        // Counted before the check, so DisableAsync either sees this call or this call sees sync mode
+        state.Producers.fetch_add(1);
+        const bool async = AsyncEnabled.load();
+        if (async)
+            Enqueue(level, raw, msg);
+        state.Producers.fetch_sub(1, std::memory_order_release);
+        return async;
+    }
+
+    bool Logger::Enqueue(const LogLevel level, const bool raw, const std::string& msg) {
+        AsyncLogState& state = AsyncState();
+
+        // Copied before a cell is claimed: a claimed cell must be published, or the consumer stalls on it.
+        // nothrow, so a failed allocation is a drop rather than an exception past TryEnqueue's count
+        std::unique_ptr<char[]> heap;
+        if (msg.size() > sizeof(LogRecord::Inline)) {
+            heap.reset(new (std::nothrow) char[msg.size()]);
+            if (!heap) {
+                state.Dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            memcpy(heap.get(), msg.data(), msg.size());
+        }
+
+        size_t pos = state.EnqueuePos.load(std::memory_order_relaxed);
+        LogRecord* record;
+        for (;;) {
+            record = &state.Ring[pos & state.Mask];
+            const size_t sequence = record->Sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (state.EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0) {
+                // Full. The writer must never wait on itself
+                if (state.Policy != LogOverflowPolicy::Block || IsLogWorker) {
+                    state.Dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
                 }
-                else {
-                        std::cout << msg << std::endl;
+                state.Published.notify_one();
+                std::this_thread::yield();
+                pos = state.EnqueuePos.load(std::memory_order_relaxed);
+            }
+            else {
+                pos = state.EnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        record->Level = level;
+        record->Raw = raw;
+        record->Length = static_cast<uint32_t>(msg.size());
+        record->Heap = heap.release();
+        if (!record->Heap)
+            memcpy(record->Inline, msg.data(), msg.size());
+        record->Sequence.store(pos + 1, std::memory_order_release);
+
+        state.Published.fetch_add(1);
+        if (state.WorkerSleeping.load())
+            state.Published.notify_one();
+        return true;
+    }
+
+    // Single consumer: callers hold ConsumerBusy. Writes one chunk per sink for the whole batch.
+    size_t Logger::DrainAsync(const size_t maxRecords) {
+        AsyncLogState& state = AsyncState();
+        const bool remote = RemoteConsole::IsEnabled();
+
+        std::string file, out, err, pipe;
+        size_t drained = 0;
+        size_t pos = state.DequeuePos.load(std::memory_order_relaxed);
+        for (; drained < maxRecords; ++drained, ++pos) {
+            LogRecord& record = state.Ring[pos & state.Mask];
+            if (record.Sequence.load(std::memory_order_acquire) != pos + 1)
+                break;
+
+            const std::string_view text(record.Heap ? record.Heap : record.Inline, record.Length);
+            if (record.Raw) {
+                if (remote)
+                    pipe.append(text).push_back('\n');
+                file.append(text).push_back('\n');
+                out.append(text).push_back('\n');
+            }
+            else {
+                file.append(text).push_back('\n');
+                if (_LogLevel <= record.Level) {
+                    std::string& console = remote ? pipe : record.Level > LogLevel::LOG_INFO ? err : out;
+                    console.append(text).push_back('\n');
                 }
             }
+
+            delete[] record.Heap;
+            record.Heap = nullptr;
+            record.Sequence.store(pos + state.Mask + 1, std::memory_order_release);
+        }
+
+        const uint64_t dropped = state.Dropped.load(std::memory_order_relaxed);
+        if (state.Policy == LogOverflowPolicy::CountDrops && dropped != state.DropsReported) {
+            const std::string notice = DecorateMessage(LogLevel::LOG_WARN,
+                "[Logger] " + std::to_string(dropped - state.DropsReported) + " messages dropped (log queue full)");
+            state.DropsReported = dropped;
+            file.append(notice).push_back('\n');
+            if (_LogLevel <= LogLevel::LOG_WARN)
+                (remote ? pipe : err).append(notice).push_back('\n');
+        }
+
+        if (file.empty() && out.empty() && err.empty() && pipe.empty()) {
+            state.DequeuePos.store(pos, std::memory_order_release);
+            return drained;
+        }
+
+        if (_FileStream.is_open()) {
+            _FileStream.write(file.data(), static_cast<std::streamsize>(file.size()));
+            _FileStream.flush();
         }
+        if (!out.empty())
+            std::cout.write(out.data(), static_cast<std::streamsize>(out.size())).flush();
+        if (!err.empty())
+            std::cerr.write(err.data(), static_cast<std::streamsize>(err.size())).flush();
+        if (!pipe.empty())
+            RemoteConsole::Write(pipe);
+
+        // Published last, so Flush() only returns once the batch is written
+        state.DequeuePos.store(pos, std::memory_order_release);
+        return drained;
     }
 
-    std::string Logger::FormatLogMessage(const LogLevel level, const std::string& message) {
-        std::string levelStr;
-        switch (level) {
-        case LogLevel::LOG_DEBUG: levelStr = "DEBUG"; break;
-        case LogLevel::LOG_INFO:  levelStr = "INFO"; break;
-        case LogLevel::LOG_WARN:  levelStr = "WARN"; break;
-        case LogLevel::LOG_ERROR: levelStr = "ERROR"; break;
+    void Logger::AsyncWorker() {
+        AsyncLogState& state = AsyncState();
+        IsLogWorker = true;
+
+        for (;;) {
+            const uint64_t published = state.Published.load();
+
+            size_t drained;
+            while (state.ConsumerBusy.test_and_set(std::memory_order_acquire))
+                std::this_thread::yield();
+            {
+                std::lock_guard lock(_Mutex);
+                drained = DrainAsync(256);
+            }
+            state.ConsumerBusy.clear(std::memory_order_release);
+
+            if (drained != 0)
+                continue;
+            if (state.Stopping)
+                return;
+
+            // Producers only wake us when this is set, so re-check after publishing it
+            state.WorkerSleeping.store(true);
+            if (state.Published.load() == published)
+                state.Published.wait(published);
+            state.WorkerSleeping.store(false);
         }
-        return "[" + levelStr + "]" + message;
+    }
+
+    void Logger::Flush() {
+        if (!IsAsync()) {
+            std::lock_guard lock(_Mutex);
+            if (_FileStream.is_open())
+                _FileStream.flush();
+            return;
+        }
+
+        AsyncLogState& state = AsyncState();
+        const size_t target = state.EnqueuePos.load();
+        state.Published.fetch_add(1);
+        state.Published.notify_one();
+        while (!IsLogWorker && IsAsync() && state.DequeuePos.load(std::memory_order_acquire) < target)
+            std::this_thread::yield();
+    }
+
+    void Logger::FlushOnCrash() {
+        if (!IsAsync())
+            return;
+
+        // The writer may be mid-batch; give it a moment. If it never lets go (frozen along with the
+        // crash), leave the ring alone: draining beside it would hand the same records out twice
+        AsyncLogState& state = AsyncState();
+        bool consumer = false;
+        for (int i = 0; i < 200 && !(consumer = !state.ConsumerBusy.test_and_set(std::memory_order_acquire)); ++i)
+            Sleep(1);
+        if (!consumer)
+            return;
+
+        bool locked = false;
+        for (int i = 0; i < 200 && !(locked = _Mutex.try_lock()); ++i)
+            Sleep(1);
+
+        while (DrainAsync(SIZE_MAX) != 0) {}
+        if (_FileStream.is_open())
+            _FileStream.flush();
+
+        if (locked)
+            _Mutex.unlock();
+        state.ConsumerBusy.clear(std::memory_order_release);
     }
 }
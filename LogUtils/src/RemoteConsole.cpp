@@ -12,15 +12,27 @@ namespace LogUtils
     HANDLE RemoteConsole::_Pipe = nullptr;
     const char* RemoteConsole::_PipeName = R"(\\.\pipe\ConsoleLoggerPipe)";
 
+    std::mutex RemoteConsole::_Mutex;
+    PTP_IO RemoteConsole::_Io = nullptr;
+    OVERLAPPED RemoteConsole::_Overlapped{};
+    std::string RemoteConsole::_Backlog;
+    std::string RemoteConsole::_InFlight;
+    bool RemoteConsole::_Writing = false;
+    uint64_t RemoteConsole::_Dropped = 0;
+    uint64_t RemoteConsole::_DropsReported = 0;
+
     bool RemoteConsole::Connect()
     {
+        // Drop what is left of a connection the completion callback found broken
+        ReleaseIo();
+
         const HANDLE pipe = CreateFileA(
             _PipeName,              // Name of the named pipe
             GENERIC_READ | GENERIC_WRITE,  // Access: you want to read and write
             0,                      // No sharing
             nullptr,                // Default security
             OPEN_EXISTING,          // Open the existing pipe don't create it
-            0,                      // Default attributes (can be FILE_FLAG_OVERLAPPED if async)
+            FILE_FLAG_OVERLAPPED,   // Writes complete on the thread pool, never on the caller
             nullptr);               // No template file
 
 
@@ -29,7 +41,18 @@ namespace LogUtils
             return false;
         }
 
-        _Pipe = pipe;
+        const PTP_IO io = CreateThreadpoolIo(pipe, OnWriteComplete, nullptr, nullptr);
+        if (!io) {
+            CloseHandle(pipe);
+            Logger::Error("[RCON] Unable to bind pipe to the thread pool: %lu", GetLastError());
+            return false;
+        }
+
+        {
+            std::lock_guard lock(_Mutex);
+            _Pipe = pipe;
+            _Io = io;
+        }
         _Enabled = true;
 
         return true;
@@ -49,34 +72,114 @@ namespace LogUtils
 
     bool RemoteConsole::IsConnected()
     {
-        if (!_Pipe)
-            return false;
+        // A broken pipe is noticed by the write completion, no need to poll it
+        std::lock_guard lock(_Mutex);
+        return _Pipe != nullptr;
+    }
 
-        DWORD bytesAvailable = 0;
-        if (const bool result = PeekNamedPipe(_Pipe, nullptr, 0, nullptr, &bytesAvailable, nullptr); result == FALSE)
+    // Caller holds _Mutex. The io object is closed by Disconnect(), outside of it.
+    void RemoteConsole::CloseLocked()
+    {
+        if (_Pipe)
         {
+            CancelIoEx(_Pipe, nullptr);
             CloseHandle(_Pipe);
             _Pipe = nullptr;
-            _Enabled = FALSE;
-            _AutoReconnect = FALSE;
-            Logger::Error("[RCON] Pipe connection broken, disconnecting!");
-            return false;
         }
-
-        return true;
+        _Backlog.clear();
+        _Enabled = false;
     }
 
-    void RemoteConsole::Disconnect()
+    // Not from a completion callback: it waits for them
+    void RemoteConsole::ReleaseIo()
     {
-        if (_Pipe)
+        PTP_IO io;
         {
-            CloseHandle(_Pipe);
-            _Pipe = nullptr;
+            std::lock_guard lock(_Mutex);
+            CloseLocked();
+            io = _Io;
+            _Io = nullptr;
         }
+        if (io)
+        {
+            // The cancelled write still completes; its callback takes _Mutex
+            WaitForThreadpoolIoCallbacks(io, FALSE);
+            CloseThreadpoolIo(io);
+        }
+        std::lock_guard lock(_Mutex);
+        _Writing = false;
+        _InFlight.clear();
+    }
+
+    void RemoteConsole::Disconnect()
+    {
+        ReleaseIo();
         _Enabled = false;
         _AutoReconnect = false;
     }
 
+    // Caller holds _Mutex. Returns an error to log once the lock is released.
+    std::string RemoteConsole::StartWriteLocked()
+    {
+        if (_Writing || _Backlog.empty() || !_Pipe)
+            return {};
+
+        if (_Dropped != _DropsReported)
+        {
+            _Backlog.insert(0, "[RCON] " + std::to_string(_Dropped - _DropsReported) + " messages dropped (console not keeping up)\n");
+            _DropsReported = _Dropped;
+        }
+
+        // Coalesce everything queued into one frame
+        if (_Backlog.size() <= MaxFrame)
+        {
+            _InFlight.swap(_Backlog);
+            _Backlog.clear();
+        }
+        else
+        {
+            _InFlight.assign(_Backlog, 0, MaxFrame);
+            _Backlog.erase(0, MaxFrame);
+        }
+
+        _Overlapped = {};
+        StartThreadpoolIo(_Io);
+        if (!WriteFile(_Pipe, _InFlight.data(), static_cast<DWORD>(_InFlight.size()), nullptr, &_Overlapped)
+            && GetLastError() != ERROR_IO_PENDING)
+        {
+            const DWORD err = GetLastError();
+            CancelThreadpoolIo(_Io);
+            CloseLocked();
+            return "[RCON] Failed to write to named pipe: " + std::to_string(err);
+        }
+
+        _Writing = true;
+        return {};
+    }
+
+    void CALLBACK RemoteConsole::OnWriteComplete(PTP_CALLBACK_INSTANCE, PVOID, PVOID, const ULONG result, ULONG_PTR, PTP_IO)
+    {
+        std::string error;
+        {
+            std::lock_guard lock(_Mutex);
+            _Writing = false;
+            _InFlight.clear();
+            if (result != NO_ERROR)
+            {
+                if (_Pipe)
+                    error = "[RCON] Pipe connection broken, disconnecting! (" + std::to_string(result) + ")";
+                CloseLocked();
+            }
+            else
+            {
+                error = StartWriteLocked();
+            }
+        }
+
+        if (!error.empty())
+            Logger::Error("%s", error.c_str());
+    }
+
     void RemoteConsole::Write(const std::string& msg)
     {
         if (!_Enabled) {
@@ -84,26 +187,52 @@ namespace LogUtils
             return;
         }
 
-        if (!_Pipe || _Pipe == INVALID_HANDLE_VALUE) {
-            _Enabled = false;
-            _AutoReconnect = false;
-            Logger::Error("[RCON] Cannot write to invalid pipe! Disconnecting!");
-            return;
+        std::string error;
+        {
+            std::lock_guard lock(_Mutex);
+            if (!_Pipe || _Pipe == INVALID_HANDLE_VALUE) {
+                _Enabled = false;
+                _AutoReconnect = false;
+                error = "[RCON] Cannot write to invalid pipe! Disconnecting!";
+            }
+            else if (_Backlog.size() + msg.size() > MaxBacklog) {
+                ++_Dropped;
+            }
+            else {
+                _Backlog += msg;
+                error = StartWriteLocked();
+            }
         }
 
-        DWORD written;
+        // Logged without the lock: the logger may write back into the console
+        if (!error.empty())
+            Logger::Error("%s", error.c_str());
+    }
 
-        if (const BOOL success = WriteFile(_Pipe, msg.c_str(), msg.size(), &written, nullptr); !success || written != msg.size())
+    bool RemoteConsole::Flush(const DWORD timeoutMs)
+    {
+        const ULONGLONG deadline = GetTickCount64() + timeoutMs;
+        for (;;)
         {
-            _Enabled = false;
-            const DWORD err = GetLastError();
-            Logger::Error("[RCON] Failed to write to named pipe: %d", err);
-
-            CloseHandle(_Pipe);
-            _Pipe = nullptr;
+            {
+                std::lock_guard lock(_Mutex);
+                if (!_Pipe)
+                    return false;
+                if (!_Writing && _Backlog.empty())
+                    return true;
+            }
+            if (GetTickCount64() >= deadline)
+                return false;
+            Sleep(1);
         }
     }
 
+    uint64_t RemoteConsole::DroppedCount()
+    {
+        std::lock_guard lock(_Mutex);
+        return _Dropped;
+    }
+
     void RemoteConsole::SetAutoReconnect(const bool enabled)
     {
         _AutoReconnect = enabled;